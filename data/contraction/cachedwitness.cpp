@@ -6,6 +6,9 @@
  */
 
 #include "cachedwitness.h"
+#include "../../data_io/checkpoint_io.h"
+
+#include <numeric> // Command accumulate
 
 /*
  * Constructor
@@ -83,3 +86,60 @@ std::ostream& operator<<(std::ostream& os, WitnessCache& cache){
 	}
 	return os;
 }
+
+/*
+ * memoryFootprint() method: return the memory held by the witness cache: cached entries (allocated capacity) and per-node entry vectors
+ */
+MemoryFootprint WitnessCache::memoryFootprint() const {
+	MemoryFootprint footprint("WitnessCache");
+	size_t entryBytes(0);
+	for(const auto& entries: _data){
+		entryBytes += MemoryFootprint::bytes(entries);
+	}
+	footprint.add("entries", entryBytes);
+	footprint.add("node vectors", MemoryFootprint::bytes(_data));
+	return footprint;
+}
+
+/*
+ * writeCheckpoint(CheckpointIO&) method: add all the cache entries to the given snapshot (number of entries of each node, then status,
+ * complexity, origin, middle node and destination of each entry)
+ */
+void WitnessCache::writeCheckpoint(CheckpointIO& checkpoint) const {
+	std::vector<uint32_t> nbEntries, entries;
+	nbEntries.reserve( _data.size() );
+	for(const auto& nodeEntries: _data){
+		nbEntries.push_back( nodeEntries.size() );
+		for(WitnessCacheEntry entry: nodeEntries){
+			entries.push_back( entry.getStatus() );
+			entries.push_back( entry.getComplexity() );
+			entries.push_back( entry.getOrigin() );
+			entries.push_back( entry.getMiddleNode() );
+			entries.push_back( entry.getDestination() );
+		}
+	}
+	checkpoint.put( nbEntries );
+	checkpoint.put( entries );
+}
+
+/*
+ * readCheckpoint(CheckpointIO&) method: replace the cache entries by the ones of the given snapshot
+ */
+bool WitnessCache::readCheckpoint(CheckpointIO& checkpoint){
+	std::vector<uint32_t> nbEntries, entries;
+	if( !checkpoint.get(nbEntries) || !checkpoint.get(entries) || nbEntries.size() != _data.size()
+			|| std::accumulate( nbEntries.begin() , nbEntries.end() , size_t(0) ) * 5 != entries.size() ){
+		ERROR("Checkpoint does not hold a witness cache of this instance.\n");
+		return false;
+	}
+	std::vector<std::vector<WitnessCacheEntry>> data( _data.size() );
+	const uint32_t* entry( entries.data() );
+	for(size_t x(0) ; x < data.size() ; ++x){
+		data[x].reserve( nbEntries[x] );
+		for(uint32_t i(0) ; i < nbEntries[x] ; ++i, entry += 5){
+			data[x].push_back( WitnessCacheEntry( entry[0] , entry[1] , Node_id(entry[2]) , Node_id(entry[3]) , Node_id(entry[4]) ) );
+		}
+	}
+	_data.swap( data );
+	return true;
+}
@@ -10,8 +10,12 @@
 
 #include <vector>
 
+#include "../graph/memoryfootprint.h"
+
 #include "../witnesssearch/witnesscacheentry.h"
 
+class CheckpointIO;
+
 /*
  * Class WitnessCache: structure gathering all the cached witnesses (one vector of entries per nodes)
  */
@@ -61,6 +65,21 @@ public:
 
 	static const WitnessCacheEntry INVALID_ENTRY;
 
+	/*
+	 * memoryFootprint() method: return the memory held by the witness cache: cached entries and per-node entry vectors
+	 */
+	MemoryFootprint memoryFootprint() const;
+
+	/*
+	 * writeCheckpoint(CheckpointIO&) method: add all the cache entries to the given snapshot
+	 */
+	void writeCheckpoint(CheckpointIO& checkpoint) const;
+
+	/*
+	 * readCheckpoint(CheckpointIO&) method: replace the cache entries by the ones of the given snapshot, return false (the cache being unchanged) if they are not valid
+	 */
+	bool readCheckpoint(CheckpointIO& checkpoint);
+
 private:
 	/*
 	 * Attributes
@@ -0,0 +1,149 @@
+/*
+ * convolutioncache.cpp
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#include "convolutioncache.h"
+#include "../graph/memoryfootprint.h"
+
+#include <algorithm> // Command max
+
+constexpr size_t ConvolutionCache::DEFAULT_CAPACITY;
+constexpr size_t ConvolutionCache::NB_SHARDS;
+
+/*
+ * Constructors
+ */
+ConvolutionCache::ConvolutionCache(): ConvolutionCache(DEFAULT_CAPACITY){}
+ConvolutionCache::ConvolutionCache(const size_t& capacity): _shardCapacity( std::max( capacity / NB_SHARDS , size_t(1) ) ), _shards( new Shard[NB_SHARDS] ),
+		_nbHits(0), _nbMisses(0), _nbEvictions(0){
+	for(size_t i(0) ; i < NB_SHARDS ; ++i){
+		_shards[i]._bytes = 0;
+	}
+}
+
+/*
+ * Getters
+ */
+size_t ConvolutionCache::getCapacity() const { return _shardCapacity * NB_SHARDS; }
+uint64_t ConvolutionCache::getNbHits() const { return _nbHits; }
+uint64_t ConvolutionCache::getNbMisses() const { return _nbMisses; }
+uint64_t ConvolutionCache::getNbEvictions() const { return _nbEvictions; }
+
+/*
+ * shard(const uint64_t&) method: return the shard where the given key is stored (keys are mixed first, as consecutive ids are frequent)
+ */
+ConvolutionCache::Shard& ConvolutionCache::shard(const uint64_t& key){
+	const uint64_t mixed( (key ^ (key >> 29)) * 0x9E3779B97F4A7C15ULL );
+	return _shards[ (mixed >> 32) % NB_SHARDS ];
+}
+
+/*
+ * resultSize(const Distribution&) method: return the memory of a cached result, in bytes
+ */
+size_t ConvolutionCache::resultSize(const Distribution& result){ return sizeof(Distribution) + result.getMemorySize(); }
+
+/*
+ * convolute(const Weight_id&, const Weight_id&) method: return the convolution of both weights, computed only if the pair is not cached
+ * the convolution itself is done without holding the lock, two threads may then compute the same result (the first stored one is kept)
+ * cached results take their buffers from the heap, not from the arena of the computing thread, as they are shared by all the threads
+ */
+std::shared_ptr<const Distribution> ConvolutionCache::convolute(const Weight_id& id1, const Weight_id& id2){
+	const uint64_t key( (uint64_t(id1) << 32) | uint32_t(id2) );
+	Shard& s( shard(key) );
+	{
+		std::lock_guard<std::mutex> lock(s._mutex);
+		auto it = s._results.find(key);
+		if( it != s._results.end() ){
+			++_nbHits;
+			return it->second;
+		}
+	}
+	++_nbMisses;
+	const Distribution convolution( getWeightDictionary().getDistribution(id1).convolute( getWeightDictionary().getDistribution(id2) ) );
+	DistributionArena::Scope heapScope;
+	std::shared_ptr<const Distribution> result( new Distribution(convolution) );
+	if( resultSize(*result) > _shardCapacity ){
+		return result;
+	}
+	std::lock_guard<std::mutex> lock(s._mutex);
+	auto it = s._results.find(key);
+	if( it != s._results.end() ){
+		return it->second;
+	}
+	store( s , key , result );
+	return result;
+}
+
+/*
+ * store(Shard&, const uint64_t&, const std::shared_ptr<const Distribution>&) method: insert a result into the given shard (locked by the caller),
+ * after evicting its oldest entries until the result fits in (the result must not be larger than the shard capacity)
+ */
+void ConvolutionCache::store(Shard& s, const uint64_t& key, const std::shared_ptr<const Distribution>& result){
+	const size_t bytes( resultSize(*result) );
+	while( s._bytes + bytes > _shardCapacity ){
+		auto oldest = s._results.find( s._keys.front() );
+		s._bytes -= resultSize( *oldest->second );
+		s._results.erase( oldest );
+		s._keys.pop_front();
+		++_nbEvictions;
+	}
+	s._results.insert( std::make_pair( key , result ) );
+	s._keys.push_back(key);
+	s._bytes += bytes;
+}
+
+/*
+ * clear() method: remove all the cache entries and reset the counters
+ */
+void ConvolutionCache::clear(){
+	DistributionArena::Scope heapScope;
+	for(size_t i(0) ; i < NB_SHARDS ; ++i){
+		std::lock_guard<std::mutex> lock(_shards[i]._mutex);
+		_shards[i]._results.clear();
+		_shards[i]._keys.clear();
+		_shards[i]._bytes = 0;
+	}
+	_nbHits = 0;
+	_nbMisses = 0;
+	_nbEvictions = 0;
+}
+
+/*
+ * renumber(const std::vector<Weight_id>&) method: index the cached results by the new ids of their operands, the results of released weights
+ * being removed (the counters are kept)
+ * a new key may belong to another shard: the shards are emptied first, then the kept results are stored again in their insertion order
+ * (no other thread may use the cache meanwhile)
+ */
+void ConvolutionCache::renumber(const std::vector<Weight_id>& newIds){
+	DistributionArena::Scope heapScope;
+	std::unique_ptr<Shard[]> formerShards( new Shard[NB_SHARDS] );
+	for(size_t i(0) ; i < NB_SHARDS ; ++i){
+		formerShards[i]._results.swap( _shards[i]._results );
+		formerShards[i]._keys.swap( _shards[i]._keys );
+		_shards[i]._bytes = 0;
+	}
+	for(size_t i(0) ; i < NB_SHARDS ; ++i){
+		for(const uint64_t& key: formerShards[i]._keys){
+			const uint32_t id1( key >> 32 ), id2( static_cast<uint32_t>(key) );
+			if( id1 < newIds.size() && id2 < newIds.size() && newIds[id1] != INVALID_WEIGHT_ID && newIds[id2] != INVALID_WEIGHT_ID ){
+				const uint64_t newKey( (uint64_t(newIds[id1]) << 32) | uint32_t(newIds[id2]) );
+				store( shard(newKey) , newKey , formerShards[i]._results[key] );
+			}
+		}
+	}
+}
+
+/*
+ * getMemorySize() method: return the memory allocated for the cached results, their index and their insertion order, in bytes
+ */
+size_t ConvolutionCache::getMemorySize() const {
+	size_t bytes( NB_SHARDS * sizeof(Shard) );
+	for(size_t i = 0 ; i < NB_SHARDS ; ++i){
+		std::lock_guard<std::mutex> lock(_shards[i]._mutex);
+		bytes += _shards[i]._bytes + MemoryFootprint::bytes(_shards[i]._results) + MemoryFootprint::bytes(_shards[i]._keys);
+	}
+	return bytes;
+}
@@ -0,0 +1,106 @@
+/*
+ * convolutioncache.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_CONTRACTION_CONVOLUTIONCACHE_H_
+#define DATA_CONTRACTION_CONVOLUTIONCACHE_H_
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "../../misc.h"
+#include "../graph/distribution.h"
+#include "../graph/weightdictionary.h"
+
+/*
+ * Class ConvolutionCache: bounded memo of the convolutions done during the ordering process, keyed by the weight ids of both operands
+ * (a node simulated during several rounds with unchanged neighbour edges, then contracted, convolutes the same weight pairs each time).
+ * Results are owned by the cache, not interned in the weight dictionary: only the shortcuts that are actually added to the graph are.
+ * Entries are spread over NB_SHARDS shards, each one with its own lock and an equal part of the memory capacity; a shard evicts its
+ * oldest entries (FIFO) until the new result fits in.
+ */
+class ConvolutionCache{
+public:
+	/*
+	 * Constructors
+	 */
+	ConvolutionCache();
+	ConvolutionCache(const size_t& capacity); // Capacity in bytes
+
+	/*
+	 * Getters
+	 */
+	size_t getCapacity() const;
+	uint64_t getNbHits() const;
+	uint64_t getNbMisses() const;
+	uint64_t getNbEvictions() const;
+
+	/*
+	 * convolute(const Weight_id&, const Weight_id&) method: return the convolution of both weights, computed only if the pair is not cached
+	 * (the result stays valid after its eviction, as long as the caller holds it)
+	 */
+	std::shared_ptr<const Distribution> convolute(const Weight_id& id1, const Weight_id& id2);
+
+	/*
+	 * clear() method: remove all the cache entries and reset the counters
+	 */
+	void clear();
+
+	/*
+	 * renumber(const std::vector<Weight_id>&) method: index the cached results by the new ids of their operands (see WeightDictionary::compact()),
+	 * the results of released weights being removed
+	 */
+	void renumber(const std::vector<Weight_id>& newIds);
+
+	static constexpr size_t DEFAULT_CAPACITY = size_t(1) << 28; // Default maximal memory of the cached results, in bytes
+	static constexpr size_t NB_SHARDS = 64; // Number of independently locked parts of the cache
+
+	/*
+	 * getMemorySize() method: return the memory allocated for the cached results and their insertion order, in bytes
+	 */
+	size_t getMemorySize() const;
+
+private:
+	/*
+	 * Struct Shard: part of the cache, with the cached results, the insertion order of their keys and a lock
+	 */
+	struct Shard{
+		std::unordered_map< uint64_t, std::shared_ptr<const Distribution> > _results; // Cached convolution results, indexed by operand ids (id1.2^32+id2)
+		std::deque<uint64_t> _keys; // Keys of the cached results, in insertion order
+		size_t _bytes; // Memory of the cached results, in bytes
+		mutable std::mutex _mutex; // Lock on the shard
+	};
+
+	/*
+	 * resultSize(const Distribution&) method: return the memory of a cached result, in bytes
+	 */
+	static size_t resultSize(const Distribution& result);
+
+	/*
+	 * shard(const uint64_t&) method: return the shard where the given key is stored
+	 */
+	Shard& shard(const uint64_t& key);
+
+	/*
+	 * store(Shard&, const uint64_t&, const std::shared_ptr<const Distribution>&) method: insert a result into the given shard (locked by the caller),
+	 * after evicting its oldest entries until the result fits in
+	 */
+	void store(Shard& s, const uint64_t& key, const std::shared_ptr<const Distribution>& result);
+
+	/*
+	 * Attributes
+	 */
+	size_t _shardCapacity; // Maximal memory of the cached results of a shard, in bytes
+	std::unique_ptr<Shard[]> _shards; // Cache shards
+	std::atomic<uint64_t> _nbHits; // Number of requests answered by the cache
+	std::atomic<uint64_t> _nbMisses; // Number of requests that needed a convolution
+	std::atomic<uint64_t> _nbEvictions; // Number of entries removed because of a full shard
+};
+
+#endif /* DATA_CONTRACTION_CONVOLUTIONCACHE_H_ */
@@ -0,0 +1,296 @@
+/*
+ * edgesink.cpp
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#include "edgesink.h"
+#include "../graph/memoryfootprint.h"
+#include "../../data_io/checkpoint_io.h"
+
+#include <cstdlib> // Command abort
+#include <iterator> // Command make_move_iterator
+#include <unistd.h> // Command truncate
+
+constexpr uint8_t EdgeCollector::CHECKPOINT_TAG;
+constexpr size_t EdgeFileWriter::MAX_PENDING_BATCHES;
+constexpr uint32_t EdgeFileWriter::RECORD_VALUES;
+constexpr uint8_t EdgeFileWriter::CHECKPOINT_TAG;
+
+/*
+ * EdgeSink destructor
+ */
+EdgeSink::~EdgeSink(){}
+
+/*
+ * EdgeCollector methods
+ */
+const std::vector<Edge>& EdgeCollector::getEdges() const { return _edges; }
+void EdgeCollector::write(std::vector<Edge>&& edges){
+	if( _edges.empty() ){
+		_edges = std::move(edges);
+	}
+	else{
+		_edges.insert( _edges.end() , std::make_move_iterator( edges.begin() ) , std::make_move_iterator( edges.end() ) );
+	}
+}
+void EdgeCollector::close(){}
+void EdgeCollector::scanEdges(const std::function<void(const Edge&)>& visitor){
+	for(const Edge& edge: _edges){
+		visitor( edge );
+	}
+}
+void EdgeCollector::updateWeightIds(const std::function<void(Weight_id&)>& visitor){
+	for(auto* edges: { &_edges , &_restoredEdges }){
+		for(Edge& edge: *edges){
+			Weight_id id( edge.getWeightId() );
+			visitor( id );
+			edge.setWeightId( id );
+		}
+	}
+}
+void EdgeCollector::writeCheckpoint(CheckpointIO& checkpoint){
+	checkpoint.put( CHECKPOINT_TAG );
+	checkpoint.putEdges( _edges );
+}
+bool EdgeCollector::readCheckpoint(CheckpointIO& checkpoint){
+	uint8_t tag(0);
+	if( !checkpoint.get(tag) ){
+		return false;
+	}
+	if( tag != CHECKPOINT_TAG || !_edges.empty() ){
+		ERROR("Checkpoint taken with an edge file, or edges already written: the emitted edges cannot be restored in memory.\n");
+		return false;
+	}
+	return checkpoint.getEdges( _restoredEdges );
+}
+void EdgeCollector::restoreCheckpoint(){
+	write( std::move(_restoredEdges) );
+	_restoredEdges.clear();
+}
+uint64_t EdgeCollector::getNbEdges() const { return _edges.size(); }
+size_t EdgeCollector::getMemorySize() const { return MemoryFootprint::bytes(_edges); }
+
+/*
+ * EdgeFileWriter constructor and destructor
+ */
+EdgeFileWriter::EdgeFileWriter(const std::string& filename): _filename(filename), _nbEdges(0), _nbBytes(0), _restoredEdges(0), _restoredBytes(0),
+		_closed(false){
+	_flusher = std::thread( &EdgeFileWriter::flushPendingBatches , this );
+}
+EdgeFileWriter::~EdgeFileWriter(){ close(); }
+
+/*
+ * Getters
+ */
+const std::string& EdgeFileWriter::getFileName() const { return _filename; }
+uint64_t EdgeFileWriter::getNbEdges() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _nbEdges;
+}
+
+/*
+ * write(std::vector<Edge>&&) method: queue the given edges for the background thread, after waiting for a free place in the queue
+ */
+void EdgeFileWriter::write(std::vector<Edge>&& edges){
+	std::unique_lock<std::mutex> lock(_mutex);
+	if( _closed ){
+		ERROR("Edges written into the closed file '" << _filename << "'\n");
+		return;
+	}
+	_changed.wait( lock , [this]{ return _pending.size() < MAX_PENDING_BATCHES; } );
+	_nbEdges += edges.size();
+	_pending.push_back( std::move(edges) );
+	_changed.notify_all();
+}
+
+/*
+ * close() method: wait for the queued batches to be written, then close the file (nothing is done if the file is already closed)
+ */
+void EdgeFileWriter::close(){
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_closed = true;
+		_changed.notify_all();
+	}
+	if( _flusher.joinable() ){
+		_flusher.join();
+		if( _output.is_open() ){
+			_output.close();
+			if( !_output ){
+				ERROR("Unable to write file '" << _filename << "'\n");
+			}
+		}
+	}
+}
+
+/*
+ * scanEdges(const std::function<void(const Edge&)>&) method: close the file and read it back record by record, the weight of each edge
+ * being interned again with its stored window (the scan stops at the first corrupted record)
+ */
+void EdgeFileWriter::scanEdges(const std::function<void(const Edge&)>& visitor){
+	close();
+	if( _nbEdges == 0 ){ // The file may not exist
+		return;
+	}
+	std::ifstream input(_filename, std::ios::binary);
+	if( !input.is_open() ){
+		ERROR("Unable to open file '" << _filename << "'\n");
+		return;
+	}
+	uint32_t values[RECORD_VALUES];
+	std::vector<double> pdf, cdf;
+	Edge edge;
+	for(uint64_t e(0) ; e < _nbEdges ; ++e){
+		input.read( reinterpret_cast<char*>(values) , sizeof(values) );
+		if( !input || values[6] == 0 || values[5] + uint64_t(values[6]) > values[3] ){
+			ERROR("Edge file '" << _filename << "' corrupted (record " << e << ").\n");
+			return;
+		}
+		pdf.resize( values[6] );
+		cdf.resize( values[6] );
+		input.read( reinterpret_cast<char*>(pdf.data()) , pdf.size() * sizeof(double) );
+		input.read( reinterpret_cast<char*>(cdf.data()) , cdf.size() * sizeof(double) );
+		if( !input ){
+			ERROR("Edge file '" << _filename << "' corrupted (record " << e << ").\n");
+			return;
+		}
+		edge.setOrigin( Node_id(values[0]) );
+		edge.setDestination( Node_id(values[1]) );
+		edge.setMiddleNode( Node_id(values[2]) );
+		edge.setWeightId( getWeightDictionary().intern( Distribution( values[3] , values[4] , values[5] , pdf , cdf , false ) ) );
+		visitor( edge );
+	}
+}
+
+/*
+ * updateWeightIds(const std::function<void(Weight_id&)>&) method: wait for the queued batches to be written (their weights are read by the
+ * background thread), the written edges holding no weight id
+ */
+void EdgeFileWriter::updateWeightIds(const std::function<void(Weight_id&)>&){
+	std::unique_lock<std::mutex> lock(_mutex);
+	_changed.wait( lock , [this]{ return _pending.empty(); } );
+}
+
+/*
+ * writeCheckpoint(CheckpointIO&) method: wait for the queued batches to be written, then add the file name, the number of edges and the
+ * file size to the given snapshot
+ */
+void EdgeFileWriter::writeCheckpoint(CheckpointIO& checkpoint){
+	std::unique_lock<std::mutex> lock(_mutex);
+	_changed.wait( lock , [this]{ return _pending.empty(); } );
+	checkpoint.put( CHECKPOINT_TAG );
+	checkpoint.put( std::vector<char>( _filename.begin() , _filename.end() ) );
+	checkpoint.put( _nbEdges );
+	checkpoint.put( _nbBytes );
+}
+
+/*
+ * readCheckpoint(CheckpointIO&) method: read the state of the sink from the given snapshot, that must refer to the same file, at least as
+ * long as at the checkpoint, while no edge has been written by this sink yet
+ */
+bool EdgeFileWriter::readCheckpoint(CheckpointIO& checkpoint){
+	uint8_t tag(0);
+	std::vector<char> filename;
+	uint64_t nbEdges(0), nbBytes(0);
+	if( !checkpoint.get(tag) ){
+		return false;
+	}
+	if( tag != CHECKPOINT_TAG ){
+		ERROR("Checkpoint taken with the edges kept in memory: they cannot be restored into the edge file '" << _filename << "'.\n");
+		return false;
+	}
+	if( !checkpoint.get(filename) || !checkpoint.get(nbEdges) || !checkpoint.get(nbBytes) ){
+		return false;
+	}
+	if( std::string( filename.begin() , filename.end() ) != _filename ){
+		ERROR("Checkpoint taken with the edge file '" << std::string( filename.begin() , filename.end() ) << "', not '" << _filename << "'.\n");
+		return false;
+	}
+	std::ifstream input(_filename, std::ios::binary | std::ios::ate);
+	if( nbBytes > 0 && ( !input.is_open() || uint64_t( input.tellg() ) < nbBytes ) ){
+		ERROR("Edge file '" << _filename << "' missing or shorter than at the checkpoint.\n");
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(_mutex);
+	if( _nbEdges > 0 || _closed ){
+		ERROR("Edges already written into '" << _filename << "', the checkpoint cannot be restored.\n");
+		return false;
+	}
+	_restoredEdges = nbEdges;
+	_restoredBytes = nbBytes;
+	return true;
+}
+
+/*
+ * restoreCheckpoint() method: cut the file back to its size at the checkpoint (the edges written after it are dropped), the next batches
+ * being appended to it
+ */
+void EdgeFileWriter::restoreCheckpoint(){
+	if( _restoredBytes > 0 && truncate( _filename.c_str() , _restoredBytes ) != 0 ){
+		ERROR("Unable to cut file '" << _filename << "' back to its size at the checkpoint.\n");
+		std::abort();
+	}
+	std::lock_guard<std::mutex> lock(_mutex);
+	_nbEdges = _restoredEdges;
+	_nbBytes = _restoredBytes;
+}
+
+/*
+ * getMemorySize() method: return the memory held by the queued batches, in bytes
+ */
+size_t EdgeFileWriter::getMemorySize() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	size_t bytes( MemoryFootprint::bytes(_pending) );
+	for(const auto& batch: _pending){
+		bytes += MemoryFootprint::bytes(batch);
+	}
+	return bytes;
+}
+
+/*
+ * flushPendingBatches() method: body of the background thread, write the queued batches in their order until the sink is closed
+ * each edge is written as a record (see the class description); the batch is written and flushed without the lock, then removed from the queue
+ * the file is opened with the first batch, the written part of a restored file being kept (see restoreCheckpoint())
+ */
+void EdgeFileWriter::flushPendingBatches(){
+	std::vector<double> values;
+	std::unique_lock<std::mutex> lock(_mutex);
+	while( true ){
+		_changed.wait( lock , [this]{ return !_pending.empty() || _closed; } );
+		if( _pending.empty() ){
+			return;
+		}
+		const std::vector<Edge> batch( std::move( _pending.front() ) );
+		const bool append( _nbBytes > 0 );
+		lock.unlock();
+		if( !_output.is_open() ){
+			_output.open( _filename , std::ofstream::binary | ( append ? std::ofstream::app : std::ofstream::trunc ) );
+			if( !_output.is_open() ){
+				ERROR("Unable to open file '" << _filename << "'\n");
+			}
+		}
+		uint64_t nbBytes(0);
+		for(const Edge& edge: batch){
+			WeightView dist( edge.getWeight() );
+			const uint32_t record[RECORD_VALUES] = { edge.getOrigin() , edge.getDestination() , edge.getMiddleNode() , dist.getSize() , dist.getDelta() ,
+					dist.getWindowBegin() , dist.getWindowEnd() - dist.getWindowBegin() };
+			values.clear();
+			for(uint32_t t(record[5]) ; t < dist.getWindowEnd() ; ++t){
+				values.push_back( dist.getPdfT(t) );
+			}
+			for(uint32_t t(record[5]) ; t < dist.getWindowEnd() ; ++t){
+				values.push_back( dist.getCdfT(t) );
+			}
+			_output.write( reinterpret_cast<const char*>(record) , sizeof(record) );
+			_output.write( reinterpret_cast<const char*>(values.data()) , values.size() * sizeof(double) );
+			nbBytes += sizeof(record) + values.size() * sizeof(double);
+		}
+		_output.flush();
+		lock.lock();
+		_nbBytes += nbBytes;
+		_pending.pop_front();
+		_changed.notify_all();
+	}
+}
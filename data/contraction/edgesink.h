@@ -0,0 +1,186 @@
+/*
+ * edgesink.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_CONTRACTION_EDGESINK_H_
+#define DATA_CONTRACTION_EDGESINK_H_
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../misc.h"
+#include "../graph/edge.h"
+
+class CheckpointIO;
+
+/*
+ * Class EdgeSink: destination of the contracted graph edges, fed by Ordering::run() after each contraction round with the edges removed
+ * during the round (original node ids), then closed at the end of the ordering process
+ */
+class EdgeSink{
+public:
+	/*
+	 * Destructor
+	 */
+	virtual ~EdgeSink();
+
+	/*
+	 * write(std::vector<Edge>&&) method: take the edges removed during a contraction round
+	 */
+	virtual void write(std::vector<Edge>&& edges) = 0;
+
+	/*
+	 * close() method: end of the contracted graph, no more edge will be written
+	 */
+	virtual void close() = 0;
+
+	/*
+	 * scanEdges(const std::function<void(const Edge&)>&) method: call the given visitor on each written edge, in their writing order
+	 * (the sink is closed first), without gathering them
+	 */
+	virtual void scanEdges(const std::function<void(const Edge&)>& visitor) = 0;
+
+	/*
+	 * updateWeightIds(const std::function<void(Weight_id&)>&) method: call the given visitor on the weight id of each edge held by the sink,
+	 * that it may replace (see WeightDictionary::compact())
+	 */
+	virtual void updateWeightIds(const std::function<void(Weight_id&)>& visitor) = 0;
+
+	/*
+	 * writeCheckpoint(CheckpointIO&) method: add the state of the sink (the written edges, or where they are kept) to the given snapshot
+	 */
+	virtual void writeCheckpoint(CheckpointIO& checkpoint) = 0;
+
+	/*
+	 * readCheckpoint(CheckpointIO&) method: read the state of the sink from the given snapshot, return false if the sink cannot take it back
+	 * (snapshot of another kind of sink, edges already written...); the sink is unchanged until restoreCheckpoint() is called
+	 */
+	virtual bool readCheckpoint(CheckpointIO& checkpoint) = 0;
+
+	/*
+	 * restoreCheckpoint() method: take back the state read by readCheckpoint(), as if the edges of the snapshot had just been written
+	 */
+	virtual void restoreCheckpoint() = 0;
+
+	/*
+	 * getNbEdges() method: return the number of written edges
+	 */
+	virtual uint64_t getNbEdges() const = 0;
+
+	/*
+	 * getMemorySize() method: return the memory held by the sink, in bytes
+	 */
+	virtual size_t getMemorySize() const = 0;
+};
+
+/*
+ * Class EdgeCollector: sink keeping the contracted graph edges in memory (default sink of the ordering process)
+ */
+class EdgeCollector: public EdgeSink{
+public:
+	/*
+	 * Getter
+	 */
+	const std::vector<Edge>& getEdges() const;
+
+	/*
+	 * EdgeSink methods
+	 */
+	void write(std::vector<Edge>&& edges);
+	void close();
+	void scanEdges(const std::function<void(const Edge&)>& visitor);
+	void updateWeightIds(const std::function<void(Weight_id&)>& visitor);
+	void writeCheckpoint(CheckpointIO& checkpoint);
+	bool readCheckpoint(CheckpointIO& checkpoint);
+	void restoreCheckpoint();
+	uint64_t getNbEdges() const;
+	size_t getMemorySize() const;
+
+	static constexpr uint8_t CHECKPOINT_TAG = 0; // Kind of sink, first value of its snapshot
+
+private:
+	/*
+	 * Attributes
+	 */
+	std::vector<Edge> _edges; // Written edges
+	std::vector<Edge> _restoredEdges; // Edges read from a snapshot, waiting for restoreCheckpoint()
+};
+
+/*
+ * Class EdgeFileWriter: sink writing the contracted graph edges into a binary edge file, so that they are not kept in memory during the
+ * ordering process
+ * Edge batches are queued and written by a background thread, while the next round goes on; write() waits when MAX_PENDING_BATCHES
+ * batches are already queued, which bounds the memory. Each edge is a record of RECORD_VALUES uint32_t (origin, destination, middle node,
+ * then size, delta, first stored support point and length of the weight window) followed by the pdf and cdf of the window as doubles
+ * (native endianness): weights are read back exactly as they were interned.
+ * The file is created (or emptied) with the first written batch; a snapshot holds its name and the size of its written part, so that a
+ * resumed ordering process cuts the file back to this size and appends the next edges.
+ */
+class EdgeFileWriter: public EdgeSink{
+public:
+	/*
+	 * Constructors: start the background writing thread (the file is opened by the thread, see the class description)
+	 */
+	EdgeFileWriter(const std::string& filename);
+	EdgeFileWriter(const EdgeFileWriter&) = delete;
+	EdgeFileWriter& operator=(const EdgeFileWriter&) = delete;
+
+	/*
+	 * Destructor: close the file (see close())
+	 */
+	~EdgeFileWriter();
+
+	/*
+	 * Getter
+	 */
+	const std::string& getFileName() const;
+
+	/*
+	 * EdgeSink methods (scanEdges() reads the written file back, record by record; updateWeightIds() and writeCheckpoint() wait for the queued
+	 * batches to be written)
+	 */
+	void write(std::vector<Edge>&& edges);
+	void close();
+	void scanEdges(const std::function<void(const Edge&)>& visitor);
+	void updateWeightIds(const std::function<void(Weight_id&)>& visitor);
+	void writeCheckpoint(CheckpointIO& checkpoint);
+	bool readCheckpoint(CheckpointIO& checkpoint);
+	void restoreCheckpoint();
+	uint64_t getNbEdges() const;
+	size_t getMemorySize() const;
+
+	static constexpr size_t MAX_PENDING_BATCHES = 2; // Maximal number of edge batches waiting to be written
+	static constexpr uint32_t RECORD_VALUES = 7; // Number of uint32_t values heading each edge record
+	static constexpr uint8_t CHECKPOINT_TAG = 1; // Kind of sink, first value of its snapshot
+
+private:
+	/*
+	 * flushPendingBatches() method: body of the background thread, write the queued batches in their order until the sink is closed
+	 */
+	void flushPendingBatches();
+
+	/*
+	 * Attributes
+	 */
+	std::string _filename; // Name of the written file
+	std::ofstream _output; // Written file (used by the background thread only)
+	std::deque< std::vector<Edge> > _pending; // Batches waiting to be written, the first one being in writing
+	uint64_t _nbEdges; // Number of written edges
+	uint64_t _nbBytes; // Size of the file part holding the edges of the batches already written
+	uint64_t _restoredEdges, _restoredBytes; // Number of edges and file size read from a snapshot, waiting for restoreCheckpoint()
+	bool _closed; // True once close() has been called
+	mutable std::mutex _mutex; // Lock on the queue
+	std::condition_variable _changed; // Signal of a queue change
+	std::thread _flusher; // Background writing thread
+};
+
+#endif /* DATA_CONTRACTION_EDGESINK_H_ */
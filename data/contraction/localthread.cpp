@@ -6,22 +6,24 @@
  */
 
 #include "localthread.h"
+#include "../graph/memoryfootprint.h"
 
 /*
  * Constructor
  */
-LocalThread::LocalThread(Graph* graph): _g(graph), _witnessSearch(graph){}
+LocalThread::LocalThread(Graph* graph): _g(graph), _witnessSearch(graph), _arena(graph->getSpecif().getNbPts()+1){}
 
 /*
  * Getters
  */
 std::vector<Edge> LocalThread::getInsertedEdges(){ return _edgesToInsert; }
 std::vector<WitnessCacheEntry> LocalThread::getCacheEntries(){ return _witnessToCache;}
+DistributionArena& LocalThread::getArena(){ return _arena; }
 
 /*
  * run() method: proceed to a local witness search
  */
-uint8_t LocalThread::run(const Node_id& u_it, const Node_id& x_it, const Node_id& v_it, Distribution& dist_uxv){
+uint8_t LocalThread::run(const Node_id& u_it, const Node_id& x_it, const Node_id& v_it, const Distribution& dist_uxv){
 	return _witnessSearch.run(u_it, x_it, v_it, dist_uxv);
 }
 
@@ -77,3 +79,10 @@ std::ostream& operator<<(std::ostream& os, LocalThread& locthread){
 	}
 	return os;
 }
+
+/*
+ * getMemorySize() method: return the memory held by the thread: candidate edges, witnesses to cache, search context and distribution arena, in bytes
+ */
+size_t LocalThread::getMemorySize() const {
+	return MemoryFootprint::bytes(_edgesToInsert) + MemoryFootprint::bytes(_witnessToCache) + _witnessSearch.getMemorySize() + _arena.getMemorySize();
+}
@@ -33,11 +33,12 @@ public:
 	 */
 	std::vector<Edge> getInsertedEdges();
 	std::vector<WitnessCacheEntry> getCacheEntries();
+	DistributionArena& getArena();
 
 	/*
 	 * run() method: proceed to a local witness search
 	 */
-	uint8_t run(const Node_id& u_it, const Node_id& x_it, const Node_id& v_it, Distribution& dist_uxv);
+	uint8_t run(const Node_id& u_it, const Node_id& x_it, const Node_id& v_it, const Distribution& dist_uxv);
 
 	/*
 	 *addEdge(Edge&&) method: add an edge to the edge list
@@ -69,6 +70,11 @@ public:
 	 */
 	friend std::ostream& operator<<(std::ostream& os, LocalThread& locthread);
 
+	/*
+	 * getMemorySize() method: return the memory held by the thread: candidate edges, witnesses to cache, search context and distribution arena, in bytes
+	 */
+	size_t getMemorySize() const;
+
 protected:
 	/*
 	 * Attributes
@@ -77,6 +83,7 @@ protected:
 	std::vector<Edge> _edgesToInsert;
 	std::vector<WitnessCacheEntry> _witnessToCache;
 	WitnessSearch _witnessSearch;
+	DistributionArena _arena; // Probability buffers of the distributions handled by the thread (see DistributionArena::Scope)
 };
 
 
@@ -7,20 +7,39 @@
 
 
 #include <algorithm>
+#include <memory>
 #include <unordered_map>
 
 #include "ordering.h"
 
+#include "../../data_io/checkpoint_io.h"
 #include "../../data_io/edge_io.h"
 #include "../../data_io/hierarchy_io.h"
+#include "../graph/upwardgraph.h"
+
+constexpr uint32_t Ordering::WEIGHT_RELEASE_FACTOR;
 
 /*
  * Constructors
  */
-Ordering::Ordering(): _graph(), _wcache(0), _firstWorkingNode( 0 ), _lastWorkingNode( 0 ){}
+Ordering::Ordering(): _graph(), _wcache(0), _firstWorkingNode( 0 ), _lastWorkingNode( 0 ), _sink( &_collector ),
+		_checkpointRounds(0), _checkpointSeconds(0), _resumed(false), _nbKeptWeights(0){}
 Ordering::Ordering(Graph* g): _graph( g ), _wcache( g->getNbNodes() ), _nodeIds( g->getNbNodes() , INVALID_NODE_ID ), _nextNodeToContract( g->getNbNodes() , false ), _contractionCost( g->getNbNodes() , 0 ),
-		_nodeDepth( g->getNbNodes() , 1 ), _firstWorkingNode( 0 ), _lastWorkingNode( 0 ){
-	std::iota(_nodeIds.begin(),_nodeIds.end(), 0);
+		_nodeDepth( g->getNbNodes() , 1 ), _firstWorkingNode( 0 ), _lastWorkingNode( 0 ), _sink( &_collector ), _checkpointRounds(0), _checkpointSeconds(0), _resumed(false),
+		_nbKeptWeights(0){
+	// Nodes are processed in the order of their original ids, whatever the internal numbering of the graph
+	for ( uint32_t i = 0 ; i < _nodeIds.size() ; ++i ){
+		_nodeIds[i] = g->getPermutation().toInternal( Node_id(i) );
+	}
+}
+
+/*
+ * Destructor
+ */
+Ordering::~Ordering(){
+	if ( _checkpointWriter.joinable() ){
+		_checkpointWriter.join();
+	}
 }
 
 /*
@@ -40,6 +59,16 @@ void Ordering::setConfig(double param_eq, double param_d, double param_oeq, doub
 	_config.setParamOeq(param_oeq);
 	_config.setParamCq(param_cq);
 }
+void Ordering::setEdgeSink(EdgeSink* sink){
+	// The contracted graph edges are sent to the given sink instead of being kept in memory (NULL: back to the default in-memory sink)
+	_sink = ( sink == NULL ? &_collector : sink );
+}
+void Ordering::setCheckpoint(const std::string& filename, const uint32_t& nbRounds, const double& nbSeconds){
+	// A checkpoint is written at the end of a contraction round, every <nbRounds> rounds or every <nbSeconds> seconds (whichever comes first, 0 to ignore a criterion)
+	_checkpointFile = filename;
+	_checkpointRounds = nbRounds;
+	_checkpointSeconds = nbSeconds;
+}
 
 /*
  * simulateContraction(Node_id) method: initialize the hierarchy building by setting contraction cost of each node
@@ -51,7 +80,7 @@ void Ordering::simulateContraction(const Node_id& n){
 	for ( Edge_id e_in = _graph->getNodeBeginBW(n) ; e_in < _graph->getNodeEndBW(n) ; ++e_in ){
 		for ( Edge_id e_out = _graph->getNodeBeginFW(n) ; e_out < _graph->getNodeEndFW(n) ; ++e_out ){
 			// If current u->v->w path is such that u=w, no shortcut (trivial)
-			if ( _graph->getBwEdge(e_in).getOrigin() == _graph->getFwEdge(e_out).getDestination() ){
+			if ( _graph->getBwOrigin(e_in) == _graph->getFwDestination(e_out) ){
 				continue;
 			}
 			// Else, look for a witness path
@@ -60,8 +89,8 @@ void Ordering::simulateContraction(const Node_id& n){
 			// If there is no witness path, a shortcut is needed, insertion indicators are updated
 			if ( shortcut_necessary ){
 				++nbInsEdge;
-				nbOriginEdgeInsert += _graph->getBwEdge(e_in).getNbOriginalEdge() + _graph->getFwEdge(e_out).getNbOriginalEdge();
-				complexityInsert += _graph->getBwEdge(e_in).getWeight().range() + _graph->getFwEdge(e_out).getWeight().range();
+				nbOriginEdgeInsert += _graph->getBwNbOriginalEdge(e_in) + _graph->getFwNbOriginalEdge(e_out);
+				complexityInsert += _graph->getBwWeight(e_in).range() + _graph->getFwWeight(e_out).range();
 			}
 		}
 	}
@@ -69,14 +98,14 @@ void Ordering::simulateContraction(const Node_id& n){
 		// (REMOVAL INDICATORS) Loop over outcoming edges (that will be removed)
 		for ( Edge_id e = _graph->getNodeBeginFW(n) ; e < _graph->getNodeEndFW(n) ; ++e ){
 			++nbRemEdge;
-			nbOriginEdgeRemove += _graph->getFwEdge(e).getNbOriginalEdge();
-			complexityRemove += _graph->getFwEdge(e).getWeight().range();
+			nbOriginEdgeRemove += _graph->getFwNbOriginalEdge(e);
+			complexityRemove += _graph->getFwWeight(e).range();
 		}
 		// (REMOVAL INDICATORS) Loop over incoming edges (that will be removed)
 		for ( Edge_id e = _graph->getNodeBeginBW(n) ; e < _graph->getNodeEndBW(n) ; ++e ){
 			++nbRemEdge;
-			nbOriginEdgeRemove += _graph->getBwEdge(e).getNbOriginalEdge();
-			complexityRemove += _graph->getBwEdge(e).getWeight().range();
+			nbOriginEdgeRemove += _graph->getBwNbOriginalEdge(e);
+			complexityRemove += _graph->getBwWeight(e).range();
 		}
 	}
 	// Calculation of edge quotient: relative comparison between numbers of inserted and removed edges
@@ -96,15 +125,15 @@ void Ordering::simulateContraction(const Node_id& n){
  */
 bool Ordering::shortcutNeeded(const Edge_id& e_in, const Node_id& x, const Edge_id& e_out, const bool simulate, Edge& newEdge) {
 	// Recover nodes u and v, knowing that path u->x->v is focused
-	const Node_id u = _graph->getBwEdges()[e_in].getOrigin();
-	const Node_id v =  _graph->getFwEdges()[e_out].getDestination();
+	const Node_id u = _graph->getBwOrigin(e_in);
+	const Node_id v =  _graph->getFwDestination(e_out);
 	// Initialize witness and candidate shortcut
 	WitnessCacheEntry witness;
-	Distribution dist_ux = _graph->getBwEdges()[e_in].getWeight();
-	Distribution dist_xv = _graph->getFwEdges()[e_out].getWeight();
-	Distribution dist_uxv = dist_ux.convolute( dist_xv );
+	// The cached convolution is read in place: it stays valid while it is held, even if the cache evicts it meanwhile
+	const std::shared_ptr<const Distribution> convolution( _ccache.convolute( _graph->getBwWeightId(e_in) , _graph->getFwWeightId(e_out) ) );
+	const Distribution& dist_uxv( *convolution );
 	uint32_t shortcutComplexity = (witness.getStatus() == WitnessSearch::UNDECIDED ? dist_uxv.range(): witness.getComplexity() );
-	uint32_t nbOriginalEdge = _graph->getBwEdges()[e_in].getNbOriginalEdge() + _graph->getFwEdges()[e_out].getNbOriginalEdge();
+	uint32_t nbOriginalEdge = _graph->getBwNbOriginalEdge(e_in) + _graph->getFwNbOriginalEdge(e_out);
 	newEdge = Edge(true, u, v, dist_uxv, shortcutComplexity, nbOriginalEdge, x);
 	// Use already cached witness if present
 	if( !_wcache.empty( x ) ){
@@ -152,11 +181,12 @@ void Ordering::contract(const Edge_id& e_in, const Node_id x, const Edge_id& e_o
 bool Ordering::contraction(const Edge_id& e_in, const Node_id x, const Edge_id& e_out, bool simulate){
 	bool shortcutNeeded(false);
 	// Recover nodes u and v, knowing that path u->x->v is focused
-	const Node_id u = _graph->getBwEdges()[e_in].getOrigin();
-	const Node_id v =  _graph->getFwEdges()[e_out].getDestination();
-	Distribution dist_ux = _graph->getBwEdges()[e_in].getWeight();
-	Distribution dist_xv = _graph->getFwEdges()[e_out].getWeight();
-	Distribution dist_uxv = dist_ux.convolute( dist_xv );
+	const Node_id u = _graph->getBwOrigin(e_in);
+	const Node_id v =  _graph->getFwDestination(e_out);
+	// Convolution results are cached: simulations of a node with unchanged neighbour edges, and its real contraction, reuse them
+	// (the cached result is read in place, not copied into a buffer of the thread arena)
+	const std::shared_ptr<const Distribution> convolution( _ccache.convolute( _graph->getBwWeightId(e_in) , _graph->getFwWeightId(e_out) ) );
+	const Distribution& dist_uxv( *convolution );
 //	TRACEF("Is a shortcut needed between N" << u << " and N" << v << " (through N" << x << ")? ");
 	// Use already cached witness if present
 	WitnessCacheEntry witness;
@@ -164,7 +194,7 @@ bool Ordering::contraction(const Edge_id& e_in, const Node_id x, const Edge_id&
 		witness = _wcache.lookup(u,x,v);
 	}
 	uint32_t shortcutComplexity = (witness.getStatus() == WitnessSearch::UNDECIDED ? dist_uxv.range(): witness.getComplexity() );
-	uint32_t nbOriginalEdge = _graph->getBwEdges()[e_in].getNbOriginalEdge() + _graph->getFwEdges()[e_out].getNbOriginalEdge();
+	uint32_t nbOriginalEdge = _graph->getBwNbOriginalEdge(e_in) + _graph->getFwNbOriginalEdge(e_out);
 	// If witness is already cached (Witness search status is either necessary or unnecessary)
 	if ( witness.getStatus() != WitnessSearch::UNDECIDED ){//&& witness.getStatus() != WitnessSearch::NOT_NECESSARY ){
 		shortcutNeeded = witness.getStatus() == WitnessSearch::NECESSARY;
@@ -200,12 +230,13 @@ void Ordering::contractParallely(){
 	// First step: parallely contract in-processing nodes
 #pragma omp parallel
 	{
+		DistributionArena::Scope arenaScope( _localThreads[omp_get_thread_num()].getArena() );
 #pragma omp for schedule(dynamic) // Set-in parallel computing (on the working node set)
 		for ( uint32_t i = _firstWorkingNode ; i < _lastWorkingNode ; ++i ){
 			Node_id n(_nodeIds[i]);
 			for ( Edge_id e_in = _graph->getNodeBeginBW(n) ; e_in != _graph->getNodeEndBW(n) ; ++e_in ){
 				for ( Edge_id e_out = _graph->getNodeBeginFW(n) ; e_out != _graph->getNodeEndFW(n) ; ++e_out ){
-					if ( _graph->getBwEdges()[e_in].getOrigin() != _graph->getFwEdges()[e_out].getDestination() ){
+					if ( _graph->getBwOrigin(e_in) != _graph->getFwDestination(e_out) ){
 						contraction(e_in, n, e_out, false);//contract(e_in,n,e_out);
 					}
 				}
@@ -218,10 +249,10 @@ void Ordering::contractParallely(){
 		_wcache.remove( n ); // Remove all witness cache entries where n is the middle node
 		// We still have to remove entries where n is the first or the third node of the sequence u->x->v
 		for ( Edge_id e_in = _graph->getNodeBeginBW(n) ; e_in != _graph->getNodeEndBW(n) ; ++e_in ){
-			Node_id u( _graph->getBwEdges()[e_in].getOrigin() );
+			Node_id u( _graph->getBwOrigin(e_in) );
 			_wcache.remove(INVALID_NODE_ID, u, n); // Remove witness cache entries where n is the destination of the outcoming edge
 			for ( Edge_id e_out = _graph->getNodeBeginFW(n) ; e_out != _graph->getNodeEndFW(n) ; ++e_out ){
-				Node_id v( _graph->getFwEdges()[e_out].getDestination() );
+				Node_id v( _graph->getFwDestination(e_out) );
 				_wcache.remove(n, v, INVALID_NODE_ID); // Remove witness cache entries where n is the origin of the incoming edge
 			}
 		}
@@ -230,13 +261,15 @@ void Ordering::contractParallely(){
 
 /*
  * smallerCost(const Node_id&, const Node_id&) method: return true if node u has a smaller cost than node v, false otherwise
- * ties are broken with respect to node ids (in order to guarantee contraction stability during different instances)
+ * ties are broken with respect to original node ids (in order to guarantee contraction stability during different instances, whatever the
+ * internal numbering of the graph)
  */
 bool Ordering::smallerCost(const Node_id& u, const Node_id& v) const{
 	if ( lt(_contractionCost[u],_contractionCost[v]) ){
 		return true;
 	}
-	if ( eq(_contractionCost[u],_contractionCost[v]) && u < v){
+	const NodePermutation& permutation( _graph->getPermutation() );
+	if ( eq(_contractionCost[u],_contractionCost[v]) && permutation.toOriginal(u) < permutation.toOriginal(v) ){
 		return true;
 	}
 	return false;
@@ -260,7 +293,7 @@ bool Ordering::localMinimum(const Node_id& x, const int& hop_radius) const{
 		Q.pop();
 		// ...and check the adjacent nodes: for each forward edges, evaluate destination node contraction cost
 		for ( Edge_id e = _graph->getNodeBeginFW(u) ; e != _graph->getNodeEndFW(u) ; ++e ){
-			const Node_id v = _graph->getFwEdge(e).getDestination();
+			const Node_id v = _graph->getFwDestination(e);
 			// If node v hop counter has already been set during a previous iteration, continue
 			if ( n_hops.find(v) != n_hops.end() ){
 				continue;
@@ -280,7 +313,7 @@ bool Ordering::localMinimum(const Node_id& x, const int& hop_radius) const{
 		}
 		// Same process with backward edges
 		for ( Edge_id e = _graph->getNodeBeginBW(u) ; e != _graph->getNodeEndBW(u) ; ++e ){
-			const Node_id v = _graph->getBwEdge(e).getOrigin();
+			const Node_id v = _graph->getBwOrigin(e);
 			// If node v hop counter has already been set during a previous iteration, continue
 			if ( n_hops.find(v) != n_hops.end() ){
 				continue;
@@ -329,7 +362,7 @@ void Ordering::nextContractionSet(){
  * run(int) method: proceed to hierarchy construction and graph contraction
  * master method of this class
  */
-std::vector<Edge> Ordering::run(int nbThreads){
+uint64_t Ordering::run(int nbThreads){
 	HierarchyIO hierarchySaver();
 	auto beginTime = time_stamp();
 	// Initialize local thread vector with given number of threads (if the parameter is not specified, consider the maximum number of threads)
@@ -347,29 +380,37 @@ std::vector<Edge> Ordering::run(int nbThreads){
 //	STATUS("Preprocessing running with " << std::min(nbThreads, omp_get_max_threads()) << " threads\n");
 	// Parallely evaluate initial tentative node costs
 //	STATUS("Computing initial node costs... (BEGINNING)\n");
+	// (a process resumed from a checkpoint already knows them, as well as the witness cache)
 	auto timer1 = time_stamp();
+	if ( !_resumed ){
 #pragma omp parallel
-	{
+		{
+			DistributionArena::Scope arenaScope( _localThreads[omp_get_thread_num()].getArena() );
 #pragma omp for schedule(dynamic)
-		for ( auto x = _nodeIds.begin() ; x < _nodeIds.end() ; ++x ){
-			//			TRACE("Node to simulate:  N" << *x << "; fw edges: " << _graph->getNodeBeginFW(*x) << "-" << _graph->getNodeEndFW(*x) << "; bw edges = " << _graph->getNodeBeginBW(*x) << "-" << _graph->getNodeEndBW(*x) );
-			simulateContraction( (Node_id)*x );
+			for ( auto x = _nodeIds.begin() ; x < _nodeIds.end() ; ++x ){
+				//			TRACE("Node to simulate:  N" << *x << "; fw edges: " << _graph->getNodeBeginFW(*x) << "-" << _graph->getNodeEndFW(*x) << "; bw edges = " << _graph->getNodeBeginBW(*x) << "-" << _graph->getNodeEndBW(*x) );
+				simulateContraction( (Node_id)*x );
+			}
 		}
-	}
-	// At this stage, we know the initial contraction cost of each node, and a first set of witness search has been accomplished
-	// Update witness cache with local thread information
-	for ( auto& thread_data : _localThreads ){
-		for ( auto cacheEntry : thread_data.getCacheEntries() ){
-			_wcache.insert(cacheEntry);
+		// At this stage, we know the initial contraction cost of each node, and a first set of witness search has been accomplished
+		// Update witness cache with local thread information
+		for ( auto& thread_data : _localThreads ){
+			for ( auto cacheEntry : thread_data.getCacheEntries() ){
+				_wcache.insert(cacheEntry);
+			}
+			thread_data.clearCache();
 		}
-		thread_data.clearCache();
+		//	STATUS("Witness cache after initialization:\n" << _wcache);
+		auto timer2 = time_stamp();
+		STATUS( "Total initialization time: " << get_duration_in_seconds(timer1, timer2) << " sec (" << omp_get_max_threads() << " threads)\n" );
 	}
-	//	STATUS("Witness cache after initialization:\n" << _wcache);
-	auto timer2 = time_stamp();
-	STATUS( "Total initialization time: " << get_duration_in_seconds(timer1, timer2) << " sec (" << omp_get_max_threads() << " threads)\n" );
 	// End of the first step: initial costs are known, and witness cache is up-to-date
 	// Repeatedly compute independent sets and contract their nodes, merging necessary shortcuts with already present edges
 //	STATUS("Contract independent node sets...\n");
+	uint32_t nbRounds(0);
+	uint64_t nbReleasedWeights(0);
+	_nbKeptWeights = getWeightDictionary().getNbWeights();
+	auto lastCheckpointTime = time_stamp();
 	/* Main While Loop ***********************************************************************************************************************************************************/
 	while ( _firstWorkingNode < _nodeIds.size() ){
 		// Select nodes that have to be contracted next, and sort the nodes so as to place them at the beginning of the node array (working node indices are subsequently set)
@@ -380,8 +421,9 @@ std::vector<Edge> Ordering::run(int nbThreads){
 		// For each node that have been contracted:
 		// - set its level
 		// - identify the adjacent nodes (their depth must be updated immediately, as well as their contraction cost will be in the end of the current iteration)
-		// - delete the node and all incident edges
+		// Then delete these nodes and all incident edges, at once, after sending these edges to the edge sink (with original node ids)
 		std::vector<Node_id> nodes_to_update;
+		std::vector<Edge> roundEdges;
 		for ( size_t i = _firstWorkingNode ; i < _lastWorkingNode ; ++i ){
 			Node_id x(_nodeIds[i]);
 //			CONTINUE_STATUS("N" << x << " ");
@@ -390,21 +432,22 @@ std::vector<Edge> Ordering::run(int nbThreads){
 			// Identify nodes that are adjacent by the way of forward edges and save corresponding outgoing edges
 			for ( Edge_id e = _graph->getNodeBeginFW(x) ; e != _graph->getNodeEndFW(x) ; ++e ){
 //				CONTINUE_STATUS("(" << _graph->getFwEdge(e).getOrigin() << "->" << _graph->getFwEdge(e).getDestination() << ") ");
-				nodes_to_update.push_back( _graph->getFwEdge(e).getDestination() );
-				_nodeDepth[_graph->getFwEdge(e).getDestination()] = std::max(_nodeDepth[_graph->getFwEdge(e).getDestination()], _nodeDepth[x] + 1);
-				_newEdges.emplace_back( _graph->getFwEdge(e) );
+				nodes_to_update.push_back( _graph->getFwDestination(e) );
+				_nodeDepth[_graph->getFwDestination(e)] = std::max(_nodeDepth[_graph->getFwDestination(e)], _nodeDepth[x] + 1);
+				roundEdges.emplace_back( _graph->getFwEdge(e) );
 			}
 			// Identify nodes that are adjacent by the way of backward edges and save corresponding incoming edges
 			for ( Edge_id e = _graph->getNodeBeginBW(x) ; e != _graph->getNodeEndBW(x) ; ++e ){
 //				CONTINUE_STATUS("(" << _graph->getBwEdge(e).getOrigin() << "->" << _graph->getBwEdge(e).getDestination() << ") ");
-				nodes_to_update.push_back( _graph->getBwEdge(e).getOrigin() );
-				_nodeDepth[_graph->getBwEdge(e).getOrigin()] = std::max(_nodeDepth[_graph->getBwEdge(e).getOrigin()], _nodeDepth[x] + 1);
-				_newEdges.emplace_back( _graph->getBwEdge(e) );
+				nodes_to_update.push_back( _graph->getBwOrigin(e) );
+				_nodeDepth[_graph->getBwOrigin(e)] = std::max(_nodeDepth[_graph->getBwOrigin(e)], _nodeDepth[x] + 1);
+				roundEdges.emplace_back( _graph->getBwEdge(e) );
 			}
-			// Delete the node and all adjacent edges
-			_graph->deleteNode(x);
 //			CONTINUE_STATUS("\n");
 		}
+		_graph->getPermutation().toOriginal( roundEdges );
+		_sink->write( std::move(roundEdges) );
+		_graph->deleteNodes( std::vector<Node_id>( _nodeIds.begin() + _firstWorkingNode , _nodeIds.begin() + _lastWorkingNode ) );
 //		CONTINUE_STATUS("\n");
 		// Remove eventual duplicated nodes (a node may be adjacent with several contracted nodes, and may consequently have been pushed in the vector several times)
 		remove_duplicates(nodes_to_update);
@@ -424,7 +467,7 @@ std::vector<Edge> Ordering::run(int nbThreads){
 					_graph->addShortcut( std::move(candidateEdge) );
 				}
 				else{
-					if( candidateEdge.getWeight().dominates( _graph->getFwEdge(fwe).getWeight() ) ){
+					if( candidateEdge.dominates( _graph->getFwEdge(fwe) ) ){
 						_graph->updateEdgeInfo( fwe , bwe , candidateEdge );
 					}
 					else{
@@ -442,6 +485,7 @@ std::vector<Edge> Ordering::run(int nbThreads){
 		// Parallely update contraction cost for stored adjacent nodes
 #pragma omp parallel
 		{
+			DistributionArena::Scope arenaScope( _localThreads[omp_get_thread_num()].getArena() );
 #pragma omp for schedule(dynamic)
 			for ( auto x = nodes_to_update.begin() ; x < nodes_to_update.end() ; ++x ){
 //				TRACE("Node to update:  N" << *x << "; fw edges: " << _graph->getNodeBeginFW(*x) << "-" << _graph->getNodeEndFW(*x) << "; bw edges = " << _graph->getNodeBeginBW(*x) << "-" << _graph->getNodeEndBW(*x) );
@@ -457,26 +501,147 @@ std::vector<Edge> Ordering::run(int nbThreads){
 		}
 		// Mark all nodes in the current independent set as contracted
 		_firstWorkingNode = _lastWorkingNode;
+		// Release the weights that are not referred to anymore, once the weight dictionary has grown enough
+		if ( getWeightDictionary().getNbWeights() >= uint64_t(WEIGHT_RELEASE_FACTOR) * _nbKeptWeights ){
+			nbReleasedWeights += releaseWeights();
+		}
+		// Save the state of the process, if a checkpoint is due
+		++nbRounds;
+		if ( !_checkpointFile.empty() && _firstWorkingNode < _nodeIds.size() && ( ( _checkpointRounds > 0 && nbRounds % _checkpointRounds == 0 )
+				|| ( _checkpointSeconds > 0 && get_duration_in_seconds(lastCheckpointTime, time_stamp()) >= _checkpointSeconds ) ) ){
+			writeCheckpoint();
+			lastCheckpointTime = time_stamp();
+		}
 	}
 	/* End Main While Loop *******************************************************************************************************************************************************/
+	_sink->close();
+	nbReleasedWeights += releaseWeights();
 	auto endTime = time_stamp();
 	double total_ordering_time = get_duration_in_seconds(beginTime, endTime);
 	STATUS("Total ordering process took " << total_ordering_time << " sec (" << omp_get_max_threads() << " threads) in total.\n");
-	return _newEdges;
+	uint64_t nbBufferRequests(0), nbBufferAllocations(0);
+	for ( auto& thread_data : _localThreads ){
+		nbBufferRequests += thread_data.getArena().getNbRequests();
+		nbBufferAllocations += thread_data.getArena().getNbAllocations();
+	}
+	STATUS("Weight dictionary: " << getWeightDictionary().getNbWeights() << " distinct weights (" << nbReleasedWeights << " released during the ordering).\n");
+	STATUS("Convolution cache: " << _ccache.getNbHits() << " hits, " << _ccache.getNbMisses() << " misses, " << _ccache.getNbEvictions() << " evictions (capacity " << _ccache.getCapacity() << ").\n");
+	STATUS("Distribution buffers: " << nbBufferRequests << " requests, " << nbBufferAllocations << " heap allocations.\n");
+	return _sink->getNbEdges();
 }
 /* ************************************************************************************************************************************************************** */
 
+/*
+ * releaseWeights() method: release the stored weights that are referred to neither by the graph nor by the edge sink, return their number
+ * used weights are marked through the graph and the sink, then the dictionary is compacted and the same holders get the new ids; the
+ * checkpoint in writing is waited for first, as it reads weights by their ids
+ */
+uint32_t Ordering::releaseWeights(){
+	if ( _checkpointWriter.joinable() ){
+		_checkpointWriter.join();
+	}
+	WeightDictionary& dictionary( getWeightDictionary() );
+	const uint32_t nbWeights( dictionary.getNbWeights() );
+	std::vector<bool> used( nbWeights , false );
+	auto mark = [&used](Weight_id& id){ used[id] = true; };
+	_graph->updateWeightIds( mark );
+	_sink->updateWeightIds( mark );
+	const std::vector<Weight_id> newIds( dictionary.compact(used) );
+	auto renumber = [&newIds](Weight_id& id){ id = newIds[id]; };
+	_graph->updateWeightIds( renumber );
+	_sink->updateWeightIds( renumber );
+	_ccache.renumber( newIds );
+	_nbKeptWeights = dictionary.getNbWeights();
+	return nbWeights - _nbKeptWeights;
+}
+
+/*
+ * writeCheckpoint() method: take a snapshot of the ordering process and write it into the checkpoint file in a background thread
+ * the snapshot is a copy of the state, taken at the end of a round; the emitted edges are snapshotted by the edge sink (the edges themselves
+ * if they are kept in memory, the written part of the edge file otherwise, see EdgeSink::writeCheckpoint())
+ */
+void Ordering::writeCheckpoint(){
+	auto timer1 = time_stamp();
+	if ( _checkpointWriter.joinable() ){ // At most one checkpoint in writing
+		_checkpointWriter.join();
+	}
+	std::shared_ptr<CheckpointIO> checkpoint( new CheckpointIO( _nodeIds.size() ) );
+	checkpoint->put( _nodeIds );
+	checkpoint->put( _contractionCost );
+	checkpoint->put( _nodeDepth );
+	checkpoint->put( _firstWorkingNode );
+	checkpoint->put( _lastWorkingNode );
+	_wcache.writeCheckpoint( *checkpoint );
+	_sink->writeCheckpoint( *checkpoint );
+	_graph->writeCheckpoint( *checkpoint );
+	const std::string filename( _checkpointFile );
+	_checkpointWriter = std::thread( [checkpoint, filename](){ checkpoint->write( filename ); } );
+	auto timer2 = time_stamp();
+	STATUS("Checkpoint of " << _firstWorkingNode << "/" << _nodeIds.size() << " contracted nodes taken in " << get_duration_in_seconds(timer1, timer2) << " sec, written into '" << filename << "'.\n");
+}
+
+/*
+ * resume(const std::string&) method: restore the state of an interrupted ordering process from the given checkpoint
+ * the graph is restored last, the other structures (and the edge sink) being replaced only once the whole checkpoint is known to be valid
+ * (return false, nothing being changed, otherwise: e.g. if it has been taken with another kind of edge sink)
+ */
+bool Ordering::resume(const std::string& filename){
+	CheckpointIO checkpoint( filename );
+	if ( !checkpoint.isValid() ){
+		return false;
+	}
+	std::vector<Node_id> nodeIds;
+	std::vector<double> contractionCost;
+	std::vector<uint32_t> nodeDepth;
+	uint32_t firstWorkingNode, lastWorkingNode;
+	WitnessCache wcache( _nodeIds.size() );
+	bool valid( checkpoint.getNbNodes() == _nodeIds.size() && checkpoint.get(nodeIds) && checkpoint.get(contractionCost) && checkpoint.get(nodeDepth)
+			&& checkpoint.get(firstWorkingNode) && checkpoint.get(lastWorkingNode) && wcache.readCheckpoint(checkpoint) && _sink->readCheckpoint(checkpoint) );
+	valid = valid && nodeIds.size() == _nodeIds.size() && contractionCost.size() == _contractionCost.size() && nodeDepth.size() == _nodeDepth.size()
+			&& firstWorkingNode == lastWorkingNode && firstWorkingNode <= nodeIds.size();
+	if ( !valid || !_graph->readCheckpoint(checkpoint) || !checkpoint.atEnd() ){
+		ERROR("Checkpoint '" << filename << "' does not match the graph, the ordering process cannot be resumed.\n");
+		return false;
+	}
+	_nodeIds.swap( nodeIds );
+	_contractionCost.swap( contractionCost );
+	_nodeDepth.swap( nodeDepth );
+	_firstWorkingNode = firstWorkingNode;
+	_lastWorkingNode = lastWorkingNode;
+	_wcache = std::move( wcache );
+	_sink->restoreCheckpoint();
+	_resumed = true;
+	STATUS("Ordering process resumed from '" << filename << "': " << _firstWorkingNode << "/" << _nodeIds.size() << " contracted nodes.\n");
+	return true;
+}
+
 /*
  * serialize(std::string&) method: save node hierarchy and shortcuts into a text file
  * NOT YET IMPLEMENTED
  */
 void Ordering::writeOrdering(const std::string& hierarchyfilename, const std::string& edgefilename){
-	HierarchyIO hierarchySaver(hierarchyfilename, _graph->getSortedNodes(), _graph->getLevels() );
+	// Files refer to original node ids
+	const NodePermutation& permutation( _graph->getPermutation() );
+	HierarchyIO hierarchySaver(hierarchyfilename, permutation.originalIds( _graph->getSortedNodes() ), permutation.originalIndexing( _graph->getLevels() ) );
 	hierarchySaver.write();
-	EdgeIO shortcutSaver(edgefilename, _newEdges );
+	if ( _sink != &_collector ){
+		ERROR("Contracted graph edges sent to another edge sink, shortcut file '" << edgefilename << "' not written.\n");
+		return;
+	}
+	EdgeIO shortcutSaver(edgefilename, _collector.getEdges() );
 	shortcutSaver.write();
 }
 
+/*
+ * writeHierarchyImage(const std::string&) method: save the contracted graph, as needed by the queries, into a hierarchy image (see UpwardGraph::write())
+ * the upward graph is the one the query drivers build from the hierarchy and shortcut files (nodes renumbered by level), without the text round trip
+ * it is built while scanning the contracted graph edges of the edge sink (see EdgeSink::scanEdges()), that are not gathered into a graph
+ */
+void Ordering::writeHierarchyImage(const std::string& imagefilename){
+	const std::vector<Node_id> sortedNodes( _graph->getPermutation().originalIds( _graph->getSortedNodes() ) );
+	UpwardGraph( [this](const std::function<void(const Edge&)>& visitor){ _sink->scanEdges(visitor); } , _graph->getSpecif() , sortedNodes ).write( imagefilename );
+}
+
 /*
  * << operator: send a short description of an Ordering instance into a output stream (printing purpose)
  * format:
@@ -486,15 +651,34 @@ void Ordering::writeOrdering(const std::string& hierarchyfilename, const std::st
  */
 std::ostream& operator<<(std::ostream& os, Ordering& order){
 	TRACE("Ordering printing");
-	std::vector<Node> graphnodes = order._graph->getNodes();
-	std::vector<uint32_t> graphnodelevels = order._graph->getLevels();
-	std::vector<uint32_t>::iterator itl = graphnodelevels.begin();
+	const std::vector<Node>& graphnodes = order._graph->getNodes();
+	const std::vector<uint32_t>& graphnodelevels = order._graph->getLevels();
+	std::vector<uint32_t>::const_iterator itl = graphnodelevels.begin();
 	std::vector<double>::iterator itc = order._contractionCost.begin();
 	std::vector<uint32_t>::iterator itd = order._nodeDepth.begin();
 	os << order._localThreads.size() << " thread(s) has(have) been used. Nodes currently in process: " << order._firstWorkingNode << "-" << order._lastWorkingNode << "\n";
-	for(std::vector<Node>::iterator itn = graphnodes.begin() ; itn < graphnodes.end() ; ++itc, ++itd, ++itl, ++itn){
+	for(std::vector<Node>::const_iterator itn = graphnodes.begin() ; itn < graphnodes.end() ; ++itc, ++itd, ++itl, ++itn){
 		os << "(" << itn - graphnodes.begin() << ";" << *itl << ";" << *itc << ";" << *itd << ")\n";
 	}
 	os << "" << order._wcache;
 	return os;
 }
+
+/*
+ * memoryFootprint() method: return the memory held by the ordering: node data, edge sink, witness cache, search contexts of the threads and convolution cache
+ * (the contracted graph is not included, see Graph::memoryFootprint())
+ */
+MemoryFootprint Ordering::memoryFootprint() const {
+	MemoryFootprint footprint("Ordering");
+	footprint.add("node data", MemoryFootprint::bytes(_nodeIds) + MemoryFootprint::bytes(_nextNodeToContract)
+			+ MemoryFootprint::bytes(_contractionCost) + MemoryFootprint::bytes(_nodeDepth));
+	footprint.add("edge sink", _sink->getMemorySize());
+	footprint.add("witness cache", _wcache.memoryFootprint().getTotal());
+	size_t threadBytes( MemoryFootprint::bytes(_localThreads) );
+	for(const LocalThread& thread: _localThreads){
+		threadBytes += thread.getMemorySize();
+	}
+	footprint.add("search contexts", threadBytes);
+	footprint.add("convolution cache", _ccache.getMemorySize());
+	return footprint;
+}
@@ -8,9 +8,14 @@
 #ifndef DATA_CONTRACTION_ORDERING_H_
 #define DATA_CONTRACTION_ORDERING_H_
 
+#include <string>
+#include <thread>
+
 #include "../graph/graph.h"
 #include "localthread.h"
 #include "cachedwitness.h"
+#include "convolutioncache.h"
+#include "edgesink.h"
 #include "../../data_io/configreader.h"
 
 /*
@@ -24,6 +29,11 @@ public:
 	Ordering();
 	Ordering(Graph* g);
 
+	/*
+	 * Destructor: wait for the checkpoint in writing, if any
+	 */
+	~Ordering();
+
 	/*
 	 * Getters
 	 */
@@ -35,6 +45,16 @@ public:
 	 * Setters
 	 */
 	void setConfig(double param_eq, double param_d, double param_oeq, double param_cq);
+	void setEdgeSink(EdgeSink* sink);
+	void setCheckpoint(const std::string& filename, const uint32_t& nbRounds, const double& nbSeconds = 0);
+
+	/*
+	 * resume(const std::string&) method: restore the state of an interrupted ordering process from the given checkpoint (see setCheckpoint()),
+	 * so that run() goes on from the end of its last saved round; the graph must have been built from the same instance, and the same kind of
+	 * edge sink installed (see setEdgeSink(), an edge file sink being given the same file)
+	 * return false if the checkpoint cannot be read or does not match the graph or the edge sink (nothing is then restored)
+	 */
+	bool resume(const std::string& filename);
 
 	/*
 	 * simulateContraction(Node_id) method: initialize the hierarchy building by setting contraction cost of each node
@@ -87,25 +107,53 @@ public:
 
 	/*
 	 * run(int) method: proceed to hierarchy construction and graph contraction
+	 * the contracted graph edges are sent to the edge sink after each contraction round (see setEdgeSink()), return their number
 	 */
-	std::vector<Edge> run(int nbThreads = -1);
+	uint64_t run(int nbThreads = -1);
 
 	/*
 	 * writeOrdering(std::string&) method: save node hierarchy and shortcuts into a text file
 	 */
 	void writeOrdering(const std::string& filename1, const std::string& filename2);
 
+	/*
+	 * writeHierarchyImage(const std::string&) method: save the contracted graph, as needed by the queries, into a hierarchy image (see UpwardGraph::write())
+	 */
+	void writeHierarchyImage(const std::string& imagefilename);
+
 	/*
 	 * << operator: send a short description of an Ordering instance into a output stream (printing purpose)
 	 */
 	friend std::ostream& operator<<(std::ostream& os, Ordering& order);
 
+	/*
+	 * releaseWeights() method: release the stored weights that are referred to neither by the graph nor by the edge sink (shortcut weights
+	 * superseded by a dominating shortcut, weights of the edges written into an edge file), return their number
+	 * the weight ids of the graph, the edge sink and the convolution cache are renumbered: the graph and its edge sink must be the only
+	 * holders of weight ids in the process (see WeightDictionary::compact())
+	 */
+	uint32_t releaseWeights();
+
+	static constexpr uint32_t WEIGHT_RELEASE_FACTOR = 2; // Growth factor of the weight dictionary, since the last release, from which weights are released after a round
+
+	/*
+	 * writeCheckpoint() method: take a snapshot of the ordering process (graph, node order, costs and depths, witness cache, emitted edges)
+	 * and write it into the checkpoint file in a background thread (the contraction goes on during the writing)
+	 */
+	void writeCheckpoint();
+
+	/*
+	 * memoryFootprint() method: return the memory held by the ordering: node data, edge sink, witness cache, search contexts of the threads and convolution cache
+	 */
+	MemoryFootprint memoryFootprint() const;
+
 private:
 	/*
 	 * Attributes
 	 */
 	Graph* _graph;
 	WitnessCache _wcache;
+	ConvolutionCache _ccache; // Convolutions of neighbour edge weights, shared by simulated and real contractions
 	std::vector<LocalThread> _localThreads;
 	Configs::Config _config;
 	std::vector<Node_id> _nodeIds;
@@ -115,7 +163,14 @@ private:
 //	std::vector<uint32_t> _sortednodes; // Node level into the hierarchy (sorted by levels)
 	uint32_t _firstWorkingNode;
 	uint32_t _lastWorkingNode;
-	std::vector<Edge> _newEdges;
+	EdgeCollector _collector; // Default edge sink, keeping the contracted graph edges in memory
+	EdgeSink* _sink; // Destination of the contracted graph edges
+	std::string _checkpointFile; // Checkpoint file, empty if no checkpoint is written
+	uint32_t _checkpointRounds; // Number of contraction rounds between two checkpoints (0: not used)
+	double _checkpointSeconds; // Time between two checkpoints, in seconds (0: not used)
+	std::thread _checkpointWriter; // Background thread writing the last checkpoint
+	bool _resumed; // True if the state has been restored from a checkpoint (the initial node costs are then known)
+	uint32_t _nbKeptWeights; // Number of stored weights after the last release (see releaseWeights())
 };
 
 
@@ -6,43 +6,95 @@
  */
 
 #include "distribution.h"
+#include "memoryfootprint.h"
+#include "kernels.h"
+
+/*
+ * acquireBuffer(std::vector<double>&, const size_t&, const double&) function: set the (empty) given vector with <length> values equal to <value>,
+ * from the current thread arena if there is one
+ */
+static void acquireBuffer(std::vector<double>& buffer, const size_t& length, const double& value){
+	DistributionArena* arena( DistributionArena::current() );
+	if(arena != NULL){
+		arena->acquire(buffer, length, value);
+	}
+	else{
+		buffer.assign(length, value);
+	}
+}
+
+/*
+ * releaseBuffer(std::vector<double>&) function: give back the buffer of the given vector to the current thread arena if there is one, free it otherwise
+ */
+static void releaseBuffer(std::vector<double>& buffer){
+	DistributionArena* arena( DistributionArena::current() );
+	if(arena != NULL){
+		arena->release(buffer);
+	}
+	else{
+		std::vector<double>().swap(buffer);
+	}
+}
+
+/*
+ * copyBuffer(std::vector<double>&, const std::vector<double>&) function: copy the source values into the destination vector,
+ * whose buffer is replaced by an arena one only if it is too small
+ */
+static void copyBuffer(std::vector<double>& destination, const std::vector<double>& source){
+	if( destination.capacity() < source.size() ){
+		releaseBuffer(destination);
+		acquireBuffer(destination, source.size(), 0);
+	}
+	destination.assign(source.begin(), source.end());
+}
 
 
 /*
  * Constructors
+ * the window constructor trims the given window unless trimmed is false (a stored window, e.g. read back from a file, is then restored as is)
  */
-Distribution::Distribution(){
-	_suppoints.push_back(0);
-	_cdf.push_back(1);
-	_pdf.push_back(1);
+Distribution::Distribution(): _size(1), _delta(1), _start(0){
+	acquireBuffer(_cdf, 1, 1);
+	acquireBuffer(_pdf, 1, 1);
+	computeSummary();
 }
-Distribution::Distribution(const int& size): _suppoints(size,0), _cdf(size,0), _pdf(size,0){
-	std::iota(_suppoints.begin(), _suppoints.end(), 0);
-	_pdf[size-1] = 1;
-	_cdf[size-1] = 1;
+Distribution::Distribution(const int& size): _size(size), _delta(1), _start(size-1){
+	acquireBuffer(_cdf, 1, 1);
+	acquireBuffer(_pdf, 1, 1);
+	computeSummary();
 }
-Distribution::Distribution(const int& size, const int& delta): _suppoints(size,0), _cdf(size,0), _pdf(size,0){
-	std::iota(_suppoints.begin(), _suppoints.end(), 0);
-	std::transform(_suppoints.begin(),_suppoints.end(),_suppoints.begin(),std::bind2nd( std::multiplies<double>(), delta) );
-	_pdf[size-1] = 1;
-	_cdf[size-1] = 1;
+Distribution::Distribution(const int& size, const int& delta): _size(size), _delta(delta), _start(size-1){
+	acquireBuffer(_cdf, 1, 1);
+	acquireBuffer(_pdf, 1, 1);
+	computeSummary();
 }
-Distribution::Distribution(const int& size, const int& delta, const bool& infinite):_suppoints(size,0),_cdf(size,1),_pdf(size,0){
+Distribution::Distribution(const int& size, const int& delta, const bool& infinite): _size(size), _delta(delta), _start(0){
 	if(infinite){
-		Distribution(size,delta);
+		_start = size-1;
+	}
+	acquireBuffer(_cdf, 1, 1);
+	acquireBuffer(_pdf, 1, 1);
+	computeSummary();
+}
+Distribution::Distribution(const std::vector<uint32_t>& x, const std::vector<double>& p, const std::vector<double>& u):
+		_size(x.size()), _delta( (x.size()>1) ? x[1]-x[0] : 1 ), _start(0){
+	copyBuffer(_cdf, u);
+	copyBuffer(_pdf, p);
+	trim();
+}
+Distribution::Distribution(const uint32_t& size, const uint32_t& delta, const uint32_t& start, const std::vector<double>& p, const std::vector<double>& u,
+		const bool& trimmed): _size(size), _delta(delta), _start(start){
+	copyBuffer(_cdf, u);
+	copyBuffer(_pdf, p);
+	assert( !_cdf.empty() && _cdf.size() == _pdf.size() && _start + _cdf.size() <= _size );
+	if( trimmed ){
+		trim();
 	}
 	else{
-		std::iota(_suppoints.begin(), _suppoints.end(), 0);
-		std::transform(_suppoints.begin(),_suppoints.end(),_suppoints.begin(),std::bind2nd( std::multiplies<double>(), delta) );
-		_pdf[0] = 1;
+		computeSummary();
 	}
 }
-Distribution::Distribution(const std::vector<uint32_t>& x, const std::vector<double>& p, const std::vector<double>& u){
-	_suppoints = x;
-	_pdf = p;
-	_cdf = u;
-}
-Distribution::Distribution(const std::string& filename){
+Distribution::Distribution(const std::string& filename): _size(0), _delta(1), _start(0){
 	if (filename == "")
 	{
 		ERROR("Empty input file name given.\n");
@@ -54,51 +106,118 @@ Distribution::Distribution(const std::string& filename){
 		CONTINUE_STATUS(" ABORT\n");
 		ERROR("Unable to open file '" << filename << "'\n");
 	}
+	std::vector<uint32_t> suppoints;
 	uint32_t suppoint(0);
 	double alpha(0);
 	while( !input_cdf.eof() ){
 		input_cdf >> suppoint;
-		_suppoints.push_back( suppoint );
+		suppoints.push_back( suppoint );
 		input_cdf >> alpha;
 		_pdf.push_back( alpha );
 		_cdf.push_back( alpha );
 	}
 	std::partial_sum(_pdf.begin(), _pdf.end(), _cdf.begin());
+	_size = suppoints.size();
+	if(_size > 1){
+		_delta = suppoints[1] - suppoints[0];
+	}
+	trim();
 	CONTINUE_STATUS("OK.\n");
 	input_cdf.close();
 }
+Distribution::Distribution(const Distribution& dist): _size(dist._size), _delta(dist._delta), _start(dist._start),
+		_summaryValid(dist._summaryValid), _minIndex(dist._minIndex), _maxIndex(dist._maxIndex), _esperance(dist._esperance){
+	copyBuffer(_cdf, dist._cdf);
+	copyBuffer(_pdf, dist._pdf);
+}
+
+/*
+ * Assignment operators: copies reuse the current buffers when they are large enough, moves give the current buffers back to the arena
+ */
+Distribution& Distribution::operator=(const Distribution& dist){
+	if(this != &dist){
+		_size = dist._size;
+		_delta = dist._delta;
+		_start = dist._start;
+		copyBuffer(_cdf, dist._cdf);
+		copyBuffer(_pdf, dist._pdf);
+		_summaryValid = dist._summaryValid;
+		_minIndex = dist._minIndex;
+		_maxIndex = dist._maxIndex;
+		_esperance = dist._esperance;
+	}
+	return *this;
+}
+Distribution& Distribution::operator=(Distribution&& dist){
+	if(this != &dist){
+		releaseBuffer(_cdf);
+		releaseBuffer(_pdf);
+		_size = dist._size;
+		_delta = dist._delta;
+		_start = dist._start;
+		_cdf = std::move(dist._cdf);
+		_pdf = std::move(dist._pdf);
+		_summaryValid = dist._summaryValid;
+		_minIndex = dist._minIndex;
+		_maxIndex = dist._maxIndex;
+		_esperance = dist._esperance;
+	}
+	return *this;
+}
 
 /*
- * Destructor
+ * Destructor: give the probability buffers back to the current thread arena
  */
 Distribution::~Distribution(){
-	_suppoints.clear();
-	_cdf.clear();
-	_pdf.clear();
+	releaseBuffer(_cdf);
+	releaseBuffer(_pdf);
 }
 
 /*
  * Getters
  */
-std::vector<uint32_t> Distribution::getSup() const { return _suppoints; }
-std::vector<double> Distribution::getCdf() const { return _cdf; }
-std::vector<double> Distribution::getPdf() const { return _pdf; }
-uint32_t Distribution::getSupT(const uint32_t& t) const { return _suppoints[t]; }
-double Distribution::getCdfT(const uint32_t& t) const { return _cdf[t]; }
-double Distribution::getPdfT(const uint32_t& t) const { return _pdf[t]; }
+std::vector<uint32_t> Distribution::getSup() const {
+	std::vector<uint32_t> sup(_size,0);
+	for(uint32_t t(0) ; t < _size ; ++t){
+		sup[t] = t * _delta;
+	}
+	return sup;
+}
+std::vector<double> Distribution::getCdf() const {
+	std::vector<double> cdf(_size,0);
+	for(uint32_t t(_start) ; t < _size ; ++t){
+		cdf[t] = cdfAt(t);
+	}
+	return cdf;
+}
+std::vector<double> Distribution::getPdf() const {
+	std::vector<double> pdf(_size,0);
+	std::copy(_pdf.begin(), _pdf.end(), pdf.begin()+_start);
+	return pdf;
+}
+uint32_t Distribution::getSupT(const uint32_t& t) const { return t * _delta; }
+double Distribution::getCdfT(const uint32_t& t) const { return cdfAt(t); }
+double Distribution::getPdfT(const uint32_t& t) const { return pdfAt(t); }
 
 /*
  * Setters
  */
-void Distribution::setSup(std::vector<uint32_t> newSup){ _suppoints = newSup; }
-void Distribution::setPdf(std::vector<double> newPdf){ _pdf = newPdf; }
-void Distribution::setCdf(std::vector<double> newCdf){ _cdf = newCdf; }
-void Distribution::setSupT(uint32_t index, uint32_t newValue){
-	assert((index>=0)&&(index<_suppoints.size()));
-	_suppoints[index] = newValue;
+void Distribution::setPdf(std::vector<double> newPdf){
+	assert( newPdf.size() == _size );
+	_cdf = getCdf();
+	_pdf = newPdf;
+	_start = 0;
+	trim();
+}
+void Distribution::setCdf(std::vector<double> newCdf){
+	assert( newCdf.size() == _size );
+	_pdf = getPdf();
+	_cdf = newCdf;
+	_start = 0;
+	trim();
 }
 void Distribution::setPdfT(uint32_t index, double newValue){
-	assert( (index>=0) && (index<_pdf.size()) );
+	assert( (index>=0) && (index<_size) );
 	if(!le(0,newValue)){
 		ERROR("Negative pdf error: Pdf value provided for index t=" << index << " is not comprised between 0 and 1! (" << newValue << ")" << "\n");
 	}
@@ -106,10 +225,12 @@ void Distribution::setPdfT(uint32_t index, double newValue){
 		ERROR("Larger than 1 pdf error: Pdf value provided for index t=" << index << " is not comprised between 0 and 1! (" << newValue << ")" << "\n");
 	}
 //	assert( le(0,newValue) && le(newValue,1) );
-	_pdf[index] = newValue;
+	extendWindow(index);
+	_pdf[index-_start] = newValue;
+	_summaryValid = false;
 }
 void Distribution::setCdfT(uint32_t index, double newValue){
-	assert((index>=0)&&(index<_cdf.size()));
+	assert((index>=0)&&(index<_size));
 	if(!le(0,newValue)){
 		ERROR("Negative pdf error: Pdf value provided for index t=" << index << " is not comprised between 0 and 1! (" << newValue << ")" << "\n");
 	}
@@ -117,28 +238,28 @@ void Distribution::setCdfT(uint32_t index, double newValue){
 		ERROR("Larger than 1 pdf error: Pdf value provided for index t=" << index << " is not comprised between 0 and 1! (" << newValue << ")" << "\n");
 	}
 //	assert(le(0,newValue)&&le(newValue,1));
-	_cdf[index] = newValue;
+	extendWindow(index);
+	_cdf[index-_start] = newValue;
+	_summaryValid = false;
 }
 
 /*
  * isInfinite() method: check if the distribution is "infinite", that means the only possible value is the maximum of the admitted range [0;Tmax], ie cdf(t)=1 if t=Tmax, cdf(t)=0 otherwise
  */
 bool Distribution::isInfinite(){
-	auto it = std::find_if(_cdf.begin(), _cdf.end(), [](double& a)->bool { /*std::cout << a << "-";*/ return eq(a,1); } );
-	//		TRACE("it: " << *it << " --- _cdf.size() = " << _cdf.size() );
-	return it == _cdf.end()-1 && _cdf.size() > 1;// && (*_cdf.end() == 1);
+	auto it = std::find_if(_cdf.begin(), _cdf.end(), [](double& a)->bool { return eq(a,1); } );
+	return it != _cdf.end() && _start + (it - _cdf.begin()) == _size-1 && _size > 1;
 }
 
 /*
  * reset() method: reset the distribution
  */
 void Distribution::reset(){
-	_suppoints.clear();
-	_suppoints.push_back(0);
-	_pdf.clear();
-	_pdf.push_back(1);
-	_cdf.clear();
-	_cdf.push_back(1);
+	_size = 1;
+	_start = 0;
+	_pdf.assign(1,1);
+	_cdf.assign(1,1);
+	computeSummary();
 }
 
 /*
@@ -146,49 +267,69 @@ void Distribution::reset(){
  * Here infinite means the same size, but the only support point with non-nul probability is the maximal one
  */
 void Distribution::makeInfinite(){
-	std::fill(_pdf.begin(), _pdf.end(), 0 );
-	std::fill(_cdf.begin(), _cdf.end(), 0 );
-	_pdf.back() = 1;
-	_cdf.back() = 1;
+	_start = _size-1;
+	_pdf.assign(1,1);
+	_cdf.assign(1,1);
+	computeSummary();
+}
+
+/*
+ * updateSummary() method: recompute the cached summary (min, max, esperance) after element-wise modifications (setPdfT, setCdfT)
+ * until then, summary queries scan the stored window (they never modify the distribution, which can be read by several threads)
+ */
+void Distribution::updateSummary(){
+	if(!_summaryValid){
+		computeSummary();
+	}
 }
 
 /*
  * getSize() method: return the number of support points
  */
-uint32_t Distribution::getSize() const{ return _suppoints.size(); }
+uint32_t Distribution::getSize() const{ return _size; }
 
 /*
  * getDelta() method: return the difference between each support points (defined as a constant value)
  */
 uint32_t Distribution::getDelta() const{
-	if(_suppoints.size()>1)
-		return _suppoints[1]-_suppoints[0];
+	if(_size>1)
+		return _delta;
 	else
 		return 0;
 }
 
+/*
+ * getWindowBegin() method: return the index of the first stored support point (pdf and cdf are 0 before it)
+ */
+uint32_t Distribution::getWindowBegin() const{ return _start; }
+
+/*
+ * getWindowEnd() method: return the index following the last stored support point (pdf is 0 and cdf is constant after it)
+ */
+uint32_t Distribution::getWindowEnd() const{ return _start + _cdf.size(); }
+
 /*
  * getSupI(uint32_t) method: return the i^th support point
  */
 uint32_t Distribution::getSupI(uint32_t index) const{
-	assert((index>=0)&&(index<_suppoints.size()));
-	return _suppoints[index];
+	assert((index>=0)&&(index<_size));
+	return index * _delta;
 }
 
 /*
  * getProbI(double) method: return the i^th step of the cdf
  */
 double Distribution::getPdfI(uint32_t index) const{
-	assert((index>=0)&&(index<_pdf.size()));
-	return _pdf[index];
+	assert((index>=0)&&(index<_size));
+	return pdfAt(index);
 }
 
 /*
  * getCumI(double) method: return the i^th step of the cdf
  */
 double Distribution::getCdfI(uint32_t index) const{
-	assert((index>=0)&&(index<_cdf.size()));
-	return _cdf[index];
+	assert((index>=0)&&(index<_size));
+	return cdfAt(index);
 }
 
 /*
@@ -197,10 +338,10 @@ double Distribution::getCdfI(uint32_t index) const{
 double Distribution::Cdf(uint32_t t) const{
 	assert( t>=0 );
 	uint32_t delta = getDelta();
-	if(t >= _suppoints.size()*delta )
+	if(t >= _size*delta )
 		return 1;
 	else
-		return _cdf[ t / delta ];
+		return cdfAt( t / delta );
 }
 
 /*
@@ -209,44 +350,62 @@ double Distribution::Cdf(uint32_t t) const{
 double Distribution::Pdf(uint32_t t) const{
 	assert( t>=0 );
 	uint32_t delta = getDelta();
-	return ( t%delta == 0 && t>=delta*_suppoints.size() )?_pdf[ t / delta ]:0;
+	if(delta == 0)
+		return (t == 0)?pdfAt(0):0;
+	return ( t%delta == 0 && t<delta*_size )?pdfAt( t / delta ):0;
 }
 
 /*
- * min() method: return the minimum possible realization
+ * min() method: return the minimum possible realization (cached, O(1))
  */
 uint32_t Distribution::min() const{
-	std::vector<double>::const_iterator itcdf = std::find_if(_cdf.begin(), _cdf.end(), [](const double& value) { return gt(value,0); });
-//	TRACE("Min element index: " << itcdf - _cdf.begin() << " (total elements:" << _cdf.size() << ") ==> MIN=" << _suppoints[itcdf-_cdf.begin()] );
-	return _suppoints[itcdf - _cdf.begin()];
+	if(!_summaryValid){
+		uint32_t minIndex, maxIndex;
+		double esperance;
+		summarize(minIndex, maxIndex, esperance);
+		return minIndex * _delta;
+	}
+	return _minIndex * _delta;
 }
 
 /*
- * max() method: return the maximum possible realization
+ * max() method: return the maximum possible realization (cached, O(1))
  */
 uint32_t Distribution::max() const{
-	std::vector<double>::const_iterator itcdf = std::find_if(_cdf.begin(), _cdf.end(), [](const double& value) { return eq( value , 1.0 ); });
-//	TRACE("Max element index: " << itcdf - _cdf.begin() << " (total elements:" << _cdf.size() << ") ==> MAX=" << _suppoints[itcdf-_cdf.begin()]);
-	return _suppoints[itcdf - _cdf.begin()];
+	if(!_summaryValid){
+		uint32_t minIndex, maxIndex;
+		double esperance;
+		summarize(minIndex, maxIndex, esperance);
+		return maxIndex * _delta;
+	}
+	return _maxIndex * _delta;
 }
 
 /*
- * range() method: return the definition range of the distribution, namely max()-min()
+ * range() method: return the definition range of the distribution, namely max()-min() (cached, O(1))
  */
 uint32_t Distribution::range() const{
-	std::vector<double>::const_iterator itcdfmin = std::find_if(_cdf.begin(), _cdf.end(), [](const double& value) { return gt(value,0); });
-	std::vector<double>::const_iterator itcdfmax = std::find_if(itcdfmin, _cdf.end(), [](const double& value) { return eq(value,1); });
-//	TRACE("Min element index: " << itcdfmin - _cdf.begin() << " -- Max element index: " << itcdfmax - _cdf.begin() << " (total elements:"
-//			<< _cdf.size() << ") ==> MIN=" << _suppoints[itcdfmin-_cdf.begin()]  << " MAX=" << _suppoints[itcdfmax-_cdf.begin()]);
-	return ( _suppoints[itcdfmax - _cdf.begin()] - _suppoints[itcdfmin - _cdf.begin()] ) ;
+	if(!_summaryValid){
+		uint32_t minIndex, maxIndex;
+		double esperance;
+		summarize(minIndex, maxIndex, esperance);
+		return ( maxIndex - minIndex ) * _delta;
+	}
+	return ( _maxIndex - _minIndex ) * _delta;
 }
 
 /*
  * esp() method: return the esperance of the distribution
- * E(T) = sum_t=0->Tmax_{t*p(t)}
+ * E(T) = sum_t=0->Tmax_{t*p(t)} (cached, O(1))
  */
 double Distribution::esp() const{
-	return std::inner_product( _suppoints.begin() , _suppoints.end() , _pdf.begin() , 0.0);
+	if(!_summaryValid){
+		uint32_t minIndex, maxIndex;
+		double esperance;
+		summarize(minIndex, maxIndex, esperance);
+		return esperance;
+	}
+	return _esperance;
 }
 
 /*
@@ -255,44 +414,127 @@ double Distribution::esp() const{
  */
 double Distribution::evalSup(double alpha){
 	assert((alpha<=1+EPSILON) && (alpha>=-EPSILON));
-	std::vector<double>::iterator italpha = _cdf.begin();
-	while( (EPSILON < alpha-*italpha) && (italpha < _cdf.end()-1) ){
-		++italpha;
+	if( !(EPSILON < alpha) ){
+		return 0; // cdf is at least 0 from the first support point
+	}
+	uint32_t i(0);
+	while( (EPSILON < alpha-_cdf[i]) && (i < _cdf.size()-1) ){
+		++i;
+	}
+	if( (i == _cdf.size()-1) && (EPSILON < alpha-_cdf[i]) ){
+		return (_size-1) * _delta; // the cdf stays constant after the window, alpha is never reached
 	}
-	return _suppoints[ italpha - _cdf.begin() ];
+	return (_start + i) * _delta;
 }
 
 /*
  * convolution(dist) method: calculate the convolution between the distribution given as a parameter and the current one
  * mathematical definition on pdf: sum_h=0..t[p1(h)p2(t-h)], p1 and p2 being two pdf
  * mathematical definition on cdf: sum_h=0..t[F1(h)p2(t-h)], F1 being a cdf and p2 being a pdf
+ * the direct kernel is used for small windows, the FFT one as soon as both windows reach FFT_THRESHOLD points
  */
 Distribution Distribution::convolute(const Distribution& dist) const {
-//	TRACE("Convoluted: " << *this);
-//	TRACE("Convoluant: " << dist);
-	std::vector<double> pdf, cdf;
-	std::vector<uint32_t>::const_iterator itt = _suppoints.begin();
-	std::vector<double> convolutedPdf = dist.getPdf();
-	for(uint32_t t(0) ; t < getSize() ; ++t){
-		double probsumPdf(0), probsumCdf(0);
-		for(uint32_t tau(0) ; tau <= t ; ++tau){
-			probsumPdf += _pdf[tau] * dist.getPdfT(t-tau);
-			probsumCdf += _cdf[tau] * dist.getPdfT(t-tau);
+	if( std::min( _cdf.size() , dist._pdf.size() ) >= FFT_THRESHOLD ){
+		return convoluteFFT(dist);
+	}
+	return convoluteDirect(dist);
+}
+
+/*
+ * convolute(dist, const uint32_t&, bool&) method: bounded convolution, computed on the support points up to the given horizon index only
+ * the result cdf is exact up to the horizon, and the probability mass beyond it is reported on the next support point (hence the result
+ * dominates the exact convolution); truncated is set to true if the exact convolution has some support beyond the horizon
+ */
+Distribution Distribution::convolute(const Distribution& dist, const uint32_t& horizon, bool& truncated) const {
+	const uint32_t lo( _start + dist._start ), hi( std::min( getWindowEnd() + dist.getWindowEnd() - 2 , _size-1 ) );
+	truncated = horizon < hi;
+	if( !truncated ){
+		return convolute(dist);
+	}
+	if( lo > horizon ){
+		return Distribution(_size, _delta, horizon+1, std::vector<double>(1,1), std::vector<double>(1,1)); // Every realization is beyond the horizon
+	}
+	if( std::min( std::min( _cdf.size() , dist._pdf.size() ) , size_t(horizon-lo+1) ) >= FFT_THRESHOLD ){
+		return convoluteFFT(dist, horizon);
+	}
+	return convoluteDirect(dist, horizon);
+}
+
+/*
+ * convoluteDirect(dist, const uint32_t&) method: calculate the convolution with the quadratic direct kernel (exact summation, term by term)
+ * the sums are built support point by support point of the current distribution: each h adds p1(h)p2(t-h) and F1(h)p2(t-h) to the whole
+ * range of t where p2(t-h) is inside the dist window (and F1(h) is non-nul), so that every t still sums its terms in increasing h order
+ */
+Distribution Distribution::convoluteDirect(const Distribution& dist, const uint32_t& last) const {
+	const DistributionKernels& kernels( getKernels() );
+	const uint32_t lo1(_start), hi1(_start+_cdf.size()-1);
+	const uint32_t lo2(dist._start), hi2(dist._start+dist._pdf.size()-1);
+	const uint32_t lastIndex( std::min(last, _size-1) );
+	const double tail1(_cdf.back());
+	assert( lastIndex == _size-1 || lo1+lo2 <= lastIndex );
+	Distribution result;
+	result._size = _size;
+	result._delta = _delta;
+	result._start = std::min(lo1+lo2, _size-1);
+	const uint32_t hi( std::max( result._start , std::min(hi1+hi2, lastIndex) ) );
+	result._pdf.assign(hi-result._start+1, 0);
+	result._cdf.assign(hi-result._start+1, 0);
+	for(uint32_t tau(lo1) ; tau+lo2 <= hi ; ++tau){
+		const uint32_t tmin( tau+lo2 ), tmax( std::min(tau+hi2, hi) );
+		if(tau <= hi1){
+			kernels.axpy2( &result._pdf[tmin-result._start] , &result._cdf[tmin-result._start] , &dist._pdf[0] , _pdf[tau-lo1] , _cdf[tau-lo1] , tmax-tmin+1 );
 		}
-		pdf.push_back(probsumPdf);
-		cdf.push_back(probsumCdf);
+		else{
+			kernels.axpy( &result._cdf[tmin-result._start] , &dist._pdf[0] , tail1 , tmax-tmin+1 );
+		}
+	}
+	result.completeTail( (lastIndex < _size-1) ? lastIndex+1 : _size-1 );
+	return result;
+}
+
+/*
+ * convoluteFFT(dist) method: calculate the convolution with fast Fourier transforms, in O(n.log(n)) operations
+ * pdf and cdf products are packed as the real and imaginary parts of a single complex sequence, so that only three transforms are needed;
+ * beyond the current window F1 is constant, hence the remaining cdf terms reduce to F1(max).F2(t-max-1);
+ * only the first nbPts values of each operand window contribute to the kept result points, hence the operands are cut to this length
+ */
+Distribution Distribution::convoluteFFT(const Distribution& dist, const uint32_t& last) const {
+	const uint32_t lo1(_start), hi1(_start+_cdf.size()-1), lo2(dist._start);
+	const uint32_t lastIndex( std::min(last, _size-1) );
+	if( lo1+lo2 >= lastIndex ){
+		return convoluteDirect(dist, last);
+	}
+	Distribution result;
+	result._size = _size;
+	result._delta = _delta;
+	result._start = lo1+lo2;
+	const uint32_t nbPts( std::min( uint32_t(_cdf.size()+dist._pdf.size()-1) , lastIndex+1-result._start ) );
+	const uint32_t len1( std::min( uint32_t(_cdf.size()) , nbPts ) ), len2( std::min( uint32_t(dist._pdf.size()) , nbPts ) );
+	const uint32_t n( fftSize( len1+len2-1 ) );
+	static thread_local std::vector< std::complex<double> > a, b; // Scratch sequences, kept per thread to avoid allocations
+	a.assign(n, std::complex<double>());
+	b.assign(n, std::complex<double>());
+	for(uint32_t k(0) ; k < len1 ; ++k){
+		a[k] = std::complex<double>( _pdf[k] , _cdf[k] );
 	}
-	if( !eq( cdf.back() , 1.0 ) ){
-//		TRACEF(Distribution(_suppoints,pdf,cdf) << "\nCDF COMPLETION: " << "[" << pdf.back() << "-" << cdf.back() << "] --> <" << cdf[ getSize()-1 ] << "/" << cdf[ getSize()-2 ] << ">");
-		cdf.back() = 1.0;
-		pdf.back() = cdf.back() - cdf[ getSize()-2 ];
-//		CONTINUE_STATUS(" [" << pdf.back() << "-" << cdf.back() << "]\n" << Distribution(_suppoints,pdf,cdf));
+	std::copy(dist._pdf.begin(), dist._pdf.begin()+len2, b.begin());
+	fft(a);
+	fft(b);
+	for(uint32_t k(0) ; k < n ; ++k){
+		a[k] = complexProduct( a[k] , b[k] );
 	}
-	if( !eq(cdf.back(),1.0) ){
-		TRACE("Convolution result: " << Distribution(_suppoints,pdf,cdf));
+	fft(a, true);
+	result._pdf.resize(nbPts);
+	result._cdf.resize(nbPts);
+	for(uint32_t k(0) ; k < nbPts ; ++k){
+		const uint32_t t( result._start + k );
+		double cdfTail( (t > hi1+lo2) ? _cdf.back() * dist.cdfAt( t-hi1-1 ) : 0.0 );
+		// Negative values can only be rounding errors of the transforms
+		result._pdf[k] = std::max( a[k].real() , 0.0 );
+		result._cdf[k] = std::max( a[k].imag() + cdfTail , 0.0 );
 	}
-	assert( eq(cdf.back(),1.0) ); // Catch cases where convoluted distribution can be out of the period definition
-	return Distribution(_suppoints,pdf,cdf);
+	result.completeTail( (lastIndex < _size-1) ? lastIndex+1 : _size-1 );
+	return result;
 }
 
 /*
@@ -300,7 +542,7 @@ Distribution Distribution::convolute(const Distribution& dist) const {
  * aggregate distribution is such that for all t, F(t) = max{F1(t),F2(t)}, F being the agregated cdf, F1 and F2 being the input cdf
  */
 double Distribution::aggregate(const uint32_t& index, const double& candidateValue){
-	double bestValue( _cdf[index] );
+	double bestValue( cdfAt(index) );
 	if( lt(bestValue,candidateValue) ){
 		return candidateValue;
 	}
@@ -310,16 +552,23 @@ double Distribution::aggregate(const uint32_t& index, const double& candidateVal
 /*
  * aggregate(const Distribution&) method: modify current distribution to get the aggregated distribution between it and the given one
  * aggregate distribution is such that for all t, F(t) = max{F1(t),F2(t)}, F being the agregated cdf, F1 and F2 being the input cdf
+ * outside the union of both windows, the aggregated cdf keeps the implicit values (0 before, max of the last values after)
  */
 Distribution Distribution::aggregate(const Distribution& dist){
-	std::vector<double> pdf, cdf;
-	setCdfT( 0 , std::max(_cdf[0],dist.getCdfI(0)) );
-	setPdfT( 0 , getCdfI(0) );
-	std::vector<double>::iterator itf1, itf2;
-	for(itf1=_cdf.begin()+1 ; itf1 < _cdf.end() ; ++itf1){
-		setCdfT( itf1 - _cdf.begin() , std::max( _cdf[itf1 - _cdf.begin()] , dist.getCdfI(itf1 - _cdf.begin()) ) );
-		setPdfT( itf1 - _cdf.begin() , getCdfI(itf1 - _cdf.begin()) - getCdfI(itf1 - _cdf.begin() - 1) );
+	const DistributionKernels& kernels( getKernels() );
+	const uint32_t lo( std::min( _start , dist._start ) );
+	const uint32_t hi( std::min( std::max( getWindowEnd() , dist.getWindowEnd() ) , _size ) - 1 );
+	extendWindow(lo);
+	extendWindow(hi);
+	for(uint32_t t(lo) ; t <= hi ; ){
+		const uint32_t tnext( std::min( dist.nextBreakpoint(t) , hi+1 ) );
+		size_t stride(0);
+		const double* distCdf( dist.cdfPointer(t, stride) );
+		kernels.maximum( &_cdf[t-_start] , distCdf , stride , tnext-t );
+		t = tnext;
 	}
+	kernels.difference( &_pdf[0] , &_cdf[0] , 0.0 , _cdf.size() );
+	trim();
 	return *this;
 }
 
@@ -327,25 +576,22 @@ Distribution Distribution::aggregate(const Distribution& dist){
  * dominates(dist) method: return true if current distribution cdf dominates dist cdf, for each support points (ie F1(t)<=F2(t) forall t in [0,Tmax], and at least one t such that F1(t)<F2(t) )
  * corresponds to the first-order stochastic dominance (see Miller-Hooks & Mahmassani, 2003)
  */
-bool Distribution::dominates(const Distribution& dist){
+bool Distribution::dominates(const Distribution& dist) const{
 	// By default, consider than current distribution do not dominate the candidate
 	bool response = false;
-	std::vector<double>::iterator italt = dist.getCdf().begin();
-	// Comparison over all cdf values
-	for(auto &it: _cdf){
+	// Comparison over all cdf values, up to the first index that decides
+	const uint32_t last( dominanceLastIndex(dist) );
+	const uint32_t t( dominanceEvent(dist, last, response) );
+	if( t <= last ){
+		const double cur( cdfAt(t) ), alt( dist.cdfAt(t) );
 		// If there is an index for which candidate cdf is strictly larger than current cdf, candidate is not dominated
-		if( !le(*italt,it) ){
+		if( !le(alt,cur) ){
 			return false;
 		}
-		// If there is an index such that current cdf is strictly larger than the candidate cdf, the former can dominate the latter (equality case management)
-		if( !le(it,*italt) ){
-			response = true;
-		}
 		// If both cdf are equal to 1, the algorithm can stop, we consider that the candidate is dominated (there is no index for which candidate cdf is larger)
-		if( eq(it,1) && eq(*italt,1)){
-			return response;
+		if( !le(cur,alt) ){
+			response = true;
 		}
-		++italt;
 	}
 	// End of cdf checking, there is no index such that candidate cdf is larger than current cdf: the candidate distribution is dominated
 	return response;
@@ -355,37 +601,214 @@ bool Distribution::dominates(const Distribution& dist){
  * isLargerThan(dist) method: return true if current distribution cdf is larger than dist cdf, for each support points (ie F1(t)<=F2(t) forall t in [0,Tmax]), false otherwise
  * based on dominates(dist) method, with a different equality case management
  */
-bool Distribution::isLargerThan(const Distribution& dist){
-	std::vector<double>::iterator italt = dist.getCdf().begin();
-	// Comparison over all cdf values
-	for(auto &it: _cdf){
-		// If there is an index for which candidate cdf is strictly larger than current cdf, candidate is not dominated
-		if( !le(*italt,it) ){
-			return false;
-		}
-		// If both cdf are equal to 1, the algorithm can stop, we consider that the candidate is dominated (there is no index for which candidate cdf is larger)
-		if( eq(it,1) && eq(*italt,1)){
-			return true;
+bool Distribution::isLargerThan(const Distribution& dist) const{
+	bool larger(false);
+	const uint32_t last( dominanceLastIndex(dist) );
+	const uint32_t t( dominanceEvent(dist, last, larger) );
+	// If there is an index for which candidate cdf is strictly larger than current cdf, candidate is not dominated
+	// (otherwise both cdf are equal to 1, or the cdf checking is over: the candidate distribution is dominated)
+	return !( t <= last && !le( dist.cdfAt(t) , cdfAt(t) ) );
+}
+
+/*
+ * cdfAt(uint32_t) method: return the cdf value at a given index, including the implicit values outside the stored window
+ */
+double Distribution::cdfAt(const uint32_t& index) const{
+	if(index < _start){
+		return 0;
+	}
+	return (index - _start < _cdf.size()) ? _cdf[index - _start] : _cdf.back();
+}
+
+/*
+ * pdfAt(uint32_t) method: return the pdf value at a given index, including the implicit values outside the stored window
+ */
+double Distribution::pdfAt(const uint32_t& index) const{
+	if(index < _start){
+		return 0;
+	}
+	return (index - _start < _pdf.size()) ? _pdf[index - _start] : 0;
+}
+
+/*
+ * cdfPointer(const uint32_t&, size_t&) method: return a pointer to the cdf value at a given index, and the stride to use to read the following ones
+ * (1 inside the stored window, 0 outside, where the cdf is constant until the next breakpoint)
+ */
+const double* Distribution::cdfPointer(const uint32_t& index, size_t& stride) const{
+	static const double zero(0);
+	if(index < _start){
+		stride = 0;
+		return &zero;
+	}
+	if(index < getWindowEnd()){
+		stride = 1;
+		return &_cdf[index - _start];
+	}
+	stride = 0;
+	return &_cdf.back();
+}
+
+/*
+ * nextBreakpoint(const uint32_t&) method: return the first index after the given one where the cdf storage changes (window beginning or end)
+ */
+uint32_t Distribution::nextBreakpoint(const uint32_t& index) const{
+	if(index < _start){
+		return _start;
+	}
+	if(index < getWindowEnd()){
+		return getWindowEnd();
+	}
+	return std::numeric_limits<uint32_t>::max();
+}
+
+/*
+ * dominanceLastIndex(dist) method: return the last index to check when comparing both cdf
+ * both cdf are null before the windows and constant after them, hence the comparison stops one point after the union of both windows
+ */
+uint32_t Distribution::dominanceLastIndex(const Distribution& dist) const{
+	return std::min( std::max( getWindowEnd() , dist.getWindowEnd() ) , _size-1 );
+}
+
+/*
+ * dominanceEvent(dist, const uint32_t&, bool&) method: return the first index up to last where dist cdf is larger than the current one,
+ * or where both cdf are equal to 1 (last+1 if there is none); larger is set to true if the current cdf is larger at a previous index
+ */
+uint32_t Distribution::dominanceEvent(const Distribution& dist, const uint32_t& last, bool& larger) const{
+	const DistributionKernels& kernels( getKernels() );
+	for(uint32_t t( std::min( _start , dist._start ) ) ; t <= last ; ){
+		const uint32_t tnext( std::min( std::min( nextBreakpoint(t) , dist.nextBreakpoint(t) ) , last+1 ) );
+		size_t curStride(0), altStride(0);
+		const double* cur( cdfPointer(t, curStride) );
+		const double* alt( dist.cdfPointer(t, altStride) );
+		const size_t event( kernels.dominanceScan(cur, curStride, alt, altStride, tnext-t, larger) );
+		if( event < tnext-t ){
+			return t + event;
 		}
-		++italt;
+		t = tnext;
 	}
-	// End of cdf checking, there is no index such that candidate cdf is larger than current cdf: the candidate distribution is dominated
-	return true;
+	return last+1;
+}
+
+/*
+ * extendWindow(uint32_t) method: grow the stored window so as it contains the given index (the implicit values are made explicit)
+ */
+void Distribution::extendWindow(const uint32_t& index){
+	if(index < _start){
+		_pdf.insert(_pdf.begin(), _start-index, 0);
+		_cdf.insert(_cdf.begin(), _start-index, 0);
+		_start = index;
+	}
+	else if(index >= getWindowEnd()){
+		const uint32_t nbNewPoints( index - getWindowEnd() + 1 );
+		_pdf.insert(_pdf.end(), nbNewPoints, 0);
+		_cdf.insert(_cdf.end(), nbNewPoints, _cdf.back());
+	}
+}
+
+/*
+ * completeTail(const uint32_t&) method: force the cdf value to 1 from the given index (the remaining probability is reported on this support point) and trim the window
+ * used by convolution kernels, as the convoluted distribution can be partly out of the period definition (or beyond the convolution horizon)
+ * the stored window must not go beyond the given index
+ */
+void Distribution::completeTail(const uint32_t& tail){
+	assert( getWindowEnd() <= tail+1 );
+	if( !eq( _cdf.back() , 1.0 ) ){
+		extendWindow(tail);
+		_cdf.back() = 1.0;
+		_pdf.back() = _cdf.back() - ( (tail > 0) ? cdfAt( tail-1 ) : 0.0 );
+	}
+	if( !eq(_cdf.back(),1.0) ){
+		TRACE("Convolution result: " << *this);
+	}
+	assert( eq(_cdf.back(),1.0) ); // Catch cases where convoluted distribution can be out of the period definition
+	trim();
+}
+
+/*
+ * trim() method: shrink the stored window by removing the leading and trailing points that carry the implicit values
+ * (exact comparisons, so that trimming never modifies the distribution)
+ */
+void Distribution::trim(){
+	if(_cdf.empty()){
+		computeSummary();
+		return;
+	}
+	uint32_t first(0), last(_cdf.size()-1);
+	while( first < last && _pdf[first] == 0 && _cdf[first] == 0 ){
+		++first;
+	}
+	while( last > first && _pdf[last] == 0 && _cdf[last] == _cdf[last-1] ){
+		--last;
+	}
+	if( last+1 < _cdf.size() ){
+		_pdf.erase(_pdf.begin()+last+1, _pdf.end());
+		_cdf.erase(_cdf.begin()+last+1, _cdf.end());
+	}
+	if( first > 0 ){
+		_pdf.erase(_pdf.begin(), _pdf.begin()+first);
+		_cdf.erase(_cdf.begin(), _cdf.begin()+first);
+		_start += first;
+	}
+	computeSummary();
+}
+
+/*
+ * summarize(uint32_t&, uint32_t&, double&) method: compute the min and max indexes and the esperance from the stored window
+ * min is the first index with a non-null cdf, max the first one with a cdf equal to 1 (the last support point if there is none)
+ */
+void Distribution::summarize(uint32_t& minIndex, uint32_t& maxIndex, double& esperance) const{
+	std::vector<double>::const_iterator itcdfmin = std::find_if(_cdf.begin(), _cdf.end(), [](const double& value) { return gt(value,0); });
+	std::vector<double>::const_iterator itcdfmax = std::find_if(itcdfmin, _cdf.end(), [](const double& value) { return eq(value,1); });
+	minIndex = (itcdfmin == _cdf.end()) ? _size-1 : _start + (itcdfmin - _cdf.begin());
+	maxIndex = (itcdfmax == _cdf.end()) ? _size-1 : _start + (itcdfmax - _cdf.begin());
+	esperance = 0.0;
+	for(uint32_t i(0) ; i < _pdf.size() ; ++i){
+		esperance += ( (_start+i) * _delta ) * _pdf[i];
+	}
+}
+
+/*
+ * computeSummary() method: store the summary of the stored window (see summarize())
+ */
+void Distribution::computeSummary(){
+	summarize(_minIndex, _maxIndex, _esperance);
+	_summaryValid = true;
+}
+
+/*
+ * hash() method: return a hash value of the distribution (support definition and stored probabilities)
+ */
+size_t Distribution::hash() const{
+	size_t seed(0);
+	boost::hash_combine(seed, _size);
+	boost::hash_combine(seed, _delta);
+	boost::hash_combine(seed, _start);
+	boost::hash_range(seed, _cdf.begin(), _cdf.end());
+	boost::hash_range(seed, _pdf.begin(), _pdf.end());
+	return seed;
+}
+
+/*
+ * == operator: return true if both distributions have the same support and exactly the same probabilities
+ */
+bool Distribution::operator==(const Distribution& dist) const{
+	return _size == dist._size && _delta == dist._delta && _start == dist._start && _cdf == dist._cdf && _pdf == dist._pdf;
 }
 
 /*
  * << operator: return an outstream version of the distribution (printing purpose)
  */
 std::ostream& operator<<(std::ostream& os, const Distribution& dist){
-	std::vector<uint32_t> sup = dist._suppoints;
-	std::vector<double> prob = dist._pdf;
-	std::vector<double> cum = dist._cdf;
-	std::vector<uint32_t>::iterator itt = sup.begin();
-	std::vector<double>::iterator itm = prob.begin();
-	std::vector<double>::iterator itf = cum.begin();
-	for( ; itt < sup.end() ; ++itt,++itm,++itf ){
-		os << "(" << *itt << ";" << *itm << ";" << *itf << ") ";
+	for(uint32_t t(0) ; t < dist._size ; ++t){
+		os << "(" << dist.getSupT(t) << ";" << dist.pdfAt(t) << ";" << dist.cdfAt(t) << ") ";
 	}
 	return os;
 }
 
+
+/*
+ * getMemorySize() method: return the memory allocated for the stored window, in bytes
+ */
+size_t Distribution::getMemorySize() const {
+	return MemoryFootprint::bytes(_cdf) + MemoryFootprint::bytes(_pdf);
+}
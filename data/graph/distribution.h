@@ -9,19 +9,27 @@
 #define DATA_DISTRIBUTION_H_
 
 #include <algorithm> // Command transform, max
+#include <boost/functional/hash.hpp>
 #include <cstdlib>
 #include <functional>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <numeric>      // std::partial_sum, std::inner_product
 #include <vector>
 
 #include "../../misc.h"
+#include "distributionarena.h"
+#include "fft.h"
 
 /*
  * class Distribution: describe a cumulative distribution function, ie the probability of taking a value smaller than one x, x given
  * Let note F(.) such a function. By definition, lim[-inf]F(.)=0 ; lim[+inf]F(.)=1 ; F(.) is increasing.
  * Here the cdf are supposed as constant-by-step functions (as we consider only discretized variables).
+ * Support points are the multiples of a constant step delta, t_i = i*delta for i in [0,size). Only the window [begin,end) of indexes
+ * where the distribution is non-trivial is stored: before it pdf and cdf are 0, after it pdf is 0 and cdf keeps its last stored value
+ * (ie 1 for a complete distribution).
+ * Probability buffers come from the arena installed for the current thread, if any (see DistributionArena), and go back to it at destruction.
  */
 class Distribution{
 public:
@@ -33,7 +41,16 @@ public:
 	Distribution(const int& size, const int& delta);
 	Distribution(const int& size, const int& delta, const bool& infinite);
 	Distribution(const std::vector<uint32_t>& x, const std::vector<double>& p, const std::vector<double>& u);
+	Distribution(const uint32_t& size, const uint32_t& delta, const uint32_t& start, const std::vector<double>& p, const std::vector<double>& u, const bool& trimmed=true);
 	Distribution(const std::string& filename);
+	Distribution(const Distribution& dist);
+	Distribution(Distribution&& dist) = default;
+
+	/*
+	 * Assignment operators
+	 */
+	Distribution& operator=(const Distribution& dist);
+	Distribution& operator=(Distribution&& dist);
 
 	/*
 	 * Destructor
@@ -53,10 +70,8 @@ public:
 	/*
 	 * Setters
 	 */
-	void setSup(std::vector<uint32_t> newSup);
 	void setPdf(std::vector<double> newPdf);
 	void setCdf(std::vector<double> newCdf);
-	void setSupT(uint32_t index, uint32_t newValue);
 	void setPdfT(uint32_t index, double newValue);
 	void setCdfT(uint32_t index, double newValue);
 
@@ -76,6 +91,12 @@ public:
 	 */
 	void makeInfinite();
 
+	/*
+	 * updateSummary() method: recompute the cached summary (min, max, esperance) after element-wise modifications (setPdfT, setCdfT)
+	 * until then, summary queries scan the stored window (they never modify the distribution, which can be read by several threads)
+	 */
+	void updateSummary();
+
 	/*
 	 * getSize() method: return the number of support points
 	 */
@@ -86,6 +107,16 @@ public:
 	 */
 	uint32_t getDelta() const;
 
+	/*
+	 * getWindowBegin() method: return the index of the first stored support point (pdf and cdf are 0 before it)
+	 */
+	uint32_t getWindowBegin() const;
+
+	/*
+	 * getWindowEnd() method: return the index following the last stored support point (pdf is 0 and cdf is constant after it)
+	 */
+	uint32_t getWindowEnd() const;
+
 	/*
 	 * getSupI(uint32_t) method: return the i^th support point
 	 */
@@ -112,23 +143,23 @@ public:
 	double Pdf(uint32_t t) const;
 
 	/*
-	 * min() method: return the minimum possible realization
+	 * min() method: return the minimum possible realization (cached, O(1) if the summary is up-to-date)
 	 */
 	uint32_t min() const;
 
 	/*
-	 * max() method: return the maximum possible realization
+	 * max() method: return the maximum possible realization (cached, O(1) if the summary is up-to-date)
 	 */
 	uint32_t max() const;
 
 	/*
-	 * range() method: return the definition range of the distribution, namely max()-min()
+	 * range() method: return the definition range of the distribution, namely max()-min() (cached, O(1) if the summary is up-to-date)
 	 */
 	uint32_t range() const;
 
 	/*
 	 * esp() method: return the esperance of the distribution
-	 * E(T) = sum_t=0->Tmax_{t*p(t)}
+	 * E(T) = sum_t=0->Tmax_{t*p(t)} (cached, O(1) if the summary is up-to-date)
 	 */
 	double esp() const;
 	/*
@@ -144,6 +175,27 @@ public:
 	 */
 	Distribution convolute(const Distribution& dist) const;
 
+	/*
+	 * convolute(dist, const uint32_t&, bool&) method: bounded convolution, computed on the support points up to the given horizon index only
+	 * the result cdf is exact up to the horizon, and the probability mass beyond it is reported on the next support point (hence the result
+	 * dominates the exact convolution); truncated is set to true if the exact convolution has some support beyond the horizon
+	 * to be used when the values after the horizon can not change the caller decisions (eg when the result is aggregated with a cdf equal to 1 there)
+	 */
+	Distribution convolute(const Distribution& dist, const uint32_t& horizon, bool& truncated) const;
+
+	/*
+	 * convoluteDirect(dist, const uint32_t&) method: calculate the convolution with the quadratic direct kernel (exact summation, term by term)
+	 * the cdf is computed up to the <last> index only (the remaining probability is reported on the next support point)
+	 */
+	Distribution convoluteDirect(const Distribution& dist, const uint32_t& last = std::numeric_limits<uint32_t>::max()) const;
+
+	/*
+	 * convoluteFFT(dist, const uint32_t&) method: calculate the convolution with fast Fourier transforms, in O(n.log(n)) operations
+	 * results are equal to the direct kernel ones up to the floating-point rounding of the transforms (around 1e-15)
+	 * the cdf is computed up to the <last> index only (the remaining probability is reported on the next support point)
+	 */
+	Distribution convoluteFFT(const Distribution& dist, const uint32_t& last = std::numeric_limits<uint32_t>::max()) const;
+
 	/*
 	 * aggregate(const uint32_t&, const double&) method: return the maximum value between a candidate double and the cdf value located at a given index
 	 * aggregate distribution is such that for all t, F(t) = max{F1(t),F2(t)}, F being the agregated cdf, F1 and F2 being the input cdf
@@ -160,26 +212,106 @@ public:
 	 * dominates(dist) method: return true if current distribution cdf dominates dist cdf, for each support points (ie F1(t)<=F2(t) forall t in [0,Tmax], and at least one t such that F1(t)<F2(t) )
 	 * corresponds to the first-order stochastic dominance (see Miller-Hooks & Mahmassani, 2003)
 	 */
-	bool dominates(const Distribution& dist);
+	bool dominates(const Distribution& dist) const;
 
 	/*
 	 * isLargerThan(dist) method: return true if current distribution cdf is larger than dist cdf, for each support points (ie F1(t)<=F2(t) forall t in [0,Tmax]), false otherwise
 	 * based on dominates(dist) method, with a different equality case management
 	 */
-	bool isLargerThan(const Distribution& dist);
+	bool isLargerThan(const Distribution& dist) const;
+
+	/*
+	 * hash() method: return a hash value of the distribution (support definition and stored probabilities)
+	 */
+	size_t hash() const;
+
+	/*
+	 * == operator: return true if both distributions have the same support and exactly the same probabilities
+	 */
+	bool operator==(const Distribution& dist) const;
 
 	/*
 	 * << operator: return an outstream version of the distribution (printing purpose)
 	 */
 	friend std::ostream& operator<<(std::ostream& os, const Distribution& dist);
 
+	static constexpr uint32_t FFT_THRESHOLD = 1024; // Minimal window size of both operands from which convolution is done by FFT (crossover measured by the convolution benchmark, between 609 and 1369 points)
+
+	/*
+	 * getMemorySize() method: return the memory allocated for the stored window, in bytes
+	 */
+	size_t getMemorySize() const;
+
 private:
+	/*
+	 * cdfAt(uint32_t) method: return the cdf value at a given index, including the implicit values outside the stored window
+	 */
+	double cdfAt(const uint32_t& index) const;
+
+	/*
+	 * pdfAt(uint32_t) method: return the pdf value at a given index, including the implicit values outside the stored window
+	 */
+	double pdfAt(const uint32_t& index) const;
+
+	/*
+	 * cdfPointer(const uint32_t&, size_t&) method: return a pointer to the cdf value at a given index, and the stride to use to read the following ones
+	 */
+	const double* cdfPointer(const uint32_t& index, size_t& stride) const;
+
+	/*
+	 * nextBreakpoint(const uint32_t&) method: return the first index after the given one where the cdf storage changes (window beginning or end)
+	 */
+	uint32_t nextBreakpoint(const uint32_t& index) const;
+
+	/*
+	 * dominanceLastIndex(dist) method: return the last index to check when comparing both cdf
+	 */
+	uint32_t dominanceLastIndex(const Distribution& dist) const;
+
+	/*
+	 * dominanceEvent(dist, const uint32_t&, bool&) method: return the first index up to last where dist cdf is larger than the current one,
+	 * or where both cdf are equal to 1 (last+1 if there is none); larger is set to true if the current cdf is larger at a previous index
+	 */
+	uint32_t dominanceEvent(const Distribution& dist, const uint32_t& last, bool& larger) const;
+
+	/*
+	 * extendWindow(uint32_t) method: grow the stored window so as it contains the given index (the implicit values are made explicit)
+	 */
+	void extendWindow(const uint32_t& index);
+
+	/*
+	 * completeTail(const uint32_t&) method: force the cdf value to 1 from the given index (the remaining probability is reported on this support point) and trim the window
+	 * used by convolution kernels, as the convoluted distribution can be partly out of the period definition (or beyond the convolution horizon)
+	 */
+	void completeTail(const uint32_t& tail);
+
+	/*
+	 * trim() method: shrink the stored window by removing the leading and trailing points that carry the implicit values
+	 */
+	void trim();
+
+	/*
+	 * summarize(uint32_t&, uint32_t&, double&) method: compute the min and max indexes and the esperance from the stored window
+	 */
+	void summarize(uint32_t& minIndex, uint32_t& maxIndex, double& esperance) const;
+
+	/*
+	 * computeSummary() method: store the summary of the stored window (see summarize())
+	 */
+	void computeSummary();
+
 	/*
 	 * Attributes
 	 */
-	std::vector<uint32_t> _suppoints; // Support points of the discretized statistical distribution
-	std::vector<double> _cdf; // Cumulative distribution function
-	std::vector<double> _pdf; // Probability density function (actually a mass function, as the distribution is discretized)
+	uint32_t _size; // Number of support points of the discretized statistical distribution
+	uint32_t _delta; // Difference between two consecutive support points
+	uint32_t _start; // Index of the first stored support point
+	std::vector<double> _cdf; // Cumulative distribution function (stored window only)
+	std::vector<double> _pdf; // Probability density function (actually a mass function, as the distribution is discretized), stored window only
+	bool _summaryValid; // True if the cached summary below corresponds to the current probabilities
+	uint32_t _minIndex; // Index of the minimum possible realization
+	uint32_t _maxIndex; // Index of the maximum possible realization
+	double _esperance; // Esperance of the distribution
 };
 
 #endif /* DATA_DISTRIBUTION_H_ */
@@ -0,0 +1,89 @@
+/*
+ * distributionarena.cpp
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#include "distributionarena.h"
+#include "memoryfootprint.h"
+
+#include <algorithm> // Command max
+
+thread_local DistributionArena* DistributionArena::_current = NULL;
+
+/*
+ * Constructors
+ */
+DistributionArena::DistributionArena(): _bufferSize(1), _nbRequests(0), _nbAllocations(0){}
+DistributionArena::DistributionArena(const uint32_t& bufferSize): _bufferSize(bufferSize), _nbRequests(0), _nbAllocations(0){
+	_freeBuffers.reserve(MAX_FREE_BUFFERS);
+}
+
+/*
+ * Getters
+ */
+uint32_t DistributionArena::getBufferSize() const { return _bufferSize; }
+uint64_t DistributionArena::getNbRequests() const { return _nbRequests; }
+uint64_t DistributionArena::getNbAllocations() const { return _nbAllocations; }
+
+/*
+ * acquire(std::vector<double>&, const size_t&, const double&) method: set the (empty) given vector as a buffer of <length> values equal to <value>,
+ * taken from the free buffers if possible
+ * a request larger than the buffer size gets a dedicated buffer, that is counted as an allocation
+ */
+void DistributionArena::acquire(std::vector<double>& buffer, const size_t& length, const double& value){
+	++_nbRequests;
+	if( length <= _bufferSize && !_freeBuffers.empty() ){
+		buffer.swap( _freeBuffers.back() );
+		_freeBuffers.pop_back();
+	}
+	else{
+		++_nbAllocations;
+		buffer.reserve( std::max( length , size_t(_bufferSize) ) );
+	}
+	buffer.assign(length, value);
+}
+
+/*
+ * release(std::vector<double>&) method: give back the buffer of the given vector to the arena (the vector is left empty)
+ * only full-size buffers are kept, the other ones (and the ones beyond MAX_FREE_BUFFERS) are freed
+ */
+void DistributionArena::release(std::vector<double>& buffer){
+	if( buffer.capacity() >= _bufferSize && _freeBuffers.size() < MAX_FREE_BUFFERS ){
+		_freeBuffers.push_back( std::move(buffer) );
+	}
+	std::vector<double>().swap(buffer);
+}
+
+/*
+ * reset() method: free all the buffers kept by the arena and reset the counters
+ */
+void DistributionArena::reset(){
+	_freeBuffers.clear();
+	_nbRequests = 0;
+	_nbAllocations = 0;
+}
+
+/*
+ * current() method: return the arena installed for the current thread, NULL if there is none
+ */
+DistributionArena* DistributionArena::current(){ return _current; }
+
+/*
+ * Scope constructor and destructor: install the given arena for the current thread, restore the previous one at the end of the scope
+ */
+DistributionArena::Scope::Scope(): _previous(_current){ _current = NULL; }
+DistributionArena::Scope::Scope(DistributionArena& arena): _previous(_current){ _current = &arena; }
+DistributionArena::Scope::~Scope(){ _current = _previous; }
+
+/*
+ * getMemorySize() method: return the memory held by the free buffers of the arena, in bytes
+ */
+size_t DistributionArena::getMemorySize() const {
+	size_t bytes( MemoryFootprint::bytes(_freeBuffers) );
+	for(const auto& buffer: _freeBuffers){
+		bytes += MemoryFootprint::bytes(buffer);
+	}
+	return bytes;
+}
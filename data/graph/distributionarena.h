@@ -0,0 +1,93 @@
+/*
+ * distributionarena.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_GRAPH_DISTRIBUTIONARENA_H_
+#define DATA_GRAPH_DISTRIBUTIONARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * class DistributionArena: per-thread pool of probability buffers, used by Distribution to avoid heap allocations in search loops
+ * Buffers are reserved for a whole distribution of the instance (nbPts+1 values): once released (when a Distribution is destroyed or
+ * overwritten), a buffer is kept in the arena and handed out again at the next request, so that in steady state convolutions, aggregations
+ * and copies do not allocate anymore. The arena used by a thread is the one installed by the innermost Scope object (none by default,
+ * in which case Distribution uses the standard allocator). An arena must only be used by one thread at a time.
+ * Arena buffers are meant for temporaries: a distribution kept in a long-lived structure (stored weight, cached convolution, query label)
+ * is built or copied under a default Scope, so that its heap buffers fit its window instead of the whole nbPts+1 values.
+ */
+class DistributionArena{
+public:
+	/*
+	 * Constructors
+	 */
+	DistributionArena();
+	DistributionArena(const uint32_t& bufferSize);
+
+	/*
+	 * Getters
+	 */
+	uint32_t getBufferSize() const;
+	uint64_t getNbRequests() const;
+	uint64_t getNbAllocations() const;
+
+	/*
+	 * acquire(std::vector<double>&, const size_t&, const double&) method: set the (empty) given vector as a buffer of <length> values equal to <value>,
+	 * taken from the free buffers if possible
+	 */
+	void acquire(std::vector<double>& buffer, const size_t& length, const double& value);
+
+	/*
+	 * release(std::vector<double>&) method: give back the buffer of the given vector to the arena (the vector is left empty)
+	 */
+	void release(std::vector<double>& buffer);
+
+	/*
+	 * reset() method: free all the buffers kept by the arena and reset the counters
+	 */
+	void reset();
+
+	/*
+	 * current() method: return the arena installed for the current thread, NULL if there is none
+	 */
+	static DistributionArena* current();
+
+	/*
+	 * class Scope: install an arena for the current thread, until the end of the scope (the previous arena is then restored)
+	 * the default constructor installs no arena, for distributions that must not take their buffers from the current one
+	 */
+	class Scope{
+	public:
+		Scope();
+		Scope(DistributionArena& arena);
+		~Scope();
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	private:
+		DistributionArena* _previous;
+	};
+
+	static constexpr size_t MAX_FREE_BUFFERS = 1024; // Maximal number of free buffers kept by an arena (the following ones go back to the heap)
+
+	/*
+	 * getMemorySize() method: return the memory held by the free buffers of the arena, in bytes
+	 */
+	size_t getMemorySize() const;
+
+private:
+	/*
+	 * Attributes
+	 */
+	uint32_t _bufferSize; // Capacity of the buffers, in number of values
+	std::vector< std::vector<double> > _freeBuffers; // Released buffers, ready to be handed out again
+	uint64_t _nbRequests; // Number of buffer requests
+	uint64_t _nbAllocations; // Number of requests that could not be served without a heap allocation
+	static thread_local DistributionArena* _current; // Arena installed for the current thread
+};
+
+#endif /* DATA_GRAPH_DISTRIBUTIONARENA_H_ */
@@ -10,33 +10,22 @@
 /*
  * Constructors
  */
-Edge::Edge(): _forward(false),_backward(false), _origin(INVALID_NODE_ID),_destination(INVALID_NODE_ID), _symEdge(INVALID_EDGE_ID), _complexity(0), _nbOriginalEdge(1),_midnod(INVALID_NODE_ID){}
+Edge::Edge(): _forward(false),_backward(false), _origin(INVALID_NODE_ID),_destination(INVALID_NODE_ID), _symEdge(INVALID_EDGE_ID), _weight(WeightDictionary::DEFAULT_WEIGHT_ID), _complexity(0), _nbOriginalEdge(1),_midnod(INVALID_NODE_ID){}
 Edge::Edge(const bool& fw):
-						_forward(fw), _backward(!fw), _origin(INVALID_NODE_ID), _destination(INVALID_NODE_ID), _symEdge(INVALID_EDGE_ID), _complexity(0), _nbOriginalEdge(1),_midnod(INVALID_NODE_ID){}
+						_forward(fw), _backward(!fw), _origin(INVALID_NODE_ID), _destination(INVALID_NODE_ID), _symEdge(INVALID_EDGE_ID), _weight(WeightDictionary::DEFAULT_WEIGHT_ID), _complexity(0), _nbOriginalEdge(1),_midnod(INVALID_NODE_ID){}
 Edge::Edge(const bool& fw, const Node_id& src, const Node_id& dest):
-								_forward(fw), _backward(!fw), _origin(src), _destination(dest), _symEdge(INVALID_EDGE_ID), _complexity(0), _nbOriginalEdge(1), _midnod(INVALID_NODE_ID){}
+								_forward(fw), _backward(!fw), _origin(src), _destination(dest), _symEdge(INVALID_EDGE_ID), _weight(WeightDictionary::DEFAULT_WEIGHT_ID), _complexity(0), _nbOriginalEdge(1), _midnod(INVALID_NODE_ID){}
 Edge::Edge(const bool& fw, const Node_id& src, const Node_id& dest, Distribution& dist):
-								_forward(fw), _backward(!fw), _origin(src), _destination(dest), _symEdge(INVALID_EDGE_ID), _weight(dist),
+								_forward(fw), _backward(!fw), _origin(src), _destination(dest), _symEdge(INVALID_EDGE_ID), _weight( getWeightDictionary().intern(dist) ),
 								_complexity( dist.range() ), _nbOriginalEdge(1), _midnod(INVALID_NODE_ID){}
 Edge::Edge(const bool& fw, const Node_id& src, const Node_id& dest, Distribution& dist, const Node_id& midnod): _forward(fw),_backward(!fw), _origin(src),_destination(dest),
-		_symEdge(INVALID_EDGE_ID), _weight(dist), _complexity(dist.range()), _nbOriginalEdge(1), _midnod(midnod){}
-Edge::Edge(const bool& fw, const Node_id& src, const Node_id& dest, Distribution& dist, const uint32_t& complex, const uint32_t& origedge, const Node_id& midnod):
-						_forward(fw), _backward(!fw), _origin(src), _destination(dest), _symEdge(INVALID_EDGE_ID), _weight(dist), _complexity(complex), _nbOriginalEdge(origedge), _midnod(midnod){}
+		_symEdge(INVALID_EDGE_ID), _weight( getWeightDictionary().intern(dist) ), _complexity(dist.range()), _nbOriginalEdge(1), _midnod(midnod){}
+Edge::Edge(const bool& fw, const Node_id& src, const Node_id& dest, const Distribution& dist, const uint32_t& complex, const uint32_t& origedge, const Node_id& midnod):
+						_forward(fw), _backward(!fw), _origin(src), _destination(dest), _symEdge(INVALID_EDGE_ID), _weight( getWeightDictionary().intern(dist) ), _complexity(complex), _nbOriginalEdge(origedge), _midnod(midnod){}
 Edge::Edge(const bool& fw, const Node_id& src, const Node_id& dest, const Edge_id& e, Distribution& dist, const Node_id& midnod):
-						_forward(fw), _backward(!fw), _origin(src), _destination(dest), _symEdge(e), _weight(dist), _complexity( dist.range() ), _nbOriginalEdge(1), _midnod(midnod){}
+						_forward(fw), _backward(!fw), _origin(src), _destination(dest), _symEdge(e), _weight( getWeightDictionary().intern(dist) ), _complexity( dist.range() ), _nbOriginalEdge(1), _midnod(midnod){}
 Edge::Edge(const bool& fw, const Node_id& src, const Node_id& dest, const Edge_id& e, Distribution& dist):
-						_forward(fw), _backward(!fw), _origin(src), _destination(dest), _symEdge(e), _weight(dist), _complexity( dist.range() ), _nbOriginalEdge(1), _midnod(INVALID_NODE_ID){}
-Edge::Edge(const Edge& edge){
-	_forward = edge.getFW();
-	_backward = edge.getBW();
-	_origin = edge.getOrigin();
-	_destination = edge.getDestination();
-	_symEdge = edge.getSymEdge();
-	_weight = edge.getWeight();
-	_complexity = edge.getComplexity();
-	_nbOriginalEdge = edge.getNbOriginalEdge();
-	_midnod = edge.getMiddleNode();
-}
+						_forward(fw), _backward(!fw), _origin(src), _destination(dest), _symEdge(e), _weight( getWeightDictionary().intern(dist) ), _complexity( dist.range() ), _nbOriginalEdge(1), _midnod(INVALID_NODE_ID){}
 
 /*
  * Getters
@@ -47,22 +36,25 @@ Node_id Edge::getOrigin() const { return _origin; }
 Node_id Edge::getDestination() const { return _destination; }
 Edge_id Edge::getSymEdge() const { return _symEdge; }
 std::array<double,3> Edge::getWeightT(const uint32_t& t) const {
+	const EdgeWeight& dist( getWeightDictionary().get(_weight) );
 	std::array<double,3> weight;
-	weight[0] = _weight.getSupT(t) ;
-	weight[1] = _weight.getPdfT(t) ;
-	weight[2] = _weight.getCdfT(t) ;
+	weight[0] = dist.getSupT(t) ;
+	weight[1] = dist.getPdfT(t) ;
+	weight[2] = dist.getCdfT(t) ;
 	return weight;
 }
 std::array<double,3> Edge::getLastWeight() const{
+	const EdgeWeight& dist( getWeightDictionary().get(_weight) );
 	std::array<double,3> weight;
-	weight[0] = _weight.getSup().back() ;
-	weight[1] = _weight.getPdf().back() ;
-	weight[2] = _weight.getCdf().back() ;
+	weight[0] = dist.getSupT( dist.getSize()-1 ) ;
+	weight[1] = dist.getPdfT( dist.getSize()-1 ) ;
+	weight[2] = dist.getCdfT( dist.getSize()-1 ) ;
 	return weight;
 }
-Distribution Edge::getWeight() const { return _weight; }
-double Edge::getMinWeight() const { return _weight.min() ; }
-double Edge::getMaxWeight() const { return _weight.max() ; }
+WeightView Edge::getWeight() const { return getWeightDictionary().getDistribution(_weight); }
+Weight_id Edge::getWeightId() const { return _weight; }
+double Edge::getMinWeight() const { return getWeightDictionary().get(_weight).min() ; }
+double Edge::getMaxWeight() const { return getWeightDictionary().get(_weight).max() ; }
 uint32_t Edge::getComplexity() const { return _complexity; }
 uint32_t Edge::getNbOriginalEdge() const { return _nbOriginalEdge; }
 Node_id Edge::getMiddleNode() const { return _midnod; }
@@ -76,9 +68,11 @@ void Edge::setDirection(const bool& forward){ _forward = forward; _backward = !f
 void Edge::setOrigin(const Node_id& source) { _origin = source; }
 void Edge::setDestination(const Node_id& target) { _destination = target; }
 void Edge::setSymEdge(const Edge_id& e){ _symEdge = e; }
-void Edge::setWeight(Distribution&& dist) { _weight = std::move(dist); }
-void Edge::setWeight(const double c) { _weight = Distribution(c); }
+void Edge::setWeight(Distribution&& dist) { _weight = getWeightDictionary().intern(dist); }
+void Edge::setWeight(const double c) { _weight = getWeightDictionary().intern( Distribution(c) ); }
+void Edge::setWeightId(const Weight_id& weight) { _weight = weight; }
 void Edge::setComplexity(const uint32_t& c){ _complexity = c; }
+void Edge::setNbOriginalEdge(const uint32_t& n){ _nbOriginalEdge = n; }
 void Edge::setMiddleNode(const Node_id& midnod){ _midnod = midnod; }
 
 /*
@@ -88,23 +82,36 @@ void Edge::setMiddleNode(const Node_id& midnod){ _midnod = midnod; }
  */
 bool Edge::aggregate(const Edge& candidateEdge){
 	bool distImprovement(true);
-	for(uint32_t t(0) ; t < getWeight().getSize() ; ++t){
-		double candidateCdfValue( candidateEdge.getWeightT(t)[2] );
-		if( lt( _weight.getCdfT(t) , candidateCdfValue ) ){
-			_weight.setCdfT( t , candidateCdfValue );
+	Distribution weight( getWeight() );
+	Distribution candidateWeight( candidateEdge.getWeight() );
+	for(uint32_t t(0) ; t < weight.getSize() ; ++t){
+		double candidateCdfValue( candidateWeight.getCdfT(t) );
+		if( lt( weight.getCdfT(t) , candidateCdfValue ) ){
+			weight.setCdfT( t , candidateCdfValue );
 		}
-		if( lt( candidateCdfValue , _weight.getCdfT(t) ) ){
+		if( lt( candidateCdfValue , weight.getCdfT(t) ) ){
 			distImprovement = false;
 		}
 		if(t == 0){
-			_weight.setPdfT( t , _weight.getCdfT(t) );
+			weight.setPdfT( t , weight.getCdfT(t) );
 		}else{
-			_weight.setPdfT( t , _weight.getCdfT(t)-_weight.getCdfT(t-1) );
+			weight.setPdfT( t , weight.getCdfT(t)-weight.getCdfT(t-1) );
 		}
 	}
+	weight.updateSummary(); // the stored weight is read concurrently during the contraction simulation
+	setWeight( std::move(weight) );
 	return distImprovement;
 }
 
+/*
+ * dominates(const Edge&) method: return true if the current edge weight dominates the given edge one (see Distribution::dominates)
+ * edges sharing the same weight id have the same weight, that can not dominate itself
+ */
+bool Edge::dominates(const Edge& edge) const {
+	const WeightDictionary& dictionary( getWeightDictionary() );
+	return _weight != edge._weight && dictionary.get(_weight).dominates( dictionary.get(edge._weight) );
+}
+
 /*
  * makeDummy() method: reset the edge
  */
@@ -116,7 +123,7 @@ void Edge::makeDummy(){
 	_symEdge = INVALID_EDGE_ID;
 	_complexity = 0;
 	_nbOriginalEdge = 1;
-	_weight.reset();
+	_weight = WeightDictionary::DEFAULT_WEIGHT_ID;
 	_midnod = INVALID_NODE_ID;
 }
 
@@ -131,6 +138,6 @@ std::ostream& operator<<(std::ostream& os, const Edge& edge) {
 	if(!edge._forward && edge._backward){
 		direction = "BW";
 	}
-	os << "(N" << edge._origin << "-(n" << edge._midnod << ")->N" << edge._destination << ")[" << direction << "] " << edge._weight;
+	os << "(N" << edge._origin << "-(n" << edge._midnod << ")->N" << edge._destination << ")[" << direction << "] " << getWeightDictionary().get(edge._weight);
 	return os;
 }
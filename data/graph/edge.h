@@ -9,6 +9,7 @@
 #define DATA_EDGE_H_
 
 #include "distribution.h"
+#include "weightdictionary.h"
 
 class Edge{
 public:
@@ -20,10 +21,11 @@ public:
 	Edge(const bool& fw, const Node_id& src, const Node_id& dest);
 	Edge(const bool& fw, const Node_id& src, const Node_id& dest, Distribution& dist);
 	Edge(const bool& fw, const Node_id& src, const Node_id& dest, Distribution& dist, const Node_id& midnod);
-	Edge(const bool& fw, const Node_id& src, const Node_id& dest, Distribution& dist, const uint32_t& complex, const uint32_t& origedge, const Node_id& midnod);
+	Edge(const bool& fw, const Node_id& src, const Node_id& dest, const Distribution& dist, const uint32_t& complex, const uint32_t& origedge, const Node_id& midnod);
 	Edge(const bool& fw, const Node_id& src, const Node_id& dest, const Edge_id& e, Distribution& dist);
 	Edge(const bool& fw, const Node_id& src, const Node_id& dest, const Edge_id& e, Distribution& dist, const Node_id& midnod);
-	Edge(const Edge& edge);
+	Edge(const Edge&) = default;
+	Edge& operator=(const Edge&) = default;
 
 	/*
 	 * Getters
@@ -33,7 +35,8 @@ public:
     bool getBW() const;
     bool getFW() const;
     Edge_id getSymEdge() const ;
-    Distribution getWeight() const;
+    WeightView getWeight() const;
+    Weight_id getWeightId() const;
     double getMinWeight() const;
     double getMaxWeight() const;
     std::array<double,3> getWeightT(const uint32_t& t) const ;
@@ -53,7 +56,9 @@ public:
     void setSymEdge(const Edge_id& e);
     void setWeight(Distribution&& dist) ;
     void setWeight(const double c);
+    void setWeightId(const Weight_id& weight);
     void setComplexity(const uint32_t& c);
+    void setNbOriginalEdge(const uint32_t& n);
     void setMiddleNode(const Node_id& midnod);
 
     /*
@@ -62,6 +67,12 @@ public:
      */
     bool aggregate(const Edge& edge);
 
+    /*
+     * dominates(const Edge&) method: return true if the current edge weight dominates the given edge one (see Distribution::dominates)
+     * comparison is done on the stored weights, without any conversion
+     */
+    bool dominates(const Edge& edge) const;
+
     /*
      * makeDummy() method: reset the edge
      */
@@ -82,7 +93,7 @@ private:
     Node_id _origin;
 	Node_id _destination;
     Edge_id _symEdge; // Gives the id of the corresponding backward (resp. forward) edge if the current edge is a forward (resp. backward) edge
-	Distribution _weight; // Arc weight model, ie a discretized statistical distribution here
+	Weight_id _weight; // Arc weight model, ie a discretized statistical distribution here, given by its id in the weight dictionary
 	uint32_t _complexity; // Interval of definition of distribution (ie max - min)
 	uint32_t _nbOriginalEdge; // Number of original edge that the object represents (=1 if original edge, >1 if shortcut)
 	Node_id _midnod; // In case of shortcut, store the middle node id (INVALID_NODE_ID if original edge)
@@ -0,0 +1,145 @@
+/*
+ * edgeindex.cpp
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#include "edgeindex.h"
+#include "memoryfootprint.h"
+
+constexpr uint32_t EdgeIndex::INITIAL_CAPACITY;
+constexpr uint64_t EdgeIndex::EMPTY_KEY;
+
+/*
+ * Constructors
+ */
+EdgeIndex::EdgeIndex(): _keys(INITIAL_CAPACITY, EMPTY_KEY), _edges(INITIAL_CAPACITY, INVALID_EDGE_ID), _nbEntries(0){}
+
+/*
+ * Getters
+ */
+uint32_t EdgeIndex::getNbEntries() const { return _nbEntries; }
+
+/*
+ * key(const Node_id&, const Node_id&) method: return the key of a node pair
+ */
+uint64_t EdgeIndex::key(const Node_id& origin, const Node_id& destination){ return ( uint64_t(origin) << 32 ) | uint32_t(destination); }
+
+/*
+ * home(const uint64_t&) method: return the first slot to probe for the given key (Fibonacci hashing, the slot number being a power of two)
+ */
+size_t EdgeIndex::home(const uint64_t& k) const { return size_t( ( k * 0x9E3779B97F4A7C15ULL ) >> 32 ) & ( _keys.size() - 1 ); }
+
+/*
+ * find(const Node_id&, const Node_id&) method: return the edge id stored for the given origin and destination, INVALID_EDGE_ID if there is none
+ */
+Edge_id EdgeIndex::find(const Node_id& origin, const Node_id& destination) const {
+	const uint64_t k( key(origin, destination) );
+	const size_t mask( _keys.size() - 1 );
+	for( size_t i = home(k) ; _keys[i] != EMPTY_KEY ; i = (i+1) & mask ){
+		if( _keys[i] == k ){
+			return _edges[i];
+		}
+	}
+	return INVALID_EDGE_ID;
+}
+
+/*
+ * set(const Node_id&, const Node_id&, const Edge_id&) method: store the given edge id for the given origin and destination (the previous one, if any, is replaced)
+ */
+void EdgeIndex::set(const Node_id& origin, const Node_id& destination, const Edge_id& e){
+	if( 2 * (_nbEntries + 1) > _keys.size() ){
+		rehash( 2 * _keys.size() );
+	}
+	const uint64_t k( key(origin, destination) );
+	const size_t mask( _keys.size() - 1 );
+	size_t i( home(k) );
+	while( _keys[i] != EMPTY_KEY && _keys[i] != k ){
+		i = (i+1) & mask;
+	}
+	if( _keys[i] == EMPTY_KEY ){
+		_keys[i] = k;
+		++_nbEntries;
+	}
+	_edges[i] = e;
+}
+
+/*
+ * erase(const Node_id&, const Node_id&) method: remove the edge id stored for the given origin and destination, if any
+ * the following entries of the probe sequence are shifted back when their home slot allows it
+ */
+void EdgeIndex::erase(const Node_id& origin, const Node_id& destination){
+	const uint64_t k( key(origin, destination) );
+	const size_t mask( _keys.size() - 1 );
+	size_t i( home(k) );
+	while( _keys[i] != k ){
+		if( _keys[i] == EMPTY_KEY ){
+			return;
+		}
+		i = (i+1) & mask;
+	}
+	for( size_t j = (i+1) & mask ; _keys[j] != EMPTY_KEY ; j = (j+1) & mask ){
+		const size_t h( home(_keys[j]) );
+		// Entry j can fill the hole i if its home slot is not in the cyclic interval ]i;j]
+		if( ( (j - h) & mask ) >= ( (j - i) & mask ) ){
+			_keys[i] = _keys[j];
+			_edges[i] = _edges[j];
+			i = j;
+		}
+	}
+	_keys[i] = EMPTY_KEY;
+	_edges[i] = INVALID_EDGE_ID;
+	--_nbEntries;
+}
+
+/*
+ * clear() method: remove all the entries
+ */
+void EdgeIndex::clear(){
+	_keys.assign(INITIAL_CAPACITY, EMPTY_KEY);
+	_edges.assign(INITIAL_CAPACITY, INVALID_EDGE_ID);
+	_nbEntries = 0;
+}
+
+/*
+ * reserve(const uint32_t&) method: dimension the index for the given number of entries, so that inserting them does not trigger any growth
+ */
+void EdgeIndex::reserve(const uint32_t& nbEntries){
+	size_t nbSlots( _keys.size() );
+	while( 2 * size_t(nbEntries) > nbSlots ){
+		nbSlots *= 2;
+	}
+	if( nbSlots > _keys.size() ){
+		rehash( nbSlots );
+	}
+}
+
+/*
+ * rehash(const size_t&) method: set the number of slots (a power of two, at least twice the number of entries) and insert the entries again
+ */
+void EdgeIndex::rehash(const size_t& nbSlots){
+	std::vector<uint64_t> oldKeys( nbSlots , EMPTY_KEY );
+	std::vector<Edge_id> oldEdges( nbSlots , INVALID_EDGE_ID );
+	oldKeys.swap(_keys);
+	oldEdges.swap(_edges);
+	const size_t mask( _keys.size() - 1 );
+	for( size_t s = 0 ; s < oldKeys.size() ; ++s ){
+		if( oldKeys[s] == EMPTY_KEY ){
+			continue;
+		}
+		size_t i( home(oldKeys[s]) );
+		while( _keys[i] != EMPTY_KEY ){
+			i = (i+1) & mask;
+		}
+		_keys[i] = oldKeys[s];
+		_edges[i] = oldEdges[s];
+	}
+}
+
+/*
+ * getMemorySize() method: return the memory allocated for the slots (keys and edge ids), in bytes
+ */
+size_t EdgeIndex::getMemorySize() const {
+	return MemoryFootprint::bytes(_keys) + MemoryFootprint::bytes(_edges);
+}
@@ -0,0 +1,90 @@
+/*
+ * edgeindex.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_GRAPH_EDGEINDEX_H_
+#define DATA_GRAPH_EDGEINDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "../../misc.h"
+
+/*
+ * Class EdgeIndex: hash table from (origin, destination) node pairs to edge ids, used to find an edge without scanning node adjacencies
+ * Open addressing with linear probing: keys and ids are stored in two flat arrays whose size is a power of two, at most half full;
+ * erased entries are removed by shifting the following ones back, so that there is no tombstone. One id is stored per node pair.
+ */
+class EdgeIndex{
+public:
+	/*
+	 * Constructors
+	 */
+	EdgeIndex();
+
+	/*
+	 * Getters
+	 */
+	uint32_t getNbEntries() const;
+
+	/*
+	 * find(const Node_id&, const Node_id&) method: return the edge id stored for the given origin and destination, INVALID_EDGE_ID if there is none
+	 */
+	Edge_id find(const Node_id& origin, const Node_id& destination) const;
+
+	/*
+	 * set(const Node_id&, const Node_id&, const Edge_id&) method: store the given edge id for the given origin and destination (the previous one, if any, is replaced)
+	 */
+	void set(const Node_id& origin, const Node_id& destination, const Edge_id& e);
+
+	/*
+	 * erase(const Node_id&, const Node_id&) method: remove the edge id stored for the given origin and destination, if any
+	 */
+	void erase(const Node_id& origin, const Node_id& destination);
+
+	/*
+	 * clear() method: remove all the entries
+	 */
+	void clear();
+
+	/*
+	 * reserve(const uint32_t&) method: dimension the index for the given number of entries, so that inserting them does not trigger any growth
+	 */
+	void reserve(const uint32_t& nbEntries);
+
+	static constexpr uint32_t INITIAL_CAPACITY = 16; // Number of slots of an empty index
+
+	/*
+	 * getMemorySize() method: return the memory allocated for the slots (keys and edge ids), in bytes
+	 */
+	size_t getMemorySize() const;
+
+private:
+	/*
+	 * key(const Node_id&, const Node_id&) method: return the key of a node pair
+	 */
+	static uint64_t key(const Node_id& origin, const Node_id& destination);
+
+	/*
+	 * home(const uint64_t&) method: return the first slot to probe for the given key
+	 */
+	size_t home(const uint64_t& k) const;
+
+	/*
+	 * rehash(const size_t&) method: set the number of slots (a power of two) and insert the entries again
+	 */
+	void rehash(const size_t& nbSlots);
+
+	/*
+	 * Attributes
+	 */
+	std::vector<uint64_t> _keys; // Key of each slot (EMPTY_KEY for free slots)
+	std::vector<Edge_id> _edges; // Edge id of each slot
+	uint32_t _nbEntries; // Number of used slots
+	static constexpr uint64_t EMPTY_KEY = std::numeric_limits<uint64_t>::max(); // Key of free slots (pair of invalid nodes, never stored)
+};
+
+#endif /* DATA_GRAPH_EDGEINDEX_H_ */
@@ -0,0 +1,68 @@
+/*
+ * fft.cpp
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#include "fft.h"
+
+/*
+ * fftSize(uint32_t) method: return the smallest power of two larger than or equal to the given length
+ */
+uint32_t fftSize(const uint32_t& length){
+	uint32_t n(1);
+	while( n < length ){
+		n <<= 1;
+	}
+	return n;
+}
+
+/*
+ * fft(std::vector<std::complex<double> >&, const bool&) method: compute in place the discrete Fourier transform of a sequence (or its inverse transform)
+ * iterative Cooley-Tukey scheme: bit-reversal permutation, then log2(n) butterfly stages
+ */
+void fft(std::vector< std::complex<double> >& a, const bool& inverse){
+	const uint32_t n( a.size() );
+	assert( (n & (n-1)) == 0 );
+	// Bit-reversal permutation
+	for(uint32_t i(1), j(0) ; i < n ; ++i){
+		uint32_t bit( n >> 1 );
+		for( ; j & bit ; bit >>= 1){
+			j ^= bit;
+		}
+		j ^= bit;
+		if(i < j){
+			std::swap(a[i], a[j]);
+		}
+	}
+	// Twiddle factors exp(-2i.pi.k/N) of the largest transform computed so far, kept per thread and shared by smaller transforms
+	// (computed directly, and not by successive products, to limit rounding errors)
+	static thread_local std::vector< std::complex<double> > roots;
+	if( 2*roots.size() < n ){
+		roots.resize(n/2);
+		for(uint32_t k(0) ; k < n/2 ; ++k){
+			const double angle( -2 * M_PI * k / n );
+			roots[k] = std::complex<double>( cos(angle) , sin(angle) );
+		}
+	}
+	// Butterflies
+	for(uint32_t len(2) ; len <= n ; len <<= 1){
+		const uint32_t half( len >> 1 );
+		const uint32_t stride( 2 * roots.size() / len );
+		for(uint32_t i(0) ; i < n ; i += len){
+			for(uint32_t k(0) ; k < half ; ++k){
+				const std::complex<double> w( inverse ? std::conj( roots[k*stride] ) : roots[k*stride] );
+				const std::complex<double> u( a[i+k] );
+				const std::complex<double> v( complexProduct( a[i+k+half] , w ) );
+				a[i+k] = u + v;
+				a[i+k+half] = u - v;
+			}
+		}
+	}
+	if(inverse){
+		for(auto& value: a){
+			value /= n;
+		}
+	}
+}
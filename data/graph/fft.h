@@ -0,0 +1,40 @@
+/*
+ * fft.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_GRAPH_FFT_H_
+#define DATA_GRAPH_FFT_H_
+
+#include <complex>
+#include <vector>
+
+#include "../../misc.h"
+
+/*
+ * Fast Fourier transform file
+ * Radix-2 transform used to convolute distributions with large supports in O(n.log(n)) operations
+ */
+
+/*
+ * fftSize(uint32_t) method: return the smallest power of two larger than or equal to the given length
+ */
+uint32_t fftSize(const uint32_t& length);
+
+/*
+ * complexProduct(const std::complex<double>&, const std::complex<double>&) method: return the product of two complex numbers
+ * written explicitly, as the standard operator handles infinite and NaN parts through a slow library call
+ */
+inline std::complex<double> complexProduct(const std::complex<double>& x, const std::complex<double>& y){
+	return std::complex<double>( x.real()*y.real() - x.imag()*y.imag() , x.real()*y.imag() + x.imag()*y.real() );
+}
+
+/*
+ * fft(std::vector<std::complex<double> >&, const bool&) method: compute in place the discrete Fourier transform of a sequence (or its inverse transform)
+ * the sequence size must be a power of two; the inverse transform is normalized (divided by the sequence size)
+ */
+void fft(std::vector< std::complex<double> >& a, const bool& inverse = false);
+
+#endif /* DATA_GRAPH_FFT_H_ */
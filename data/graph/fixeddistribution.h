@@ -0,0 +1,211 @@
+/*
+ * fixeddistribution.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_GRAPH_FIXEDDISTRIBUTION_H_
+#define DATA_GRAPH_FIXEDDISTRIBUTION_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+
+#include "../../misc.h"
+#include "distribution.h"
+#include "kernels.h"
+
+/*
+ * class FixedDistribution: distribution whose number of support points is known at compile time (NbPts+1 points, NbPts being the value
+ * given by Specif::getNbPts()). The pdf and cdf are stored as std::array over the whole support: a FixedDistribution is one contiguous value,
+ * without any allocation, and the summary and dominance loops have constant bounds that the compiler can unroll.
+ * Results are the same as the Distribution ones: convolution uses the same kernels in the same order (F(t) = sum_tau F1(tau).p2(t-tau),
+ * tau in increasing order) and puts the mass beyond the support on the last point; dominance checks use the EPSILON tolerance of misc.h.
+ * The sizes available at runtime are the ones of dispatchFixedDistribution().
+ */
+template<uint32_t NbPts>
+class FixedDistribution{
+public:
+	static constexpr uint32_t SIZE = NbPts + 1; // Number of support points
+
+	/*
+	 * Constructors
+	 */
+	FixedDistribution(): _delta(1){
+		_pdf.fill(0);
+		_cdf.fill(1);
+		_pdf[0] = 1;
+	}
+	FixedDistribution(const Distribution& dist): _delta(dist.getDelta()){
+		assert( dist.getSize() == SIZE );
+		for(uint32_t t(0) ; t < SIZE ; ++t){
+			_pdf[t] = dist.getPdfT(t);
+			_cdf[t] = dist.getCdfT(t);
+		}
+	}
+
+	/*
+	 * Getters
+	 */
+	uint32_t getSize() const { return SIZE; }
+	uint32_t getDelta() const { return _delta; }
+	uint32_t getSupT(const uint32_t& t) const { return t * _delta; }
+	double getCdfT(const uint32_t& t) const { return _cdf[t]; }
+	double getPdfT(const uint32_t& t) const { return _pdf[t]; }
+
+	/*
+	 * toDistribution() method: return the (windowed) Distribution corresponding to the fixed one
+	 */
+	Distribution toDistribution() const {
+		return Distribution(SIZE, _delta, 0, std::vector<double>(_pdf.begin(), _pdf.end()), std::vector<double>(_cdf.begin(), _cdf.end()));
+	}
+
+	/*
+	 * min() method: return the minimum possible realization
+	 */
+	uint32_t min() const {
+		uint32_t t(0);
+		while( t < SIZE-1 && !gt(_cdf[t],0) ){
+			++t;
+		}
+		return t * _delta;
+	}
+
+	/*
+	 * max() method: return the maximum possible realization
+	 */
+	uint32_t max() const {
+		uint32_t t(0);
+		while( t < SIZE-1 && !eq(_cdf[t],1) ){
+			++t;
+		}
+		return t * _delta;
+	}
+
+	/*
+	 * esp() method: return the esperance of the distribution
+	 */
+	double esp() const {
+		double esperance(0);
+		for(uint32_t t(0) ; t < SIZE ; ++t){
+			esperance += ( t * _delta ) * _pdf[t];
+		}
+		return esperance;
+	}
+
+	/*
+	 * convolute(const FixedDistribution&) method: return the convolution of the current distribution and the given one
+	 * the mass beyond the support is put on the last support point
+	 */
+	FixedDistribution convolute(const FixedDistribution& dist) const {
+		FixedDistribution result;
+		result._delta = _delta;
+		result._pdf.fill(0);
+		result._cdf.fill(0);
+		const DistributionKernels& kernels( getKernels() );
+		uint32_t lo2(0), hi2(SIZE-1);
+		while( lo2 < hi2 && dist._pdf[lo2] == 0 ){
+			++lo2;
+		}
+		while( hi2 > lo2 && dist._pdf[hi2] == 0 ){
+			--hi2;
+		}
+		for(uint32_t tau(0) ; tau+lo2 < SIZE ; ++tau){
+			kernels.axpy2( &result._pdf[tau+lo2] , &result._cdf[tau+lo2] , &dist._pdf[lo2] , _pdf[tau] , _cdf[tau] , std::min( hi2 , SIZE-1-tau ) - lo2 + 1 );
+		}
+		if( !eq( result._cdf[SIZE-1] , 1.0 ) ){
+			result._cdf[SIZE-1] = 1.0;
+			result._pdf[SIZE-1] = 1.0 - result._cdf[SIZE-2];
+		}
+		return result;
+	}
+
+	/*
+	 * dominates(const FixedDistribution&) method: return true if current cdf dominates the given one, for each support points (ie F1(t)>=F2(t) forall t, and at least one t such that F1(t)>F2(t))
+	 */
+	bool dominates(const FixedDistribution& dist) const {
+		bool response(false);
+		for(uint32_t t(0) ; t < SIZE ; ++t){
+			if( !le( dist._cdf[t] , _cdf[t] ) ){
+				return false;
+			}
+			if( !le( _cdf[t] , dist._cdf[t] ) ){
+				response = true;
+			}
+			if( eq( _cdf[t] , 1 ) && eq( dist._cdf[t] , 1 ) ){
+				return response;
+			}
+		}
+		return response;
+	}
+
+	/*
+	 * isLargerThan(const FixedDistribution&) method: return true if current cdf is larger than the given one, for each support points (ie F1(t)>=F2(t) forall t), false otherwise
+	 */
+	bool isLargerThan(const FixedDistribution& dist) const {
+		for(uint32_t t(0) ; t < SIZE ; ++t){
+			if( !le( dist._cdf[t] , _cdf[t] ) ){
+				return false;
+			}
+			if( eq( _cdf[t] , 1 ) && eq( dist._cdf[t] , 1 ) ){
+				return true;
+			}
+		}
+		return true;
+	}
+
+	/*
+	 * << operator: return an outstream version of the distribution (printing purpose), same format as Distribution
+	 */
+	friend std::ostream& operator<<(std::ostream& os, const FixedDistribution& dist){
+		for(uint32_t t(0) ; t < SIZE ; ++t){
+			os << "(" << dist.getSupT(t) << ";" << dist._pdf[t] << ";" << dist._cdf[t] << ") ";
+		}
+		return os;
+	}
+
+private:
+	/*
+	 * Attributes
+	 */
+	uint32_t _delta; // Difference between two consecutive support points
+	std::array<double, SIZE> _pdf; // Probability mass function, over the whole support
+	std::array<double, SIZE> _cdf; // Cumulative distribution function, over the whole support
+};
+
+template<uint32_t NbPts> constexpr uint32_t FixedDistribution<NbPts>::SIZE;
+
+/*
+ * dispatchFixedDistribution(const uint32_t&, Args&...) method: call Action<NbPts>::run(args...) with NbPts equal to the given number of points
+ * (Specif::getNbPts()), if FixedDistribution is instantiated for it; return false otherwise (then the caller keeps to Distribution)
+ * Instantiated sizes are the common ones of the instance families (each one adds a copy of the code using it to the binary).
+ */
+template<template<uint32_t> class Action, typename... Args>
+bool dispatchFixedDistribution(const uint32_t& nbPts, Args&... args){
+	switch(nbPts){
+	case 20:
+		Action<20>::run(args...);
+		return true;
+	case 50:
+		Action<50>::run(args...);
+		return true;
+	case 60:
+		Action<60>::run(args...);
+		return true;
+	case 100:
+		Action<100>::run(args...);
+		return true;
+	case 120:
+		Action<120>::run(args...);
+		return true;
+	case 200:
+		Action<200>::run(args...);
+		return true;
+	default:
+		return false;
+	}
+}
+
+#endif /* DATA_GRAPH_FIXEDDISTRIBUTION_H_ */
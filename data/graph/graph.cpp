@@ -6,125 +6,150 @@
  */
 
 #include "graph.h"
+#include "../../data_io/checkpoint_io.h"
 #include "../../data_io/hierarchy_io.h"
 
 Graph::Graph(){}
-Graph::Graph(GraphReader graphdata, const Specif& specif): _specif(specif){
-	std::vector<Edge> edges = graphdata.getEdges();
+Graph::Graph(GraphReader graphdata, const Specif& specif): Graph(std::move(graphdata), specif, NodePermutation()){}
+Graph::Graph(GraphReader graphdata, const Specif& specif, const NodePermutation& permutation): _specif(specif), _permutation(permutation){
+	auto t_begin = time_stamp();
+	std::vector<Edge> edges( graphdata.releaseEdges() ); // Edges are moved out of the reader (no copy)
+	_permutation.toInternal(edges); // Nodes and edges are stored with their internal ids
+	const uint32_t nbEdges( edges.size() );
+	auto t_renumbered = time_stamp();
 	/*
 	 * Set-up nodes: affect ids between 0 and max_id (number of nodes)
 	 */
-	Node_id max_node_it(0);
+	uint32_t max_node_it(0);
 	// For each edge in the list, determinate the max node id (the final value is the maximal node id in the graph)
-	std::for_each( edges.begin(), edges.end(), [&max_node_it](const Edge& edges) -> void {
-		max_node_it = std::max(max_node_it, edges.getOrigin());
-		max_node_it = std::max(max_node_it, edges.getDestination());
-	} );
-	_nodes.assign(max_node_it + 1, Node()); // The max value is used to dimension the graph
+#pragma omp parallel for reduction(max:max_node_it)
+	for ( uint32_t i = 0 ; i < nbEdges ; ++i ){
+		max_node_it = std::max( max_node_it , uint32_t( std::max( edges[i].getOrigin() , edges[i].getDestination() ) ) );
+	}
+	const uint32_t nbNodes( max_node_it + 1 ); // The max value is used to dimension the graph
+	_nodes.assign(nbNodes, Node());
+	_fwCapacities.assign(nbNodes, 0);
+	_bwCapacities.assign(nbNodes, 0);
 	/*
 	 * Set-up levels: by default, consider that node ni is the i^th in the hierarchy (can be modified by the function ordering)
 	 */
-	_levels.assign(max_node_it + 1, INVALID_NODE_ID );
+	_levels.assign(nbNodes, INVALID_NODE_ID );
 	std::iota(_levels.begin(),_levels.end(),0);
-	_sortednodes.assign(max_node_it + 1, INVALID_NODE_ID );
+	_sortednodes.assign(nbNodes, INVALID_NODE_ID );
 	std::iota(_sortednodes.begin(),_sortednodes.end(),0);
 	/*
-	 * Set-up Forward edges
+	 * Count the forward (resp. backward) edges of each node, ie the edges leaving (resp. reaching) it
+	 */
+	std::vector<uint32_t> fwOffsets(nbNodes + 1, 0);
+	std::vector<uint32_t> bwOffsets(nbNodes + 1, 0);
+#pragma omp parallel for
+	for ( uint32_t i = 0 ; i < nbEdges ; ++i ){
+#pragma omp atomic
+		++fwOffsets[ edges[i].getOrigin() + 1 ];
+#pragma omp atomic
+		++bwOffsets[ edges[i].getDestination() + 1 ];
+	}
+	auto t_counted = time_stamp();
+	/*
+	 * Set-up edge blocks: each node with at least one edge gets a block of its edges followed by dummy edges, blocks being sorted by node ids
+	 */
+	uint32_t fwSize(0), bwSize(0);
+	for ( Node_id n(0) ; n < nbNodes ; ++n ){
+		const uint32_t nbFwEdges( fwOffsets[n+1] ), nbBwEdges( bwOffsets[n+1] );
+		if ( nbFwEdges > 0 ){
+			_nodes[n].setBeginFW( Edge_id(fwSize) );
+			_nodes[n].setEndFW( Edge_id(fwSize + nbFwEdges) );
+			_fwCapacities[n] = initialCapacity( nbFwEdges );
+			fwSize += _fwCapacities[n];
+		}
+		if ( nbBwEdges > 0 ){
+			_nodes[n].setBeginBW( Edge_id(bwSize) );
+			_nodes[n].setEndBW( Edge_id(bwSize + nbBwEdges) );
+			_bwCapacities[n] = initialCapacity( nbBwEdges );
+			bwSize += _bwCapacities[n];
+		}
+		fwOffsets[n+1] += fwOffsets[n];
+		bwOffsets[n+1] += bwOffsets[n];
+	}
+	/*
+	 * Sort edges by origin (forward) and by destination (backward), with a counting sort on edge indices: both directions are sorted at the same time
+	 * then the edges of each node are sorted by original id of their destination (forward) or origin (backward), input order breaking ties:
+	 * the edges are scanned in the same order whatever the internal numbering, which keeps the ordering process independent of it
 	 */
-	std::sort( edges.begin(), edges.end(),[](const Edge& e1, const Edge& e2) -> bool {
-		return (e1.getOrigin() != e2.getOrigin()) ? e1.getOrigin() < e2.getOrigin() : e1.getDestination() < e2.getDestination() ;
-	} ); // Sort input edges by source id AND by destination id
-	// For all edges, update the corresponding node description (if necessary) and update the forward edge list
-	for ( auto it = edges.begin() ; it != edges.end() ; ++it ){
-		if ( _nodes[it->getOrigin()].getBeginFW() == INVALID_EDGE_ID ){ // If the current edge is the first to leave the node it leaves...
-			// If the current edge is not the first in the list, insert dummy edges to cover the further edge creations for previous node
-			if ( it > edges.begin() ){
-				uint32_t previous_source = (it-1)->getOrigin();
-				uint32_t n_edges_of_previous_source = _nodes[previous_source].getEndFW() - _nodes[previous_source].getBeginFW();
-				uint32_t n_dummies = std::max( size_t(n_edges_of_previous_source + 2), size_t(double(n_edges_of_previous_source) * GROWTH_FACTOR) ); // Reserve some space for further additional edges = max(#edges+2;1.2#edges)
-				for ( uint32_t i = 0 ; i < n_dummies ; ++i ){
-					_fwedges.push_back( std::move( Edge() ) );
-				}
+	std::vector<uint32_t> fwSorted(nbEdges), bwSorted(nbEdges);
+#pragma omp parallel sections
+	{
+#pragma omp section
+		{
+			std::vector<uint32_t> cursors( fwOffsets.begin() , fwOffsets.end() - 1 );
+			for ( uint32_t i = 0 ; i < nbEdges ; ++i ){
+				fwSorted[ cursors[ edges[i].getOrigin() ]++ ] = i;
 			}
-			Edge_id fws( _fwedges.size() );
-			_nodes[it->getOrigin()].setBeginFW( fws );
-			_nodes[it->getOrigin()].setEndFW( fws );
-		}
-		// Add the edge in the forward edge list
-		Distribution dist = it->getWeight();
-		_fwedges.push_back( std::move( Edge( true , it->getOrigin() , it->getDestination() , dist , it->getMiddleNode() ) ) );
-//		TRACE( "Last forward inserted edge: " << _fwedges.back() );
-		// Update the node description (increment the forward edge counter)
-		Edge_id fwedge_id(1 + _nodes[it->getOrigin()].getEndFW() );
-		_nodes[it->getOrigin()].setEndFW( fwedge_id );
-	}
-	// If at least one edge exists, add dummy edges to complete the vector (in case of further edge creation) for the last studied node
-	if ( ! edges.empty() ){
-		uint32_t previous_source = edges.back().getOrigin();
-		uint32_t n_edges_of_previous_source = _nodes[previous_source].getEndFW() - _nodes[previous_source].getBeginFW();
-		uint32_t n_dummies = std::max( uint32_t(n_edges_of_previous_source + 2), uint32_t(double(n_edges_of_previous_source) * GROWTH_FACTOR) ); // Reserve some space for further additional edges = max(#edges+2;1.2#edges)
-		for ( uint32_t i = 0 ; i < n_dummies ; ++i ){
-			_fwedges.push_back( std::move( Edge() ) );
+		}
+#pragma omp section
+		{
+			std::vector<uint32_t> cursors( bwOffsets.begin() , bwOffsets.end() - 1 );
+			for ( uint32_t i = 0 ; i < nbEdges ; ++i ){
+				bwSorted[ cursors[ edges[i].getDestination() ]++ ] = i;
+			}
+		}
+	}
+	std::vector<Edge_id> bwPositions(nbEdges); // Backward edge id of each input edge
+#pragma omp parallel for schedule(dynamic, 256)
+	for ( uint32_t n = 0 ; n < nbNodes ; ++n ){
+		std::sort( fwSorted.begin() + fwOffsets[n] , fwSorted.begin() + fwOffsets[n+1] , [&edges,this](const uint32_t& i1, const uint32_t& i2) -> bool {
+			const Node_id d1( _permutation.toOriginal( edges[i1].getDestination() ) ), d2( _permutation.toOriginal( edges[i2].getDestination() ) );
+			return (d1 != d2) ? d1 < d2 : i1 < i2 ;
+		} );
+		std::sort( bwSorted.begin() + bwOffsets[n] , bwSorted.begin() + bwOffsets[n+1] , [&edges,this](const uint32_t& i1, const uint32_t& i2) -> bool {
+			const Node_id o1( _permutation.toOriginal( edges[i1].getOrigin() ) ), o2( _permutation.toOriginal( edges[i2].getOrigin() ) );
+			return (o1 != o2) ? o1 < o2 : i1 < i2 ;
+		} );
+		for ( uint32_t k = bwOffsets[n] ; k < bwOffsets[n+1] ; ++k ){
+			bwPositions[ bwSorted[k] ] = Edge_id( _nodes[n].getBeginBW() + k - bwOffsets[n] );
+		}
+	}
+	bwSorted.clear();
+	auto t_sorted = time_stamp();
+	/*
+	 * Fill forward and backward edge arrays at once: both copies of an edge are written by the same thread, slots left are dummy edges
+	 */
+	_fwDestinations.assign(fwSize, INVALID_NODE_ID);
+	_fwWeights.assign(fwSize, WeightDictionary::DEFAULT_WEIGHT_ID);
+	_fwSymEdges.assign(fwSize, INVALID_EDGE_ID);
+	_fwMiddleNodes.assign(fwSize, INVALID_NODE_ID);
+	_fwComplexities.assign(fwSize, 0);
+	_fwNbOriginalEdges.assign(fwSize, 1);
+	_bwOrigins.assign(bwSize, INVALID_NODE_ID);
+	_bwWeights.assign(bwSize, WeightDictionary::DEFAULT_WEIGHT_ID);
+	_bwSymEdges.assign(bwSize, INVALID_EDGE_ID);
+#pragma omp parallel for schedule(dynamic, 256)
+	for ( uint32_t n = 0 ; n < nbNodes ; ++n ){
+		for ( uint32_t k = fwOffsets[n] ; k < fwOffsets[n+1] ; ++k ){
+			const uint32_t i( fwSorted[k] );
+			// Both copies keep the weight id given by the reader, the weight is not interned again
+			storeEdge( Edge_id(_nodes[n].getBeginFW() + k - fwOffsets[n]) , bwPositions[i] , edges[i] );
 		}
 	}
 	// Edges have been saved, the initial structure can be emptied
 	edges.clear();
+	auto t_filled = time_stamp();
 	/*
-	 * Set-up Backward edges
+	 * Index forward edges by node pairs (the first edge of each pair, in forward order, if there are parallel edges)
 	 */
-	std::vector<Edge> backward_edge_list;
-	backward_edge_list.reserve( max_node_it );
-	// For each forward edge of each node, generate an edge aiming at modeling the corresponding backward edge
-	Node_id maxnodeid( _nodes.size() );
-	for ( Node_id source(0) ; source != maxnodeid ; ++source ){
-		for ( Edge_id fw_edge_it = _nodes[source].getBeginFW() ; fw_edge_it < _nodes[source].getEndFW() ; ++fw_edge_it ){
-			assert( fw_edge_it < _fwedges.size() );
-			Distribution dist = _fwedges[fw_edge_it].getWeight();
-			Edge curEdge = Edge( false , source , _fwedges[fw_edge_it].getDestination() , fw_edge_it , dist , _fwedges[fw_edge_it].getMiddleNode() );
-			backward_edge_list.push_back( curEdge );
-		}
-	}
-	// Sort the new edges according to the destination ids
-	std::sort(backward_edge_list.begin(), backward_edge_list.end(),
-			[](const Edge& e1, const Edge& e2) -> bool { return e1.getDestination() < e2.getDestination(); }
-	);
-	// For each new edge, create a final version that will compose the graph
-	for ( auto it = backward_edge_list.begin() ; it != backward_edge_list.end() ; ++it ){
-		//			assert( it->_target < _nodes.size() );
-		if ( _nodes[it->getDestination()].getBeginBW() == INVALID_EDGE_ID ){
-			// If the current edge is not the first in the list, insert dummy edges to cover the further edge creations
-			if ( it > backward_edge_list.begin() ){
-				uint32_t previous_target = (it-1)->getDestination();
-				uint32_t n_edges_of_previos_target = _nodes[previous_target].getEndBW() - _nodes[previous_target].getBeginBW();
-				uint32_t n_dummies = std::max( uint32_t(n_edges_of_previos_target + 2), uint32_t(double(n_edges_of_previos_target) * GROWTH_FACTOR) ); // Reserve some space for further additional edges = max(#edges+2;1.2#edges)
-				_bwedges.insert(_bwedges.end(), n_dummies, Edge() );
+	_fwIndex.reserve( nbEdges );
+	for ( Node_id n(0) ; n < nbNodes ; ++n ){
+		for ( Edge_id fwe = getNodeBeginFW(n) ; fwe < getNodeEndFW(n) ; ++fwe ){
+			if( _fwIndex.find( n , _fwDestinations[fwe] ) == INVALID_EDGE_ID ){
+				_fwIndex.set( n , _fwDestinations[fwe] , fwe );
 			}
-			Edge_id bws( _bwedges.size() );
-			_nodes[it->getDestination()].setBeginBW( bws );
-			_nodes[it->getDestination()].setEndBW( bws );
-		}
-		// Set the symmetric edge id according to the size of the backward edge vector
-		Edge_id bwsym( _bwedges.size() );
-		_fwedges[it->getSymEdge()].setSymEdge( bwsym );
-		// Add the edge in the backward edge list (the backward edge id can't be larger than the forward edge max id, as both sets are symmetric)
-		Distribution dist = it->getWeight();
-		_bwedges.push_back( Edge( false , it->getOrigin() , it->getDestination() , it->getSymEdge() , dist , it->getMiddleNode() ) );
-		//		TRACE( "Last backward inserted edge: " << _bwedges.back() );
-		// Update the node description (increment the backward edge counter)
-		Edge_id bwedge_id(1 + _nodes[it->getDestination()].getEndBW() );
-		_nodes[it->getDestination()].setEndBW( bwedge_id );
-	}
-	// If some edges have been created, add dummy edges to complete the vector (in case of further edge creation)
-	if ( ! backward_edge_list.empty() ){
-		uint32_t previous_target = backward_edge_list.back().getDestination();
-		uint32_t n_edges_of_previous_source = _nodes[previous_target].getEndBW() - _nodes[previous_target].getBeginBW();
-		uint32_t n_dummies = std::max( uint32_t(n_edges_of_previous_source + 2), uint32_t(double(n_edges_of_previous_source) * GROWTH_FACTOR) ); // Reserve some space for further additional edges = max(#edges+2;1.2#edges)
-		for ( uint32_t i = 0 ; i < n_dummies ; ++i ){
-			_bwedges.push_back( Edge() );
 		}
 	}
-	// Edges have been saved, the initial structure can be emptied
-	backward_edge_list.clear();
+	auto t_indexed = time_stamp();
+	STATUS( "Graph construction: " << get_duration_in_seconds(t_begin, t_indexed) << " sec (renumbering " << get_duration_in_seconds(t_begin, t_renumbered)
+			<< ", counting " << get_duration_in_seconds(t_renumbered, t_counted) << ", sorting " << get_duration_in_seconds(t_counted, t_sorted)
+			<< ", filling " << get_duration_in_seconds(t_sorted, t_filled) << ", indexing " << get_duration_in_seconds(t_filled, t_indexed)
+			<< "; " << omp_get_max_threads() << " threads)\n" );
 }
 
 /*
@@ -132,27 +157,67 @@ Graph::Graph(GraphReader graphdata, const Specif& specif): _specif(specif){
  */
 Graph::~Graph(){
 	_nodes.clear();
-	_fwedges.clear();
-	_bwedges.clear();
+	_fwDestinations.clear();
+	_fwWeights.clear();
+	_fwSymEdges.clear();
+	_fwMiddleNodes.clear();
+	_fwComplexities.clear();
+	_fwNbOriginalEdges.clear();
+	_bwOrigins.clear();
+	_bwWeights.clear();
+	_bwSymEdges.clear();
 }
 
 /*
- * Getters
+ * Getters: containers and nodes are returned as const references (no copy), they remain valid until the next graph update
+ * edges are built from the edge arrays (a backward edge gets the shortcut data of its forward edge)
  */
-Specif Graph::getSpecif() const{ return _specif; }
+const Specif& Graph::getSpecif() const{ return _specif; }
+const NodePermutation& Graph::getPermutation() const{ return _permutation; }
 uint32_t Graph::getNbNodes() const{ return _specif.getNbNodes(); }
 uint32_t Graph::getNbEdges() const{ return _specif.getNbEdges(); }
 uint32_t Graph::getNbPtss() const{ return _specif.getNbPts(); }
 uint32_t Graph::getDelta() const{ return _specif.getDelta(); }
-std::vector<Node> Graph::getNodes() const{ return _nodes; }
-Node Graph::getNode(const Node_id& n) const { return _nodes[n]; }
-std::vector<Edge> Graph::getFwEdges() const{ return _fwedges; }
-Edge Graph::getFwEdge(const Edge_id& e) const { return _fwedges[e]; }
-std::vector<Edge> Graph::getBwEdges() const{ return _bwedges; }
-Edge Graph::getBwEdge(const Edge_id& e) const { return _bwedges[e]; }
-std::vector<Node_id> Graph::getSortedNodes() const{ return _sortednodes; }
+const std::vector<Node>& Graph::getNodes() const{ return _nodes; }
+const Node& Graph::getNode(const Node_id& n) const { return _nodes[n]; }
+Edge Graph::getFwEdge(const Edge_id& e) const {
+	Edge edge;
+	if( _fwSymEdges[e] != INVALID_EDGE_ID ){
+		edge = Edge( true , _bwOrigins[ _fwSymEdges[e] ] , _fwDestinations[e] );
+		edge.setSymEdge( _fwSymEdges[e] );
+		edge.setWeightId( _fwWeights[e] );
+		edge.setComplexity( _fwComplexities[e] );
+		edge.setNbOriginalEdge( _fwNbOriginalEdges[e] );
+		edge.setMiddleNode( _fwMiddleNodes[e] );
+	}
+	return edge;
+}
+Edge Graph::getBwEdge(const Edge_id& e) const {
+	Edge edge;
+	const Edge_id fwe( _bwSymEdges[e] );
+	if( fwe != INVALID_EDGE_ID ){
+		edge = Edge( false , _bwOrigins[e] , _fwDestinations[fwe] );
+		edge.setSymEdge( fwe );
+		edge.setWeightId( _bwWeights[e] );
+		edge.setComplexity( _fwComplexities[fwe] );
+		edge.setNbOriginalEdge( _fwNbOriginalEdges[fwe] );
+		edge.setMiddleNode( _fwMiddleNodes[fwe] );
+	}
+	return edge;
+}
+Node_id Graph::getFwDestination(const Edge_id& e) const { return _fwDestinations[e]; }
+Node_id Graph::getBwOrigin(const Edge_id& e) const { return _bwOrigins[e]; }
+Weight_id Graph::getFwWeightId(const Edge_id& e) const { return _fwWeights[e]; }
+Weight_id Graph::getBwWeightId(const Edge_id& e) const { return _bwWeights[e]; }
+WeightView Graph::getFwWeight(const Edge_id& e) const { return getWeightDictionary().getDistribution( _fwWeights[e] ); }
+WeightView Graph::getBwWeight(const Edge_id& e) const { return getWeightDictionary().getDistribution( _bwWeights[e] ); }
+Node_id Graph::getFwMiddleNode(const Edge_id& e) const { return _fwMiddleNodes[e]; }
+Node_id Graph::getBwMiddleNode(const Edge_id& e) const { return _fwMiddleNodes[ _bwSymEdges[e] ]; }
+uint32_t Graph::getFwNbOriginalEdge(const Edge_id& e) const { return _fwNbOriginalEdges[e]; }
+uint32_t Graph::getBwNbOriginalEdge(const Edge_id& e) const { return _fwNbOriginalEdges[ _bwSymEdges[e] ]; }
+const std::vector<Node_id>& Graph::getSortedNodes() const{ return _sortednodes; }
 Node_id Graph::getSortedNode(const uint32_t& index) const{ return _sortednodes[index]; }
-std::vector<uint32_t> Graph::getLevels() const{ return _levels; }
+const std::vector<uint32_t>& Graph::getLevels() const{ return _levels; }
 uint32_t Graph::getLevel(const uint32_t& index) const{ return _levels[index]; }
 Edge_id Graph::getNodeBeginBW(Node_id n) const{ return _nodes[n].getBeginBW(); }
 Edge_id Graph::getNodeEndBW(Node_id n) const{ return _nodes[n].getEndBW(); }
@@ -163,8 +228,8 @@ Edge_id Graph::getNodeEndFW(Node_id n) const{ return _nodes[n].getEndFW(); }
  * Setters
  */
 void Graph::setLevel(const Node_id& n, const uint32_t& l){ /*TRACE("Node N" << n << " has level L" << l);*/ _levels[n] = l; _sortednodes[l] = n; }
-void Graph::setFwEdgeWeight(const Edge_id& edge_id, Distribution& dist){ _fwedges[edge_id].setWeight( std::move(dist) ); }
-void Graph::setBwEdgeWeight(const Edge_id& edge_id, Distribution& dist){ _bwedges[edge_id].setWeight( std::move(dist) ); }
+void Graph::setFwEdgeWeight(const Edge_id& edge_id, Distribution& dist){ _fwWeights[edge_id] = getWeightDictionary().intern(dist); shareFwWeight(edge_id); }
+void Graph::setBwEdgeWeight(const Edge_id& edge_id, Distribution& dist){ _bwWeights[edge_id] = getWeightDictionary().intern(dist); shareBwWeight(edge_id); }
 void Graph::setNodeBeginBW(const Node_id tgt, const Edge_id& e){ _nodes[tgt].setBeginBW(e); }
 void Graph::setNodeEndBW(const Node_id tgt, const Edge_id& e){ _nodes[tgt].setEndBW(e); }
 void Graph::setNodeBeginFW(const Node_id src, const Edge_id& e){ _nodes[src].setBeginFW(e); }
@@ -172,30 +237,39 @@ void Graph::setNodeEndFW(const Node_id src, const Edge_id& e){ _nodes[src].setEn
 void Graph::setHierarchy(const std::string& hierarchyFileName){
 	HierarchyIO hierarchyReader = HierarchyIO(hierarchyFileName, _sortednodes, _levels);
 	hierarchyReader.read();
-	hierarchyReader.recoverHierarchy(_sortednodes,_levels);
+	setHierarchy( hierarchyReader.getNodes() , hierarchyReader.getLevels() );
 //	STATUS("Hierarchy recovered!\n");
 }
+void Graph::setHierarchy(const std::vector<Node_id>& sortedNodes, const std::vector<uint32_t>& levels){
+	// The hierarchy refers to original node ids, it is ignored if it does not rank each node once
+	if( sortedNodes.size() != _nodes.size() || levels.size() != _nodes.size() || !NodePermutation::isPermutation(sortedNodes) ){
+		ERROR("Invalid hierarchy: some node ids are out of range, duplicated or missing.\n");
+		return;
+	}
+	_sortednodes = _permutation.internalIds(sortedNodes);
+	_levels = _permutation.internalIndexing(levels);
+}
 
 /*
  * aggregateEdge(const Edge_id&, const Edge&) method: update forward&backward edges at given index with candidate edge (info: distribution + middle node)
+ * the aggregation is computed once, on the forward edge, the backward edge (its symmetric edge) gets the resulting weight id
  */
 void Graph::updateEdgeInfo(const Edge_id& fwe, const Edge_id& bwe, const Edge& candidateEdge){
-	_fwedges[fwe].aggregate( candidateEdge );
-	_fwedges[fwe].setMiddleNode( candidateEdge.getMiddleNode() );
-	_bwedges[bwe].aggregate( candidateEdge );
-	_bwedges[bwe].setMiddleNode( candidateEdge.getMiddleNode() );
-
+	assert( _fwSymEdges[fwe] == bwe );
+	_fwWeights[fwe] = aggregateWeight( _fwWeights[fwe] , candidateEdge );
+	_fwMiddleNodes[fwe] = candidateEdge.getMiddleNode(); // Shared with the backward edge
+	shareFwWeight(fwe);
 }
 
 /*
- * aggregateFwEdge(const Edge_id&, const Edge&) method: aggregate forward edge at given index with candidate edge
+ * aggregateFwEdge(const Edge_id&, const Edge&) method: aggregate forward edge at given index with candidate edge (its symmetric edge gets the same weight)
  */
-void Graph::aggregateFwEdge(const Edge_id& e, const Edge& candidateEdge){ _fwedges[e].aggregate( candidateEdge ); }
+void Graph::aggregateFwEdge(const Edge_id& e, const Edge& candidateEdge){ _fwWeights[e] = aggregateWeight( _fwWeights[e] , candidateEdge ); shareFwWeight(e); }
 
 /*
- * aggregateBwEdge(const Edge_id&, const Edge&) method: aggregate backward edge at given index with candidate edge
+ * aggregateBwEdge(const Edge_id&, const Edge&) method: aggregate backward edge at given index with candidate edge (its symmetric edge gets the same weight)
  */
-void Graph::aggregateBwEdge(const Edge_id& e, const Edge& candidateEdge){ _bwedges[e].aggregate( candidateEdge ); }
+void Graph::aggregateBwEdge(const Edge_id& e, const Edge& candidateEdge){ _bwWeights[e] = aggregateWeight( _bwWeights[e] , candidateEdge ); shareBwWeight(e); }
 
 /*
  * addShortcut(const Edge&) method: add a new shortcut edge to the graph
@@ -203,148 +277,66 @@ void Graph::aggregateBwEdge(const Edge_id& e, const Edge& candidateEdge){ _bwedg
 void Graph::addShortcut(Edge&& edge){
 	Edge_id fwInsert = identifyFwInsertId( edge.getOrigin() );
 	Edge_id bwInsert = identifyBwInsertId( edge.getDestination() );
-	_fwedges[fwInsert] = edge;
-	_fwedges[fwInsert].setSymEdge( bwInsert );
-	_bwedges[bwInsert] = std::move(edge);
-	_bwedges[bwInsert].setDirection( false );
-	_bwedges[bwInsert].setSymEdge( fwInsert );
+	storeEdge( fwInsert , bwInsert , edge );
+	if( _fwIndex.find( edge.getOrigin() , edge.getDestination() ) == INVALID_EDGE_ID ){
+		_fwIndex.set( edge.getOrigin() , edge.getDestination() , fwInsert );
+	}
 	_specif.incrementEdge();
 }
 
 /*
- * identifyFwInsertId(const std::vector<Edge>&, Node_id, Node_id) method: return id at which an edge can be inserted
+ * identifyFwInsertId(const Node_id&) method: return id at which a forward edge of the given node can be inserted
+ * the edge goes at the end of the node block; if the block is full (or if the node has no block yet), the node edges are first moved into a larger block
  */
 Edge_id Graph::identifyFwInsertId( const Node_id& node ){
 	Edge_id begin( getNodeBeginFW(node) );
-	Edge_id end( getNodeEndFW(node) );
-	Edge_id insertId(INVALID_EDGE_ID);
-//	TRACE("Insert edge in the set " << begin << "-" << end);
-	// Case 1: unconnected node, last edge id is not initialized yet => create some dummy edges to prepare more edge insertions
-	if( end == INVALID_EDGE_ID ){
-//		TRACE("[" << begin << "-" << end << "] CASE 1: end id is invalid");
-		const uint32_t oldNbEdges = 0;
-		const uint32_t nbDummies = 1 + std::max( oldNbEdges+3, uint32_t((1+oldNbEdges)*GROWTH_FACTOR) ) - (1+oldNbEdges);
-		for ( uint32_t i = 0 ; i < nbDummies ; ++i ){
-			_fwedges.emplace_back();
-		}
-		// Begin and end id are respectively the edge container size and this size + 1
-		setNodeBeginFW( node , Edge_id(_fwedges.size()) );
-		insertId = _fwedges.size();
-		setNodeEndFW( node , Edge_id(_fwedges.size() + 1) );
-	}
-	// Case 2: end id corresponds to edge container size => more dummy edges are needed to prepare shortcut insertions
-	else if( end == _fwedges.size() ){
-//		TRACE("[" << begin << "-" << end << "] CASE 2: end id is the last edge");
-		const uint32_t oldNbEdges = end - begin;
-		const uint32_t nbDummies = 1 + std::max( oldNbEdges+3, uint32_t((1+oldNbEdges)*GROWTH_FACTOR) ) - (1+oldNbEdges);
-		for ( uint32_t i = 0 ; i < nbDummies ; ++i ){
-			_fwedges.emplace_back();
-		}
-		// Final insert id is the old container size, the end id is subsequently incremented
-		insertId = end;
-		setNodeEndFW( node , Edge_id(end + 1) );
-	}
-	// Case 3: origin node of the end edge is invalid
-	else if( _fwedges[end].getOrigin() == INVALID_NODE_ID ){
-//		TRACE("[" << begin << "-" << end << "] CASE 3: origin node of the end edge is invalid => add an edge at the next free index");
-		insertId = end;
-//		Edge_id newEndFW(end+1);
-		setNodeEndFW( node , Edge_id(end + 1) );
-	}
-	// Case 4: origin node of the edge before begin is invalid
-	else if( begin > 0 && _fwedges[begin - 1].getOrigin() == INVALID_NODE_ID ){
-//		TRACE("[" << begin << "-" << end << "] CASE 4: begin is strictly positive, and the origin node of begin-1 edge is invalid => add an edge at the last free index");
-		insertId = begin-1;
-		setNodeBeginFW( node , Edge_id(begin-1) );
-	}
-	// Case 5:
-	else{
-//		TRACE("[" << begin << "-" << end << "] CASE 5: other cases => no available location before or after edge sequence");
-		const uint32_t oldSize( _fwedges.size() );
-		const uint32_t oldNbEdges = end - begin;
-		// Move existing forward edges to the end of the adjacency array and make the previous locations dummy
-		for ( Edge_id it = begin ; it != end ; ++it ){
-			Edge_id nbEdges( _fwedges.size() );
-			_bwedges[ _fwedges[it].getSymEdge() ].setSymEdge( nbEdges );
-			_fwedges.emplace_back( std::move(_fwedges[it]) );
-			_fwedges[it].makeDummy();
-		}
-		// The new 'begin' and 'end' indices are set as oldsize and newsize+1
-		setNodeBeginFW( node , Edge_id(oldSize) );
-		insertId = _fwedges.size();
-		setNodeEndFW( node , Edge_id(_fwedges.size() + 1) );
-		// dummy edges are added at the end of the edge container to prepare some further edge insertions
-		const uint32_t nbDummies = 1 + std::max( oldNbEdges+3, uint32_t((1+oldNbEdges)*GROWTH_FACTOR) ) - (1+oldNbEdges);
-		for ( uint32_t i = 0 ; i < nbDummies ; ++i ){
-			_fwedges.emplace_back();
+	const uint32_t nbEdges( getNodeEndFW(node) == INVALID_EDGE_ID ? 0 : getNodeEndFW(node) - begin );
+	if( nbEdges == _fwCapacities[node] ){
+//		TRACE("Forward block of node N" << node << " is full (" << nbEdges << " edges) => relocation");
+		uint32_t capacity( 1 + std::max( nbEdges+3, uint32_t((1+nbEdges)*GROWTH_FACTOR) ) );
+		const Edge_id newBegin( allocateFwBlock(capacity) );
+		for ( uint32_t i = 0 ; i < nbEdges ; ++i ){
+			moveFwEdge( Edge_id(begin+i) , Edge_id(newBegin+i) );
+			reindexFwEdge( node , Edge_id(begin+i) , Edge_id(newBegin+i) );
+			clearFwEdge( Edge_id(begin+i) );
 		}
+		if( _fwCapacities[node] > 0 ){
+			releaseFwBlock( begin , _fwCapacities[node] );
+		}
+		begin = newBegin;
+		setNodeBeginFW( node , begin );
+		_fwCapacities[node] = capacity;
 	}
+	const Edge_id insertId( begin + nbEdges );
+	setNodeEndFW( node , Edge_id(insertId + 1) );
 //	TRACE("Insert a new FW edge at " << insertId);
 	return insertId;
 }
 
 /*
- * identifyBwInsertId(const std::vector<Edge>&, Node_id, Node_id) method: return id at which an edge can be inserted
+ * identifyBwInsertId(const Node_id&) method: return id at which a backward edge of the given node can be inserted
+ * the edge goes at the end of the node block; if the block is full (or if the node has no block yet), the node edges are first moved into a larger block
  */
 Edge_id Graph::identifyBwInsertId( const Node_id& node ){
 	Edge_id begin( getNodeBeginBW(node) );
-	Edge_id end( getNodeEndBW(node) );
-//	TRACE("Insert edge in the set " << begin << "-" << end);
-	Edge_id insertId(INVALID_EDGE_ID);
-	// Case 1:
-	if( end == INVALID_EDGE_ID ){
-//		TRACE("[" << begin << "-" << end << "] CASE 1: end id is invalid");
-		const uint32_t oldNbEdges = 0;
-		const uint32_t nbDummies = 1 + std::max( oldNbEdges+3, uint32_t((1+oldNbEdges)*GROWTH_FACTOR) ) - (1+oldNbEdges);
-		for ( uint32_t i = 0 ; i < nbDummies ; ++i ){
-			_bwedges.emplace_back();
-		}
-		setNodeBeginFW( node , Edge_id(_bwedges.size()) );
-		insertId = _bwedges.size();
-		setNodeEndFW( node , Edge_id(_bwedges.size() + 1) );
-	}
-	// Case 2:
-	else if( end == _bwedges.size() ){
-//		TRACE("[" << begin << "-" << end << "] CASE 2: end id is the last edge");
-		const uint32_t oldNbEdges = end - begin;
-		const uint32_t nbDummies = 1 + std::max( oldNbEdges+3, uint32_t((1+oldNbEdges)*GROWTH_FACTOR) ) - (1+oldNbEdges);
-		for ( uint32_t i = 0 ; i < nbDummies ; ++i ){
-			_bwedges.emplace_back();
-		}
-		insertId = end;
-		setNodeEndBW( node , Edge_id(end + 1) );
-	}
-	// Case 3:
-	else if( _bwedges[end].getOrigin() == INVALID_NODE_ID ){
-//		TRACE("[" << begin << "-" << end << "] CASE 3: origin node of the end edge is invalid => add an edge at the next free index");
-		insertId = end;
-		setNodeEndBW( node , Edge_id(end + 1) );
-	}
-	// Case 4:
-	else if( begin > 0 && _bwedges[begin - 1].getOrigin() == INVALID_NODE_ID ){
-//		TRACE("[" << begin << "-" << end << "] CASE 4: begin is strictly positive, and the origin node of begin-1 edge is invalid");
-		setNodeBeginBW( node , Edge_id(begin-1) );
-		insertId = begin-1;
-	}
-	// Case 5:
-	else{
-//		TRACE("[" << begin << "-" << end << "] CASE 5: other cases");
-		const uint32_t oldSize( _bwedges.size() );
-		const uint32_t oldNbEdges = end - begin;
-		for ( Edge_id it = begin ; it != end ; ++it ){
-			Edge_id nbEdges( _bwedges.size() );
-			_fwedges[ _bwedges[it].getSymEdge() ].setSymEdge( nbEdges );
-			_bwedges.emplace_back( std::move(_bwedges[it]) );
-			_bwedges[it].makeDummy();
-		}
-		setNodeBeginBW( node , Edge_id(oldSize) );
-		insertId = _bwedges.size();
-		setNodeEndBW( node , Edge_id(_bwedges.size() + 1) );
-		const uint32_t nbDummies = 1 + std::max( oldNbEdges+3, uint32_t((1+oldNbEdges)*GROWTH_FACTOR) ) - (1+oldNbEdges);
-		for ( uint32_t i = 0 ; i < nbDummies ; ++i ){
-			_bwedges.emplace_back();
+	const uint32_t nbEdges( getNodeEndBW(node) == INVALID_EDGE_ID ? 0 : getNodeEndBW(node) - begin );
+	if( nbEdges == _bwCapacities[node] ){
+//		TRACE("Backward block of node N" << node << " is full (" << nbEdges << " edges) => relocation");
+		uint32_t capacity( 1 + std::max( nbEdges+3, uint32_t((1+nbEdges)*GROWTH_FACTOR) ) );
+		const Edge_id newBegin( allocateBwBlock(capacity) );
+		for ( uint32_t i = 0 ; i < nbEdges ; ++i ){
+			moveBwEdge( Edge_id(begin+i) , Edge_id(newBegin+i) );
+			clearBwEdge( Edge_id(begin+i) );
+		}
+		if( _bwCapacities[node] > 0 ){
+			releaseBwBlock( begin , _bwCapacities[node] );
 		}
+		begin = newBegin;
+		setNodeBeginBW( node , begin );
+		_bwCapacities[node] = capacity;
 	}
+	const Edge_id insertId( begin + nbEdges );
+	setNodeEndBW( node , Edge_id(insertId + 1) );
 //	TRACE("Insert a new BW edge at " << insertId);
 	return insertId;
 }
@@ -353,24 +345,15 @@ Edge_id Graph::identifyBwInsertId( const Node_id& node ){
  * identifyFwEdge(const Node_id&, const Node_id&) method: if there is a forward edge between given source and destination, return its id (INVALID_EDGE_ID otherwise)
  */
 Edge_id Graph::identifyFwEdge(const Node_id& origin, const Node_id& destination){
-	for ( Edge_id e = getNodeBeginFW(origin) ; e != getNodeEndFW(origin) ; ++e ){
-		if ( _fwedges[e].getDestination() == destination ){
-			return e;
-		}
-	}
-	return INVALID_EDGE_ID;
+	return _fwIndex.find( origin , destination );
 }
 
 /*
  * identifyBwEdge(const Node_id&, const Node_id&) method: if there is a forward edge between given source and destination, return its id (INVALID_EDGE_ID otherwise)
  */
 Edge_id Graph::identifyBwEdge(const Node_id& origin, const Node_id& destination){
-	for ( Edge_id e = getNodeBeginBW(destination) ; e != getNodeEndBW(destination) ; ++e ){
-		if ( _bwedges[e].getOrigin() == origin ){
-			return e;
-		}
-	}
-	return INVALID_EDGE_ID;
+	const Edge_id fwe( _fwIndex.find( origin , destination ) );
+	return ( fwe == INVALID_EDGE_ID ) ? INVALID_EDGE_ID : _fwSymEdges[fwe];
 }
 
 /*
@@ -386,44 +369,399 @@ void Graph::deleteNode(const Node_id& u){
 	_specif.setNbEdges( _specif.getNbEdges() - nbDeletedEdges );
 	// Remove outgoing edges and their corresponding backward edges (begin by last ones, to avoid a permutation)
 	for ( Edge_id e_fw = getNodeBeginFW(u) ; e_fw != getNodeEndFW(u)  ; ++e_fw ) {
-		Node_id tgt = getFwEdges()[e_fw].getDestination();
+		Node_id tgt = _fwDestinations[e_fw];
 		Edge_id lastTargetEdge( _nodes[tgt].getEndBW() - 1 );
 		// If the symmetric edge is not the last one of the target node, shift it with the last one (to keep a coherent adjacency array, with dummy edges stored at the end)
-		Edge_id symEdge = getFwEdges()[e_fw].getSymEdge();
+		Edge_id symEdge = _fwSymEdges[e_fw];
 		if ( symEdge != lastTargetEdge ){
-			_bwedges[symEdge] = _bwedges[lastTargetEdge];
-			_fwedges[_bwedges[symEdge].getSymEdge()].setSymEdge(symEdge);
+			moveBwEdge(lastTargetEdge, symEdge);
 		}
 		// Delete the last target edge (corresponding to the symmetric edge of current one)
-		_bwedges[lastTargetEdge].makeDummy();
+		clearBwEdge(lastTargetEdge);
 		// Decrease bw edge counter for target node
-		_nodes[tgt].decreaseEndBW( );
+		_nodes[tgt].decreaseDegreeBW();
 		// Delete the current edge
-		_fwedges[e_fw].makeDummy();
+		unindexFwEdge(u, e_fw);
+		clearFwEdge(e_fw);
 	}
 	_nodes[u].setEndFW( getNodeBeginFW(u) );
 	// Remove incoming edges and their corresponding forward edges
 	for ( Edge_id e_bw = getNodeBeginBW(u) ; e_bw != getNodeEndBW(u) ; ++e_bw ){
-		Node_id src = _bwedges[e_bw].getOrigin();
+		Node_id src = _bwOrigins[e_bw];
 		Edge_id lastSourceEdge( _nodes[src].getEndFW() - 1 );
 		// If the symmetric edge is not the last one of the target node, shift it with the last one (to keep a coherent adjacency array, with dummy edges stored at the end)
-		Edge_id symEdge = getBwEdges()[e_bw].getSymEdge();
+		Edge_id symEdge = _bwSymEdges[e_bw];
+		unindexFwEdge(src, symEdge);
 		if ( symEdge != lastSourceEdge ){
-			_fwedges[symEdge] = std::move( _fwedges[lastSourceEdge] );
-			_bwedges[_fwedges[symEdge].getSymEdge()].setSymEdge(symEdge);
+			moveFwEdge(lastSourceEdge, symEdge);
+			reindexFwEdge(src, lastSourceEdge, symEdge);
 		}
 		// Delete the last source edge (corresponding to the symmetric edge of current one)
-		_fwedges[lastSourceEdge].makeDummy();
+		clearFwEdge(lastSourceEdge);
 		// Decrease fw edge counter for source node
-		_nodes[src].decreaseEndFW( );
+		_nodes[src].decreaseDegreeFW();
 		// Delete the current edge
-		_bwedges[e_bw].makeDummy();
+		clearBwEdge(e_bw);
 	}
 	// Set the current node indices so as begin and end iterators are equal (this node do not have any adjacent edge any more)
 	_nodes[u].setEndBW( getNodeBeginBW(u) );
+	// The node blocks only contain dummy edges now, they can be reused by other nodes
+	if( _fwCapacities[u] > 0 ){
+		releaseFwBlock( getNodeBeginFW(u) , _fwCapacities[u] );
+		_fwCapacities[u] = 0;
+	}
+	if( _bwCapacities[u] > 0 ){
+		releaseBwBlock( getNodeBeginBW(u) , _bwCapacities[u] );
+		_bwCapacities[u] = 0;
+	}
 //	TRACE("Node N" << u << ": bw edges = " << getNodeBeginBW(u) << "-" << getNodeEndBW(u) << "; fw edges: " << getNodeBeginFW(u) << "-" << getNodeEndFW(u));
 }
 
+/*
+ * deleteNodes(const std::vector<Node_id>&) method: delete the given nodes from the graph, and all their adjacent edges
+ * the nodes are expected to be pairwise non-adjacent (an independent set, as the nodes contracted at the same time): the edge blocks of the
+ * affected neighbours are then updated in one parallel pass, each neighbour block by one thread, with the same result as deleteNode() called
+ * for each node in the given order (removals are applied to each neighbour block in that order). Other node sets are deleted node by node.
+ */
+void Graph::deleteNodes(const std::vector<Node_id>& nodes){
+	const uint32_t nbNodes( nodes.size() );
+	// Check that the deleted nodes are pairwise non-adjacent (and not adjacent to themselves), and count their edges
+	std::vector<Node_id> sortedNodes( nodes );
+	std::sort( sortedNodes.begin() , sortedNodes.end() );
+	bool independent( std::adjacent_find( sortedNodes.begin() , sortedNodes.end() ) == sortedNodes.end() );
+	std::vector<uint32_t> fwOffsets( nbNodes + 1 , 0 ); // Forward edges of the deleted nodes, ie backward edges to remove from neighbour blocks
+	std::vector<uint32_t> bwOffsets( nbNodes + 1 , 0 ); // Backward edges of the deleted nodes, ie forward edges to remove from neighbour blocks
+#pragma omp parallel for schedule(dynamic, 64) reduction(&&:independent)
+	for ( uint32_t i = 0 ; i < nbNodes ; ++i ){
+		const Node_id u( nodes[i] );
+		fwOffsets[i+1] = _nodes[u].getDegreeFW();
+		bwOffsets[i+1] = _nodes[u].getDegreeBW();
+		for ( Edge_id e = getNodeBeginFW(u) ; e != getNodeEndFW(u) ; ++e ){
+			independent = independent && !std::binary_search( sortedNodes.begin() , sortedNodes.end() , _fwDestinations[e] );
+		}
+		for ( Edge_id e = getNodeBeginBW(u) ; e != getNodeEndBW(u) ; ++e ){
+			independent = independent && !std::binary_search( sortedNodes.begin() , sortedNodes.end() , _bwOrigins[e] );
+		}
+	}
+	if ( !independent ){
+		for ( const Node_id& u : nodes ){
+			deleteNode(u);
+		}
+		return;
+	}
+	std::partial_sum( fwOffsets.begin() , fwOffsets.end() , fwOffsets.begin() );
+	std::partial_sum( bwOffsets.begin() , bwOffsets.end() , bwOffsets.begin() );
+	// Update graph specification
+	_specif.setNbNodes( _specif.getNbNodes() - nbNodes );
+	_specif.setNbEdges( _specif.getNbEdges() - fwOffsets.back() - bwOffsets.back() );
+	/*
+	 * List the removals of each neighbour block, as (neighbour, edge of the deleted node) pairs: the symmetric edge to remove is only read
+	 * when the removal is applied, as previous removals in the same block may have moved it
+	 */
+	std::vector< std::pair<Node_id,Edge_id> > bwRemovals( fwOffsets.back() ); // (destination, forward edge): remove its backward edge
+	std::vector< std::pair<Node_id,Edge_id> > fwRemovals( bwOffsets.back() ); // (origin, backward edge): remove its forward edge
+#pragma omp parallel for schedule(dynamic, 64)
+	for ( uint32_t i = 0 ; i < nbNodes ; ++i ){
+		const Node_id u( nodes[i] );
+		for ( uint32_t k = 0 ; k < _nodes[u].getDegreeFW() ; ++k ){
+			const Edge_id e( getNodeBeginFW(u) + k );
+			bwRemovals[ fwOffsets[i] + k ] = std::make_pair( _fwDestinations[e] , e );
+		}
+		for ( uint32_t k = 0 ; k < _nodes[u].getDegreeBW() ; ++k ){
+			const Edge_id e( getNodeBeginBW(u) + k );
+			fwRemovals[ bwOffsets[i] + k ] = std::make_pair( _bwOrigins[e] , e );
+		}
+	}
+	auto byNeighbour = [](const std::pair<Node_id,Edge_id>& r1, const std::pair<Node_id,Edge_id>& r2) -> bool { return r1.first < r2.first; };
+	std::stable_sort( bwRemovals.begin() , bwRemovals.end() , byNeighbour );
+	std::stable_sort( fwRemovals.begin() , fwRemovals.end() , byNeighbour );
+	std::vector<uint32_t> bwGroups, fwGroups; // First removal of each neighbour block
+	for ( uint32_t r = 0 ; r < bwRemovals.size() ; ++r ){
+		if ( r == 0 || bwRemovals[r].first != bwRemovals[r-1].first ){
+			bwGroups.push_back(r);
+		}
+	}
+	bwGroups.push_back( bwRemovals.size() );
+	for ( uint32_t r = 0 ; r < fwRemovals.size() ; ++r ){
+		if ( r == 0 || fwRemovals[r].first != fwRemovals[r-1].first ){
+			fwGroups.push_back(r);
+		}
+	}
+	fwGroups.push_back( fwRemovals.size() );
+	/*
+	 * Remove backward edges from neighbour blocks: the last edge of the block fills the hole, its forward edge gets its new symmetric id
+	 * (forward edges do not move in this pass, and each one is updated by the thread of the block holding its backward edge)
+	 */
+#pragma omp parallel for schedule(dynamic, 64)
+	for ( uint32_t g = 0 ; g < bwGroups.size() - 1 ; ++g ){
+		const Node_id tgt( bwRemovals[ bwGroups[g] ].first );
+		for ( uint32_t r = bwGroups[g] ; r < bwGroups[g+1] ; ++r ){
+			const Edge_id symEdge( _fwSymEdges[ bwRemovals[r].second ] );
+			const Edge_id lastTargetEdge( getNodeEndBW(tgt) - 1 );
+			if ( symEdge != lastTargetEdge ){
+				moveBwEdge(lastTargetEdge, symEdge);
+			}
+			clearBwEdge(lastTargetEdge);
+			_nodes[tgt].decreaseDegreeBW();
+		}
+	}
+	/*
+	 * Remove forward edges from neighbour blocks, the same way (backward edges do not move in this pass); removed node pairs leave the edge index
+	 * first, index updates of moved edges are recorded as (moved edge destination, previous id, new id) and applied afterwards, as the index is
+	 * not shared between threads
+	 */
+	for ( const auto& removal : fwRemovals ){
+		_fwIndex.erase( removal.first , _fwDestinations[ _bwSymEdges[removal.second] ] );
+	}
+	std::vector< std::array<uint32_t,3> > moves( fwRemovals.size() , std::array<uint32_t,3>{{ INVALID_NODE_ID , INVALID_EDGE_ID , INVALID_EDGE_ID }} );
+#pragma omp parallel for schedule(dynamic, 64)
+	for ( uint32_t g = 0 ; g < fwGroups.size() - 1 ; ++g ){
+		const Node_id src( fwRemovals[ fwGroups[g] ].first );
+		for ( uint32_t r = fwGroups[g] ; r < fwGroups[g+1] ; ++r ){
+			const Edge_id symEdge( _bwSymEdges[ fwRemovals[r].second ] );
+			const Edge_id lastSourceEdge( getNodeEndFW(src) - 1 );
+			if ( symEdge != lastSourceEdge ){
+				moves[r] = std::array<uint32_t,3>{{ _fwDestinations[lastSourceEdge] , lastSourceEdge , symEdge }};
+				moveFwEdge(lastSourceEdge, symEdge);
+			}
+			clearFwEdge(lastSourceEdge);
+			_nodes[src].decreaseDegreeFW();
+		}
+	}
+	// Update the edge index: moved edges keep their entry
+	for ( uint32_t r = 0 ; r < fwRemovals.size() ; ++r ){
+		const Node_id src( fwRemovals[r].first );
+		if ( moves[r][1] != INVALID_EDGE_ID && _fwIndex.find( src , Node_id(moves[r][0]) ) == moves[r][1] ){
+			_fwIndex.set( src , Node_id(moves[r][0]) , Edge_id(moves[r][2]) );
+		}
+	}
+	// Empty the blocks of the deleted nodes, that can be reused by other nodes
+	for ( const Node_id& u : nodes ){
+		for ( Edge_id e = getNodeBeginFW(u) ; e != getNodeEndFW(u) ; ++e ){
+			_fwIndex.erase( u , _fwDestinations[e] );
+			clearFwEdge(e);
+		}
+		for ( Edge_id e = getNodeBeginBW(u) ; e != getNodeEndBW(u) ; ++e ){
+			clearBwEdge(e);
+		}
+		_nodes[u].setEndFW( getNodeBeginFW(u) );
+		_nodes[u].setEndBW( getNodeBeginBW(u) );
+		if( _fwCapacities[u] > 0 ){
+			releaseFwBlock( getNodeBeginFW(u) , _fwCapacities[u] );
+			_fwCapacities[u] = 0;
+		}
+		if( _bwCapacities[u] > 0 ){
+			releaseBwBlock( getNodeBeginBW(u) , _bwCapacities[u] );
+			_bwCapacities[u] = 0;
+		}
+	}
+}
+
+/*
+ * initialCapacity(const uint32_t&) method: return the size of the block given at construction to a node with <nbEdges> edges,
+ * ie its edges followed by max(#edges+2;1.5#edges) dummy edges, kept for further additional edges (shortcuts)
+ */
+uint32_t Graph::initialCapacity(const uint32_t& nbEdges){
+	return nbEdges + std::max( nbEdges + 2 , uint32_t(double(nbEdges) * GROWTH_FACTOR) );
+}
+
+/*
+ * appendFwEdge() method: add a dummy edge slot at the end of the forward arrays
+ */
+void Graph::appendFwEdge(){
+	_fwDestinations.push_back( INVALID_NODE_ID );
+	_fwWeights.push_back( WeightDictionary::DEFAULT_WEIGHT_ID );
+	_fwSymEdges.push_back( INVALID_EDGE_ID );
+	_fwMiddleNodes.push_back( INVALID_NODE_ID );
+	_fwComplexities.push_back( 0 );
+	_fwNbOriginalEdges.push_back( 1 );
+}
+
+/*
+ * appendBwEdge() method: add a dummy edge slot at the end of the backward arrays
+ */
+void Graph::appendBwEdge(){
+	_bwOrigins.push_back( INVALID_NODE_ID );
+	_bwWeights.push_back( WeightDictionary::DEFAULT_WEIGHT_ID );
+	_bwSymEdges.push_back( INVALID_EDGE_ID );
+}
+
+/*
+ * storeEdge(const Edge_id&, const Edge_id&, const Edge&) method: write both copies of an edge, at forward slot <fwe> and backward slot <bwe>
+ * both copies refer to the same weight of the dictionary, the shortcut data being stored with the forward copy
+ */
+void Graph::storeEdge(const Edge_id& fwe, const Edge_id& bwe, const Edge& edge){
+	_fwDestinations[fwe] = edge.getDestination();
+	_fwWeights[fwe] = edge.getWeightId();
+	_fwSymEdges[fwe] = bwe;
+	_fwMiddleNodes[fwe] = edge.getMiddleNode();
+	_fwComplexities[fwe] = edge.getComplexity();
+	_fwNbOriginalEdges[fwe] = edge.getNbOriginalEdge();
+	_bwOrigins[bwe] = edge.getOrigin();
+	_bwWeights[bwe] = edge.getWeightId();
+	_bwSymEdges[bwe] = fwe;
+}
+
+/*
+ * moveFwEdge(const Edge_id&, const Edge_id&) method: move a forward edge from slot <from> to slot <to>, its backward edge gets its new symmetric id
+ */
+void Graph::moveFwEdge(const Edge_id& from, const Edge_id& to){
+	_fwDestinations[to] = _fwDestinations[from];
+	_fwWeights[to] = _fwWeights[from];
+	_fwSymEdges[to] = _fwSymEdges[from];
+	_fwMiddleNodes[to] = _fwMiddleNodes[from];
+	_fwComplexities[to] = _fwComplexities[from];
+	_fwNbOriginalEdges[to] = _fwNbOriginalEdges[from];
+	_bwSymEdges[ _fwSymEdges[to] ] = to;
+}
+
+/*
+ * moveBwEdge(const Edge_id&, const Edge_id&) method: move a backward edge from slot <from> to slot <to>, its forward edge gets its new symmetric id
+ */
+void Graph::moveBwEdge(const Edge_id& from, const Edge_id& to){
+	_bwOrigins[to] = _bwOrigins[from];
+	_bwWeights[to] = _bwWeights[from];
+	_bwSymEdges[to] = _bwSymEdges[from];
+	_fwSymEdges[ _bwSymEdges[to] ] = to;
+}
+
+/*
+ * clearFwEdge(const Edge_id&) method: make a forward edge slot dummy
+ */
+void Graph::clearFwEdge(const Edge_id& e){
+	_fwDestinations[e] = INVALID_NODE_ID;
+	_fwWeights[e] = WeightDictionary::DEFAULT_WEIGHT_ID;
+	_fwSymEdges[e] = INVALID_EDGE_ID;
+	_fwMiddleNodes[e] = INVALID_NODE_ID;
+	_fwComplexities[e] = 0;
+	_fwNbOriginalEdges[e] = 1;
+}
+
+/*
+ * clearBwEdge(const Edge_id&) method: make a backward edge slot dummy
+ */
+void Graph::clearBwEdge(const Edge_id& e){
+	_bwOrigins[e] = INVALID_NODE_ID;
+	_bwWeights[e] = WeightDictionary::DEFAULT_WEIGHT_ID;
+	_bwSymEdges[e] = INVALID_EDGE_ID;
+}
+
+/*
+ * shareFwWeight(const Edge_id&) method: give the weight id of a forward edge to its symmetric backward edge
+ * both copies of an edge refer to the same weight of the dictionary, a weight update is therefore computed once
+ */
+void Graph::shareFwWeight(const Edge_id& e){
+	if( _fwSymEdges[e] != INVALID_EDGE_ID ){
+		_bwWeights[ _fwSymEdges[e] ] = _fwWeights[e];
+	}
+}
+
+/*
+ * shareBwWeight(const Edge_id&) method: give the weight id of a backward edge to its symmetric forward edge
+ */
+void Graph::shareBwWeight(const Edge_id& e){
+	if( _bwSymEdges[e] != INVALID_EDGE_ID ){
+		_fwWeights[ _bwSymEdges[e] ] = _bwWeights[e];
+	}
+}
+
+/*
+ * aggregateWeight(const Weight_id&, const Edge&) method: return the id of the aggregation of a stored weight with the candidate edge weight (see Edge::aggregate)
+ */
+Weight_id Graph::aggregateWeight(const Weight_id& weight, const Edge& candidateEdge){
+	Edge edge;
+	edge.setWeightId( weight );
+	edge.aggregate( candidateEdge );
+	return edge.getWeightId();
+}
+
+/*
+ * unindexFwEdge(const Node_id&, const Edge_id&) method: remove a forward edge of <origin> that is about to be deleted or overwritten from the edge index
+ * if the index refers to this edge and if the origin has a parallel edge (same destination), the parallel edge takes its place
+ */
+void Graph::unindexFwEdge(const Node_id& origin, const Edge_id& e){
+	const Node_id destination( _fwDestinations[e] );
+	if( _fwIndex.find( origin , destination ) != e ){
+		return;
+	}
+	for ( Edge_id f = getNodeBeginFW(origin) ; f != getNodeEndFW(origin) ; ++f ){
+		if ( f != e && _fwDestinations[f] == destination ){
+			_fwIndex.set( origin , destination , f );
+			return;
+		}
+	}
+	_fwIndex.erase( origin , destination );
+}
+
+/*
+ * reindexFwEdge(const Node_id&, const Edge_id&, const Edge_id&) method: update the edge index after a forward edge of <origin> has been moved from <from> to <to>
+ */
+void Graph::reindexFwEdge(const Node_id& origin, const Edge_id& from, const Edge_id& to){
+	if( _fwIndex.find( origin , _fwDestinations[to] ) == from ){
+		_fwIndex.set( origin , _fwDestinations[to] , to );
+	}
+}
+
+/*
+ * allocateFwBlock(uint32_t&) method: return the first id of a block of at least <capacity> dummy forward edges, and set <capacity> as its actual size
+ * the smallest released block that is large enough is reused (and split if it is at least twice too large), otherwise the block is added at the end of the container
+ */
+Edge_id Graph::allocateFwBlock(uint32_t& capacity){
+	auto itb = _fwFreeBlocks.lower_bound( capacity );
+	if( itb == _fwFreeBlocks.end() ){
+		const Edge_id begin( _fwDestinations.size() );
+		for ( uint32_t i = 0 ; i < capacity ; ++i ){
+			appendFwEdge();
+		}
+		return begin;
+	}
+	const uint32_t blockCapacity( itb->first );
+	const Edge_id begin( itb->second );
+	_fwFreeBlocks.erase( itb );
+	if( blockCapacity >= 2 * capacity ){
+		releaseFwBlock( Edge_id(begin + capacity) , blockCapacity - capacity );
+	}
+	else{
+		capacity = blockCapacity;
+	}
+	return begin;
+}
+
+/*
+ * allocateBwBlock(uint32_t&) method: return the first id of a block of at least <capacity> dummy backward edges, and set <capacity> as its actual size
+ * the smallest released block that is large enough is reused (and split if it is at least twice too large), otherwise the block is added at the end of the container
+ */
+Edge_id Graph::allocateBwBlock(uint32_t& capacity){
+	auto itb = _bwFreeBlocks.lower_bound( capacity );
+	if( itb == _bwFreeBlocks.end() ){
+		const Edge_id begin( _bwOrigins.size() );
+		for ( uint32_t i = 0 ; i < capacity ; ++i ){
+			appendBwEdge();
+		}
+		return begin;
+	}
+	const uint32_t blockCapacity( itb->first );
+	const Edge_id begin( itb->second );
+	_bwFreeBlocks.erase( itb );
+	if( blockCapacity >= 2 * capacity ){
+		releaseBwBlock( Edge_id(begin + capacity) , blockCapacity - capacity );
+	}
+	else{
+		capacity = blockCapacity;
+	}
+	return begin;
+}
+
+/*
+ * releaseFwBlock(const Edge_id&, const uint32_t&) method: give back a block of dummy forward edges, so that it can be reused by another node
+ */
+void Graph::releaseFwBlock(const Edge_id& begin, const uint32_t& capacity){ _fwFreeBlocks.insert( std::make_pair( capacity , begin ) ); }
+
+/*
+ * releaseBwBlock(const Edge_id&, const uint32_t&) method: give back a block of dummy backward edges, so that it can be reused by another node
+ */
+void Graph::releaseBwBlock(const Edge_id& begin, const uint32_t& capacity){ _bwFreeBlocks.insert( std::make_pair( capacity , begin ) ); }
+
 /*
  * reset() method: reset the graph (goes back to initial state before node hierarchy building)
  * reset the node levels (they are set as the node ids) and delete the shortcuts
@@ -465,17 +803,16 @@ std::ostream& operator<<(std::ostream& os, Graph& graph){
 		os << "\n";
 	}
 	// Part 3: Edges printing
-	TRACE("Backward edge printing... (" << graph._bwedges.end() - graph._bwedges.begin() << " edges)");
-	std::vector<Edge>::iterator ite = graph._bwedges.begin(), itebeg = graph._bwedges.begin();
-	for( ; ite < graph._bwedges.end() ; ++ite){
-		os << "E" << ite - itebeg << "[BW]<E" << ite->getSymEdge() << "[FW]> {";
-		os << *ite;
+	TRACE("Backward edge printing... (" << graph._bwOrigins.size() << " edges)");
+	for(Edge_id e(0) ; e < graph._bwOrigins.size() ; ++e){
+		os << "E" << e << "[BW]<E" << graph._bwSymEdges[e] << "[FW]> {";
+		os << graph.getBwEdge(e);
 		os << "}\n";
 	}
-	TRACE("Forward edge printing... (" << graph._fwedges.end() - graph._fwedges.begin() << " edges)");
-	for(ite = graph._fwedges.begin() ; ite < graph._fwedges.end() ; ++ite){
-		os << "E" << ite - graph._fwedges.begin() << "[FW]<E" << ite->getSymEdge() << "[BW]> {";
-		os << *ite;
+	TRACE("Forward edge printing... (" << graph._fwDestinations.size() << " edges)");
+	for(Edge_id e(0) ; e < graph._fwDestinations.size() ; ++e){
+		os << "E" << e << "[FW]<E" << graph._fwSymEdges[e] << "[BW]> {";
+		os << graph.getFwEdge(e);
 		os << "}\n";
 	}
 	// Part 3: Hierarchy printing
@@ -493,3 +830,186 @@ std::ostream& operator<<(std::ostream& os, Graph& graph){
 	os << "*****************************\n";
 	return os;
 }
+
+/*
+ * updateWeightIds(const std::function<void(Weight_id&)>&) method: call the given visitor on the weight id of each forward then backward edge slot
+ * (dummy slots included), that it may replace
+ */
+void Graph::updateWeightIds(const std::function<void(Weight_id&)>& visitor){
+	for(Weight_id& id: _fwWeights){
+		visitor( id );
+	}
+	for(Weight_id& id: _bwWeights){
+		visitor( id );
+	}
+}
+
+/*
+ * writeCheckpoint(CheckpointIO&) method: add the whole graph state to the given snapshot
+ * the edge index is written as the list of indexed forward edges, released blocks in their order in the free block maps
+ */
+void Graph::writeCheckpoint(CheckpointIO& checkpoint) const {
+	checkpoint.put( _specif.getNbPts() );
+	checkpoint.put( _specif.getDelta() );
+	checkpoint.put( _specif.getNbNodes() ); // Remaining nodes and edges
+	checkpoint.put( _specif.getNbEdges() );
+	std::vector<Node_id> originalIds( _nodes.size() );
+	std::vector<uint32_t> nodeRanges; // First forward edge, forward degree, first backward edge and backward degree of each node
+	nodeRanges.reserve( 4 * _nodes.size() );
+	for(uint32_t n(0) ; n < _nodes.size() ; ++n){
+		originalIds[n] = _permutation.toOriginal( Node_id(n) );
+		nodeRanges.push_back( _nodes[n].getBeginFW() );
+		nodeRanges.push_back( _nodes[n].getDegreeFW() );
+		nodeRanges.push_back( _nodes[n].getBeginBW() );
+		nodeRanges.push_back( _nodes[n].getDegreeBW() );
+	}
+	checkpoint.put( originalIds );
+	checkpoint.put( nodeRanges );
+	checkpoint.put( _fwDestinations );
+	checkpoint.putWeights( _fwWeights );
+	checkpoint.put( _fwSymEdges );
+	checkpoint.put( _fwMiddleNodes );
+	checkpoint.put( _fwComplexities );
+	checkpoint.put( _fwNbOriginalEdges );
+	checkpoint.put( _bwOrigins );
+	checkpoint.putWeights( _bwWeights );
+	checkpoint.put( _bwSymEdges );
+	checkpoint.put( _fwCapacities );
+	checkpoint.put( _bwCapacities );
+	for(const auto* freeBlocks: { &_fwFreeBlocks , &_bwFreeBlocks }){
+		std::vector<uint32_t> blocks; // Size and first edge of each released block
+		for(const auto& block: *freeBlocks){
+			blocks.push_back( block.first );
+			blocks.push_back( block.second );
+		}
+		checkpoint.put( blocks );
+	}
+	std::vector<Edge_id> indexedEdges;
+	for(Edge_id e(0) ; e < _fwDestinations.size() ; ++e){
+		if( _fwSymEdges[e] != INVALID_EDGE_ID && _fwIndex.find( _bwOrigins[ _fwSymEdges[e] ] , _fwDestinations[e] ) == e ){
+			indexedEdges.push_back(e);
+		}
+	}
+	checkpoint.put( indexedEdges );
+	checkpoint.put( _levels );
+	checkpoint.put( _sortednodes );
+}
+
+/*
+ * readCheckpoint(CheckpointIO&) method: restore the graph state from the given snapshot (read into local containers first, that replace
+ * the graph ones only if the whole state is valid)
+ */
+bool Graph::readCheckpoint(CheckpointIO& checkpoint){
+	uint32_t nbPts(0), delta(0), nbRemainingNodes(0), nbRemainingEdges(0);
+	std::vector<Node_id> originalIds, sortednodes;
+	std::vector<uint32_t> nodeRanges, fwComplexities, fwNbOriginalEdges, fwCapacities, bwCapacities, fwBlocks, bwBlocks, levels;
+	std::vector<Node_id> fwDestinations, fwMiddleNodes, bwOrigins;
+	std::vector<Weight_id> fwWeights, bwWeights;
+	std::vector<Edge_id> fwSymEdges, bwSymEdges, indexedEdges;
+	bool valid( checkpoint.get(nbPts) && checkpoint.get(delta) && checkpoint.get(nbRemainingNodes) && checkpoint.get(nbRemainingEdges) && checkpoint.get(originalIds) && checkpoint.get(nodeRanges)
+			&& checkpoint.get(fwDestinations) && checkpoint.getWeights(fwWeights) && checkpoint.get(fwSymEdges) && checkpoint.get(fwMiddleNodes)
+			&& checkpoint.get(fwComplexities) && checkpoint.get(fwNbOriginalEdges) && checkpoint.get(bwOrigins) && checkpoint.getWeights(bwWeights) && checkpoint.get(bwSymEdges)
+			&& checkpoint.get(fwCapacities) && checkpoint.get(bwCapacities) && checkpoint.get(fwBlocks) && checkpoint.get(bwBlocks) && checkpoint.get(indexedEdges)
+			&& checkpoint.get(levels) && checkpoint.get(sortednodes) );
+	const size_t nbNodes( _nodes.size() );
+	const size_t nbFwSlots( fwDestinations.size() ), nbBwSlots( bwOrigins.size() );
+	valid = valid && nbPts == _specif.getNbPts() && delta == _specif.getDelta() && nbRemainingNodes <= nbNodes && originalIds.size() == nbNodes
+			&& NodePermutation::isPermutation(originalIds) && nodeRanges.size() == 4 * nbNodes
+			&& fwWeights.size() == nbFwSlots && fwSymEdges.size() == nbFwSlots && fwMiddleNodes.size() == nbFwSlots && fwComplexities.size() == nbFwSlots
+			&& fwNbOriginalEdges.size() == nbFwSlots && bwWeights.size() == nbBwSlots && bwSymEdges.size() == nbBwSlots
+			&& fwCapacities.size() == nbNodes && bwCapacities.size() == nbNodes && levels.size() == nbNodes && sortednodes.size() == nbNodes;
+	// Node ranges and released blocks must lie in the edge arrays (a node without edges may have no first edge)
+	for(size_t n(0) ; valid && n < nbNodes ; ++n){
+		valid = ( nodeRanges[4*n+1] == 0 || uint64_t(nodeRanges[4*n]) + nodeRanges[4*n+1] <= nbFwSlots )
+				&& ( nodeRanges[4*n+3] == 0 || uint64_t(nodeRanges[4*n+2]) + nodeRanges[4*n+3] <= nbBwSlots );
+	}
+	for(size_t b(0) ; valid && b + 1 < fwBlocks.size() ; b += 2){
+		valid = uint64_t(fwBlocks[b+1]) + fwBlocks[b] <= nbFwSlots;
+	}
+	for(size_t b(0) ; valid && b + 1 < bwBlocks.size() ; b += 2){
+		valid = uint64_t(bwBlocks[b+1]) + bwBlocks[b] <= nbBwSlots;
+	}
+	// Both copies of each edge must refer to each other, and their nodes must exist
+	for(size_t e(0) ; valid && e < nbFwSlots ; ++e){
+		valid = fwSymEdges[e] == INVALID_EDGE_ID || ( fwDestinations[e] < nbNodes && ( fwMiddleNodes[e] < nbNodes || fwMiddleNodes[e] == INVALID_NODE_ID ) );
+	}
+	for(size_t e(0) ; valid && e < nbBwSlots ; ++e){
+		valid = bwSymEdges[e] == INVALID_EDGE_ID || bwOrigins[e] < nbNodes;
+	}
+	for(size_t e(0) ; valid && e < nbFwSlots ; ++e){
+		valid = fwSymEdges[e] == INVALID_EDGE_ID || ( fwSymEdges[e] < nbBwSlots && bwSymEdges[ fwSymEdges[e] ] == e );
+	}
+	for(size_t e(0) ; valid && e < nbBwSlots ; ++e){
+		valid = bwSymEdges[e] == INVALID_EDGE_ID || ( bwSymEdges[e] < nbFwSlots && fwSymEdges[ bwSymEdges[e] ] == e );
+	}
+	for(const Edge_id& e: indexedEdges){
+		valid = valid && e < nbFwSlots && fwSymEdges[e] != INVALID_EDGE_ID;
+	}
+	if( !valid ){
+		ERROR("Checkpoint does not hold a graph of this instance.\n");
+		return false;
+	}
+	_specif.setNbNodes( nbRemainingNodes );
+	_specif.setNbEdges( nbRemainingEdges );
+	_permutation = NodePermutation( originalIds );
+	for(uint32_t n(0) ; n < nbNodes ; ++n){
+		_nodes[n].setBeginFW( Edge_id(nodeRanges[4*n]) );
+		_nodes[n].setEndFW( Edge_id(nodeRanges[4*n] + nodeRanges[4*n+1]) );
+		_nodes[n].setBeginBW( Edge_id(nodeRanges[4*n+2]) );
+		_nodes[n].setEndBW( Edge_id(nodeRanges[4*n+2] + nodeRanges[4*n+3]) );
+	}
+	_fwDestinations.swap( fwDestinations );
+	_fwWeights.swap( fwWeights );
+	_fwSymEdges.swap( fwSymEdges );
+	_fwMiddleNodes.swap( fwMiddleNodes );
+	_fwComplexities.swap( fwComplexities );
+	_fwNbOriginalEdges.swap( fwNbOriginalEdges );
+	_bwOrigins.swap( bwOrigins );
+	_bwWeights.swap( bwWeights );
+	_bwSymEdges.swap( bwSymEdges );
+	_fwCapacities.swap( fwCapacities );
+	_bwCapacities.swap( bwCapacities );
+	_fwFreeBlocks.clear();
+	for(size_t b(0) ; b + 1 < fwBlocks.size() ; b += 2){
+		_fwFreeBlocks.insert( _fwFreeBlocks.end() , std::make_pair( fwBlocks[b] , Edge_id(fwBlocks[b+1]) ) );
+	}
+	_bwFreeBlocks.clear();
+	for(size_t b(0) ; b + 1 < bwBlocks.size() ; b += 2){
+		_bwFreeBlocks.insert( _bwFreeBlocks.end() , std::make_pair( bwBlocks[b] , Edge_id(bwBlocks[b+1]) ) );
+	}
+	_fwIndex.clear();
+	_fwIndex.reserve( indexedEdges.size() );
+	for(const Edge_id& e: indexedEdges){
+		_fwIndex.set( _bwOrigins[ _fwSymEdges[e] ] , _fwDestinations[e] , e );
+	}
+	_levels.swap( levels );
+	_sortednodes.swap( sortednodes );
+	return true;
+}
+
+/*
+ * memoryFootprint() method: return the memory held by the graph: node data, topology (adjacency and shortcut arrays), weight ids, dummy padding, edge blocks and edge index
+ * topology and weight ids count the slots of the edges of the nodes, dummy padding the other slots of the edge arrays (free space of the node
+ * blocks, released blocks and reserved capacity); the weights themselves are stored once in the weight dictionary (see WeightDictionary)
+ */
+MemoryFootprint Graph::memoryFootprint() const {
+	MemoryFootprint footprint("Graph");
+	uint64_t nbFwSlots(0), nbBwSlots(0); // Number of slots used by the edges of the nodes
+	for(const Node& node: _nodes){
+		nbFwSlots += node.getDegreeFW();
+		nbBwSlots += node.getDegreeBW();
+	}
+	const size_t topologyBytes( nbFwSlots * ( sizeof(Node_id) + sizeof(Edge_id) + sizeof(Node_id) + 2 * sizeof(uint32_t) ) + nbBwSlots * ( sizeof(Node_id) + sizeof(Edge_id) ) );
+	const size_t weightBytes( ( nbFwSlots + nbBwSlots ) * sizeof(Weight_id) );
+	const size_t edgeBytes( MemoryFootprint::bytes(_fwDestinations) + MemoryFootprint::bytes(_fwWeights) + MemoryFootprint::bytes(_fwSymEdges)
+			+ MemoryFootprint::bytes(_fwMiddleNodes) + MemoryFootprint::bytes(_fwComplexities) + MemoryFootprint::bytes(_fwNbOriginalEdges)
+			+ MemoryFootprint::bytes(_bwOrigins) + MemoryFootprint::bytes(_bwWeights) + MemoryFootprint::bytes(_bwSymEdges) );
+	footprint.add("nodes", MemoryFootprint::bytes(_nodes) + MemoryFootprint::bytes(_levels) + MemoryFootprint::bytes(_sortednodes) + _permutation.getMemorySize());
+	footprint.add("topology", topologyBytes);
+	footprint.add("weight ids", weightBytes);
+	footprint.add("dummy padding", edgeBytes - topologyBytes - weightBytes);
+	footprint.add("edge blocks", MemoryFootprint::bytes(_fwCapacities) + MemoryFootprint::bytes(_bwCapacities)
+			+ MemoryFootprint::bytes(_fwFreeBlocks) + MemoryFootprint::bytes(_bwFreeBlocks));
+	footprint.add("edge index", _fwIndex.getMemorySize());
+	return footprint;
+}
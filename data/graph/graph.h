@@ -9,15 +9,21 @@
 #define DATA_GRAPH_H_
 
 #include <chrono>
+#include <functional>
+#include <map>
 #include <omp.h> // Parallel computing commands
 
 #include "edge.h"
+#include "edgeindex.h"
+#include "memoryfootprint.h"
 #include "node.h"
+#include "nodepermutation.h"
 #include "../../data_io/graphreader.h"
 #include "../../data_io/specifreader.h"
 
 class LocalThread; // Forward class declaration: Graph structures has a vector of LocalThread pointers as an attribute
 class WitnessCache;
+class CheckpointIO;
 
 class Graph{
 public:
@@ -27,6 +33,7 @@ public:
 
 	Graph();
 	Graph(GraphReader graphdata, const Specif& specif);
+	Graph(GraphReader graphdata, const Specif& specif, const NodePermutation& permutation);
 
 //	Graph(const Graph&) = delete;
 //	Graph& operator= (const Graph&) = delete;
@@ -41,20 +48,29 @@ public:
 	/*
 	 * Getters
 	 */
-	Specif getSpecif() const;
+	const Specif& getSpecif() const;
+	const NodePermutation& getPermutation() const;
 	uint32_t getNbNodes() const;
 	uint32_t getNbEdges() const;
 	uint32_t getNbPtss() const;
 	uint32_t getDelta() const;
-	std::vector<Node> getNodes() const;
-	Node getNode(const Node_id& n) const;
-	std::vector<Edge> getFwEdges() const;
+	const std::vector<Node>& getNodes() const;
+	const Node& getNode(const Node_id& n) const;
 	Edge getFwEdge(const Edge_id& e) const;
-	std::vector<Edge> getBwEdges() const;
 	Edge getBwEdge(const Edge_id& e) const;
-	std::vector<Node_id> getSortedNodes() const;
+	Node_id getFwDestination(const Edge_id& e) const;
+	Node_id getBwOrigin(const Edge_id& e) const;
+	Weight_id getFwWeightId(const Edge_id& e) const;
+	Weight_id getBwWeightId(const Edge_id& e) const;
+	WeightView getFwWeight(const Edge_id& e) const;
+	WeightView getBwWeight(const Edge_id& e) const;
+	Node_id getFwMiddleNode(const Edge_id& e) const;
+	Node_id getBwMiddleNode(const Edge_id& e) const;
+	uint32_t getFwNbOriginalEdge(const Edge_id& e) const;
+	uint32_t getBwNbOriginalEdge(const Edge_id& e) const;
+	const std::vector<Node_id>& getSortedNodes() const;
 	Node_id getSortedNode(const uint32_t& index) const;
-	std::vector<uint32_t> getLevels() const;
+	const std::vector<uint32_t>& getLevels() const;
 	uint32_t getLevel(const uint32_t& index) const;
     Edge_id getNodeBeginBW(Node_id tgt) const;
     Edge_id getNodeEndBW(Node_id tgt) const;
@@ -74,19 +90,20 @@ public:
     void setNodeBeginFW(const Node_id src, const Edge_id& e);
     void setNodeEndFW(const Node_id src, const Edge_id& e);
     void setHierarchy(const std::string& hierarchyFileName);
+    void setHierarchy(const std::vector<Node_id>& sortedNodes, const std::vector<uint32_t>& levels);
 
     /*
-     * aggregateEdge(const Edge_id&, const Edge&) method: aggregate forward edge at given index with candidate edge
+     * aggregateEdge(const Edge_id&, const Edge&) method: aggregate forward edge at given index with candidate edge, the backward edge gets the same weight
      */
     void updateEdgeInfo(const Edge_id& fwe, const Edge_id& bwe, const Edge& candidateEdge);
 
     /*
-     * aggregateFwEdge(const Edge_id&, const Edge&) method: aggregate forward edge at given index with candidate edge
+     * aggregateFwEdge(const Edge_id&, const Edge&) method: aggregate forward edge at given index with candidate edge (its symmetric edge gets the same weight)
      */
     void aggregateFwEdge(const Edge_id& e, const Edge& candidateEdge);
 
     /*
-     * aggregateBwEdge(const Edge_id&, const Edge&) method: aggregate backward edge at given index with candidate edge
+     * aggregateBwEdge(const Edge_id&, const Edge&) method: aggregate backward edge at given index with candidate edge (its symmetric edge gets the same weight)
      */
     void aggregateBwEdge(const Edge_id& e, const Edge& candidateEdge);
 
@@ -96,12 +113,12 @@ public:
     void addShortcut(Edge&& edge);
 
     /*
-     * identifyInsertId(const std::vector<Edge>&, Node_id, Node_id) method: return id at which a forward edge can be inserted
+     * identifyFwInsertId(const Node_id&) method: return id at which a forward edge of the given node can be inserted
      */
     Edge_id identifyFwInsertId(const Node_id& node);
 
     /*
-     * identifyInsertId(const std::vector<Edge>&, Node_id, Node_id) method: return id at which a backward edge can be inserted
+     * identifyBwInsertId(const Node_id&) method: return id at which a backward edge of the given node can be inserted
      */
     Edge_id identifyBwInsertId(const Node_id& node);
 
@@ -120,6 +137,12 @@ public:
      */
     void deleteNode(const Node_id& u);
 
+    /*
+     * deleteNodes(const std::vector<Node_id>&) method: delete the given nodes (an independent set) from the graph, and all their adjacent edges,
+     * updating the affected neighbours in one parallel pass
+     */
+    void deleteNodes(const std::vector<Node_id>& nodes);
+
     /*
      * reset() method: reset the graph (goes back to initial state before node hierarchy building)
      * reset the node levels (they are set as the node ids) and delete the shortcuts
@@ -139,15 +162,141 @@ public:
 	 */
     friend std::ostream& operator<<(std::ostream& os, Graph& graph);
 
+	/*
+	 * updateWeightIds(const std::function<void(Weight_id&)>&) method: call the given visitor on the weight id of each edge slot, that it may
+	 * replace (see WeightDictionary::compact())
+	 */
+	void updateWeightIds(const std::function<void(Weight_id&)>& visitor);
+
+	/*
+	 * writeCheckpoint(CheckpointIO&) method: add the whole graph state (topology, weights, edge blocks and index, hierarchy) to the given snapshot
+	 */
+	void writeCheckpoint(CheckpointIO& checkpoint) const;
+
+	/*
+	 * readCheckpoint(CheckpointIO&) method: restore the graph state from the given snapshot, return false (the graph being unchanged) if the
+	 * snapshot does not hold a valid state of a graph of the same instance
+	 */
+	bool readCheckpoint(CheckpointIO& checkpoint);
+
+	/*
+	 * memoryFootprint() method: return the memory held by the graph: node data, topology (adjacency and shortcut arrays), weight ids, dummy padding, edge blocks and edge index
+	 */
+	MemoryFootprint memoryFootprint() const;
+
 private:
 
+	/*
+	 * initialCapacity(const uint32_t&) method: return the size of the block given at construction to a node with <nbEdges> edges,
+	 * ie its edges followed by max(#edges+2;1.5#edges) dummy edges, kept for further additional edges (shortcuts)
+	 */
+	static uint32_t initialCapacity(const uint32_t& nbEdges);
+
+	/*
+	 * appendFwEdge() method: add a dummy edge slot at the end of the forward arrays
+	 */
+	void appendFwEdge();
+
+	/*
+	 * appendBwEdge() method: add a dummy edge slot at the end of the backward arrays
+	 */
+	void appendBwEdge();
+
+	/*
+	 * storeEdge(const Edge_id&, const Edge_id&, const Edge&) method: write both copies of an edge, at forward slot <fwe> and backward slot <bwe>
+	 */
+	void storeEdge(const Edge_id& fwe, const Edge_id& bwe, const Edge& edge);
+
+	/*
+	 * moveFwEdge(const Edge_id&, const Edge_id&) method: move a forward edge from slot <from> to slot <to>, its backward edge gets its new symmetric id
+	 */
+	void moveFwEdge(const Edge_id& from, const Edge_id& to);
+
+	/*
+	 * moveBwEdge(const Edge_id&, const Edge_id&) method: move a backward edge from slot <from> to slot <to>, its forward edge gets its new symmetric id
+	 */
+	void moveBwEdge(const Edge_id& from, const Edge_id& to);
+
+	/*
+	 * clearFwEdge(const Edge_id&) method: make a forward edge slot dummy
+	 */
+	void clearFwEdge(const Edge_id& e);
+
+	/*
+	 * clearBwEdge(const Edge_id&) method: make a backward edge slot dummy
+	 */
+	void clearBwEdge(const Edge_id& e);
+
+	/*
+	 * shareFwWeight(const Edge_id&) method: give the weight id of a forward edge to its symmetric backward edge
+	 */
+	void shareFwWeight(const Edge_id& e);
+
+	/*
+	 * shareBwWeight(const Edge_id&) method: give the weight id of a backward edge to its symmetric forward edge
+	 */
+	void shareBwWeight(const Edge_id& e);
+
+	/*
+	 * aggregateWeight(const Weight_id&, const Edge&) method: return the id of the aggregation of a stored weight with the candidate edge weight (see Edge::aggregate)
+	 */
+	static Weight_id aggregateWeight(const Weight_id& weight, const Edge& candidateEdge);
+
+	/*
+	 * unindexFwEdge(const Node_id&, const Edge_id&) method: remove a forward edge of <origin> that is about to be deleted or overwritten from the edge index
+	 * (if a parallel edge exists, it takes its place in the index)
+	 */
+	void unindexFwEdge(const Node_id& origin, const Edge_id& e);
+
+	/*
+	 * reindexFwEdge(const Node_id&, const Edge_id&, const Edge_id&) method: update the edge index after a forward edge of <origin> has been moved from <from> to <to>
+	 */
+	void reindexFwEdge(const Node_id& origin, const Edge_id& from, const Edge_id& to);
+
+	/*
+	 * allocateFwBlock(uint32_t&) method: return the first id of a block of at least <capacity> dummy forward edges, and set <capacity> as its actual size
+	 */
+	Edge_id allocateFwBlock(uint32_t& capacity);
+
+	/*
+	 * allocateBwBlock(uint32_t&) method: return the first id of a block of at least <capacity> dummy backward edges, and set <capacity> as its actual size
+	 */
+	Edge_id allocateBwBlock(uint32_t& capacity);
+
+	/*
+	 * releaseFwBlock(const Edge_id&, const uint32_t&) method: give back a block of dummy forward edges, so that it can be reused by another node
+	 */
+	void releaseFwBlock(const Edge_id& begin, const uint32_t& capacity);
+
+	/*
+	 * releaseBwBlock(const Edge_id&, const uint32_t&) method: give back a block of dummy backward edges, so that it can be reused by another node
+	 */
+	void releaseBwBlock(const Edge_id& begin, const uint32_t& capacity);
+
 	/*
 	 * Attributes
 	 */
 	Specif _specif;
+	NodePermutation _permutation; // Correspondence between original node ids (instance files) and internal node ids
 	std::vector<Node> _nodes;
-	std::vector<Edge> _fwedges;
-	std::vector<Edge> _bwedges;
+	// Edges are stored as arrays indexed by edge slot (structure of arrays): searches that only follow edges read a few bytes per edge
+	// the origin of a forward edge is the one of its backward edge, the destination of a backward edge is the one of its forward edge
+	std::vector<Node_id> _fwDestinations; // Destination of each forward edge (INVALID_NODE_ID for dummy edges)
+	std::vector<Weight_id> _fwWeights; // Weight id of each forward edge
+	std::vector<Edge_id> _fwSymEdges; // Backward edge of each forward edge (INVALID_EDGE_ID for dummy edges)
+	std::vector<Node_id> _bwOrigins; // Origin of each backward edge (INVALID_NODE_ID for dummy edges)
+	std::vector<Weight_id> _bwWeights; // Weight id of each backward edge, the one of its forward edge (kept here for backward searches)
+	std::vector<Edge_id> _bwSymEdges; // Forward edge of each backward edge (INVALID_EDGE_ID for dummy edges)
+	// Shortcut data, stored once by forward edge (a backward edge reads it through its forward edge)
+	std::vector<Node_id> _fwMiddleNodes; // Middle node of each shortcut (INVALID_NODE_ID for original edges)
+	std::vector<uint32_t> _fwComplexities; // Complexity of each edge
+	std::vector<uint32_t> _fwNbOriginalEdges; // Number of original edges that each edge represents
+	// Edge blocks: each node owns a block of forward (resp. backward) edge slots, beginning at its first edge, its edges first and dummy edges after
+	std::vector<uint32_t> _fwCapacities; // Size of the forward block of each node (0 if the node does not own any block)
+	std::vector<uint32_t> _bwCapacities; // Size of the backward block of each node (0 if the node does not own any block)
+	std::multimap<uint32_t,Edge_id> _fwFreeBlocks; // Released forward blocks (first edge ids), sorted by size
+	std::multimap<uint32_t,Edge_id> _bwFreeBlocks; // Released backward blocks (first edge ids), sorted by size
+	EdgeIndex _fwIndex; // Forward edge id of each (origin, destination) pair, the backward one being its symmetric edge
 	std::vector<uint32_t> _levels; // Node level into the hierarchy (sorted by nodes)
 	std::vector<Node_id> _sortednodes; // Node level into the hierarchy (sorted by levels)
 
@@ -0,0 +1,234 @@
+/*
+ * kernels.cpp
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#include "kernels.h"
+
+#include <cstdlib> // Command getenv
+
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define SCH_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+/*
+ * Scalar kernels (portable fallback)
+ */
+static void axpyScalar(double* y, const double* x, double c, size_t n){
+	for(size_t i(0) ; i < n ; ++i){
+		y[i] += c * x[i];
+	}
+}
+static void axpy2Scalar(double* y1, double* y2, const double* x, double c1, double c2, size_t n){
+	for(size_t i(0) ; i < n ; ++i){
+		y1[i] += c1 * x[i];
+		y2[i] += c2 * x[i];
+	}
+}
+static void maximumScalar(double* y, const double* x, size_t stride, size_t n){
+	for(size_t i(0) ; i < n ; ++i){
+		y[i] = std::max( y[i] , x[i*stride] );
+	}
+}
+static void differenceScalar(double* y, const double* x, double previous, size_t n){
+	for(size_t i(0) ; i < n ; ++i){
+		y[i] = x[i] - previous;
+		previous = x[i];
+	}
+}
+static size_t dominanceScanScalar(const double* cur, size_t curStride, const double* alt, size_t altStride, size_t n, bool& larger){
+	for(size_t i(0) ; i < n ; ++i){
+		const double c( cur[i*curStride] ), a( alt[i*altStride] );
+		if( !le(a,c) || ( eq(c,1) && eq(a,1) ) ){
+			return i;
+		}
+		if( !le(c,a) ){
+			larger = true;
+		}
+	}
+	return n;
+}
+
+#ifdef SCH_X86_KERNELS
+/*
+ * AVX2 kernels (4 doubles per instruction)
+ */
+__attribute__((target("avx2")))
+static void axpyAvx2(double* y, const double* x, double c, size_t n){
+	const __m256d vc( _mm256_set1_pd(c) );
+	size_t i(0);
+	for( ; i+4 <= n ; i += 4){
+		_mm256_storeu_pd( y+i , _mm256_add_pd( _mm256_loadu_pd(y+i) , _mm256_mul_pd( vc , _mm256_loadu_pd(x+i) ) ) );
+	}
+	axpyScalar(y+i, x+i, c, n-i);
+}
+__attribute__((target("avx2")))
+static void axpy2Avx2(double* y1, double* y2, const double* x, double c1, double c2, size_t n){
+	const __m256d vc1( _mm256_set1_pd(c1) ), vc2( _mm256_set1_pd(c2) );
+	size_t i(0);
+	for( ; i+4 <= n ; i += 4){
+		const __m256d vx( _mm256_loadu_pd(x+i) );
+		_mm256_storeu_pd( y1+i , _mm256_add_pd( _mm256_loadu_pd(y1+i) , _mm256_mul_pd( vc1 , vx ) ) );
+		_mm256_storeu_pd( y2+i , _mm256_add_pd( _mm256_loadu_pd(y2+i) , _mm256_mul_pd( vc2 , vx ) ) );
+	}
+	axpy2Scalar(y1+i, y2+i, x+i, c1, c2, n-i);
+}
+__attribute__((target("avx2")))
+static void maximumAvx2(double* y, const double* x, size_t stride, size_t n){
+	size_t i(0);
+	for( ; i+4 <= n ; i += 4){
+		const __m256d vx( (stride != 0) ? _mm256_loadu_pd(x+i) : _mm256_set1_pd(*x) );
+		_mm256_storeu_pd( y+i , _mm256_max_pd( vx , _mm256_loadu_pd(y+i) ) ); // (x>y)?x:y, ie std::max(y,x)
+	}
+	maximumScalar(y+i, x+i*stride, stride, n-i);
+}
+__attribute__((target("avx2")))
+static void differenceAvx2(double* y, const double* x, double previous, size_t n){
+	if(n == 0){
+		return;
+	}
+	y[0] = x[0] - previous;
+	size_t i(1);
+	for( ; i+4 <= n ; i += 4){
+		_mm256_storeu_pd( y+i , _mm256_sub_pd( _mm256_loadu_pd(x+i) , _mm256_loadu_pd(x+i-1) ) );
+	}
+	differenceScalar(y+i, x+i, x[i-1], n-i);
+}
+__attribute__((target("avx2")))
+static size_t dominanceScanAvx2(const double* cur, size_t curStride, const double* alt, size_t altStride, size_t n, bool& larger){
+	const __m256d eps( _mm256_set1_pd(EPSILON) ), one( _mm256_set1_pd(1.0) );
+	const __m256d absmask( _mm256_castsi256_pd( _mm256_set1_epi64x(0x7fffffffffffffffLL) ) );
+	size_t i(0);
+	for( ; i+4 <= n ; i += 4){
+		const __m256d c( (curStride != 0) ? _mm256_loadu_pd(cur+i) : _mm256_set1_pd(*cur) );
+		const __m256d a( (altStride != 0) ? _mm256_loadu_pd(alt+i) : _mm256_set1_pd(*alt) );
+		const __m256d altLarger( _mm256_cmp_pd( _mm256_sub_pd(a,c) , eps , _CMP_NLE_UQ ) ); // !le(a,c)
+		const __m256d curLarger( _mm256_cmp_pd( _mm256_sub_pd(c,a) , eps , _CMP_NLE_UQ ) ); // !le(c,a)
+		const __m256d bothOne( _mm256_and_pd( _mm256_cmp_pd( _mm256_and_pd( _mm256_sub_pd(c,one) , absmask ) , eps , _CMP_LE_OQ ),
+				_mm256_cmp_pd( _mm256_and_pd( _mm256_sub_pd(a,one) , absmask ) , eps , _CMP_LE_OQ ) ) ); // eq(c,1) && eq(a,1)
+		const int event( _mm256_movemask_pd( _mm256_or_pd( altLarger , bothOne ) ) );
+		const int strict( _mm256_movemask_pd( curLarger ) );
+		if(event != 0){
+			const int k( __builtin_ctz(event) );
+			larger = larger || ( strict & ((1 << k) - 1) ) != 0;
+			return i + k;
+		}
+		larger = larger || strict != 0;
+	}
+	return i + dominanceScanScalar(cur+i*curStride, curStride, alt+i*altStride, altStride, n-i, larger);
+}
+
+/*
+ * SSE4.1 kernels (2 doubles per instruction)
+ */
+__attribute__((target("sse4.1")))
+static void axpySse4(double* y, const double* x, double c, size_t n){
+	const __m128d vc( _mm_set1_pd(c) );
+	size_t i(0);
+	for( ; i+2 <= n ; i += 2){
+		_mm_storeu_pd( y+i , _mm_add_pd( _mm_loadu_pd(y+i) , _mm_mul_pd( vc , _mm_loadu_pd(x+i) ) ) );
+	}
+	axpyScalar(y+i, x+i, c, n-i);
+}
+__attribute__((target("sse4.1")))
+static void axpy2Sse4(double* y1, double* y2, const double* x, double c1, double c2, size_t n){
+	const __m128d vc1( _mm_set1_pd(c1) ), vc2( _mm_set1_pd(c2) );
+	size_t i(0);
+	for( ; i+2 <= n ; i += 2){
+		const __m128d vx( _mm_loadu_pd(x+i) );
+		_mm_storeu_pd( y1+i , _mm_add_pd( _mm_loadu_pd(y1+i) , _mm_mul_pd( vc1 , vx ) ) );
+		_mm_storeu_pd( y2+i , _mm_add_pd( _mm_loadu_pd(y2+i) , _mm_mul_pd( vc2 , vx ) ) );
+	}
+	axpy2Scalar(y1+i, y2+i, x+i, c1, c2, n-i);
+}
+__attribute__((target("sse4.1")))
+static void maximumSse4(double* y, const double* x, size_t stride, size_t n){
+	size_t i(0);
+	for( ; i+2 <= n ; i += 2){
+		const __m128d vx( (stride != 0) ? _mm_loadu_pd(x+i) : _mm_set1_pd(*x) );
+		_mm_storeu_pd( y+i , _mm_max_pd( vx , _mm_loadu_pd(y+i) ) ); // (x>y)?x:y, ie std::max(y,x)
+	}
+	maximumScalar(y+i, x+i*stride, stride, n-i);
+}
+__attribute__((target("sse4.1")))
+static void differenceSse4(double* y, const double* x, double previous, size_t n){
+	if(n == 0){
+		return;
+	}
+	y[0] = x[0] - previous;
+	size_t i(1);
+	for( ; i+2 <= n ; i += 2){
+		_mm_storeu_pd( y+i , _mm_sub_pd( _mm_loadu_pd(x+i) , _mm_loadu_pd(x+i-1) ) );
+	}
+	differenceScalar(y+i, x+i, x[i-1], n-i);
+}
+__attribute__((target("sse4.1")))
+static size_t dominanceScanSse4(const double* cur, size_t curStride, const double* alt, size_t altStride, size_t n, bool& larger){
+	const __m128d eps( _mm_set1_pd(EPSILON) ), one( _mm_set1_pd(1.0) );
+	const __m128d absmask( _mm_castsi128_pd( _mm_set1_epi64x(0x7fffffffffffffffLL) ) );
+	size_t i(0);
+	for( ; i+2 <= n ; i += 2){
+		const __m128d c( (curStride != 0) ? _mm_loadu_pd(cur+i) : _mm_set1_pd(*cur) );
+		const __m128d a( (altStride != 0) ? _mm_loadu_pd(alt+i) : _mm_set1_pd(*alt) );
+		const __m128d altLarger( _mm_cmpnle_pd( _mm_sub_pd(a,c) , eps ) ); // !le(a,c)
+		const __m128d curLarger( _mm_cmpnle_pd( _mm_sub_pd(c,a) , eps ) ); // !le(c,a)
+		const __m128d bothOne( _mm_and_pd( _mm_cmple_pd( _mm_and_pd( _mm_sub_pd(c,one) , absmask ) , eps ),
+				_mm_cmple_pd( _mm_and_pd( _mm_sub_pd(a,one) , absmask ) , eps ) ) ); // eq(c,1) && eq(a,1)
+		const int event( _mm_movemask_pd( _mm_or_pd( altLarger , bothOne ) ) );
+		const int strict( _mm_movemask_pd( curLarger ) );
+		if(event != 0){
+			const int k( __builtin_ctz(event) );
+			larger = larger || ( strict & ((1 << k) - 1) ) != 0;
+			return i + k;
+		}
+		larger = larger || strict != 0;
+	}
+	return i + dominanceScanScalar(cur+i*curStride, curStride, alt+i*altStride, altStride, n-i, larger);
+}
+#endif
+
+/*
+ * selectKernels() method: choose the most efficient kernel set supported by the processor, unless SCH_KERNELS asks for a given one
+ */
+static DistributionKernels selectKernels(){
+	const DistributionKernels scalar{ axpyScalar, axpy2Scalar, maximumScalar, differenceScalar, dominanceScanScalar, "scalar" };
+	const char* forced( getenv("SCH_KERNELS") );
+	const std::string request( (forced != NULL) ? forced : "" );
+#ifdef SCH_X86_KERNELS
+	__builtin_cpu_init();
+	const DistributionKernels avx2{ axpyAvx2, axpy2Avx2, maximumAvx2, differenceAvx2, dominanceScanAvx2, "avx2" };
+	const DistributionKernels sse4{ axpySse4, axpy2Sse4, maximumSse4, differenceSse4, dominanceScanSse4, "sse4" };
+	const bool avx2Supported( __builtin_cpu_supports("avx2") ), sse4Supported( __builtin_cpu_supports("sse4.1") );
+	if( request == "avx2" && !avx2Supported ){
+		WARNING("AVX2 kernels requested but not supported by the processor.\n");
+	}
+	if( request == "sse4" && !sse4Supported ){
+		WARNING("SSE4.1 kernels requested but not supported by the processor.\n");
+	}
+	if( request == "scalar" ){
+		return scalar;
+	}
+	if( avx2Supported && ( request == "" || request == "avx2" ) ){
+		return avx2;
+	}
+	if( sse4Supported ){
+		return sse4;
+	}
+#else
+	if( request != "" && request != "scalar" ){
+		WARNING("Only scalar kernels are available on this architecture.\n");
+	}
+#endif
+	return scalar;
+}
+
+/*
+ * getKernels() method: return the kernel set selected for the current processor (selection is done once, at the first call)
+ */
+const DistributionKernels& getKernels(){
+	static const DistributionKernels kernels( selectKernels() );
+	return kernels;
+}
@@ -0,0 +1,59 @@
+/*
+ * kernels.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_GRAPH_KERNELS_H_
+#define DATA_GRAPH_KERNELS_H_
+
+#include <cstddef>
+#include <string>
+
+#include "../../misc.h"
+
+/*
+ * Distribution kernels file
+ * Inner loops of convolution, aggregation and dominance checks, available as AVX2, SSE4.1 and portable scalar versions.
+ * The version is chosen at runtime with respect to the processor capabilities (it can be forced with the SCH_KERNELS
+ * environment variable, set to "avx2", "sse4" or "scalar"). Each version does the same floating-point operations in the same order
+ * for every element (no fused multiply-add, no reassociation), hence all of them give bit-for-bit identical results.
+ */
+struct DistributionKernels{
+	/*
+	 * axpy(double*, const double*, double, size_t) kernel: y[i] += c*x[i] for i in [0,n)
+	 */
+	void (*axpy)(double* y, const double* x, double c, size_t n);
+
+	/*
+	 * axpy2(double*, double*, const double*, double, double, size_t) kernel: y1[i] += c1*x[i] and y2[i] += c2*x[i] for i in [0,n)
+	 */
+	void (*axpy2)(double* y1, double* y2, const double* x, double c1, double c2, size_t n);
+
+	/*
+	 * maximum(double*, const double*, size_t, size_t) kernel: y[i] = max{y[i],x[i*stride]} for i in [0,n) (stride is 0 or 1)
+	 */
+	void (*maximum)(double* y, const double* x, size_t stride, size_t n);
+
+	/*
+	 * difference(double*, const double*, double, size_t) kernel: y[i] = x[i]-x[i-1] for i in [0,n), with x[-1]=previous
+	 */
+	void (*difference)(double* y, const double* x, double previous, size_t n);
+
+	/*
+	 * dominanceScan(const double*, size_t, const double*, size_t, size_t, bool&) kernel: scan two cdf in increasing index order (strides are 0 or 1)
+	 * return the first index where alt is larger than cur (ie !le(alt,cur)) or where both are equal to 1, n if there is none;
+	 * larger is set to true if cur is larger than alt (ie !le(cur,alt)) at one of the indexes strictly before the returned one
+	 */
+	size_t (*dominanceScan)(const double* cur, size_t curStride, const double* alt, size_t altStride, size_t n, bool& larger);
+
+	std::string name; // Instruction set used by the kernels
+};
+
+/*
+ * getKernels() method: return the kernel set selected for the current processor (selection is done once, at the first call)
+ */
+const DistributionKernels& getKernels();
+
+#endif /* DATA_GRAPH_KERNELS_H_ */
@@ -0,0 +1,96 @@
+/*
+ * memoryfootprint.cpp
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#include "memoryfootprint.h"
+
+#include <cstdint>
+#include <iomanip> // Command setprecision
+
+constexpr size_t MemoryFootprint::TREE_NODE_OVERHEAD;
+constexpr size_t MemoryFootprint::HASH_NODE_OVERHEAD;
+constexpr size_t MemoryFootprint::DEQUE_BLOCK_SIZE;
+
+/*
+ * Constructors
+ */
+MemoryFootprint::MemoryFootprint(const std::string& name): _name(name){}
+
+/*
+ * Getters
+ */
+const std::string& MemoryFootprint::getName() const { return _name; }
+size_t MemoryFootprint::getTotal() const {
+	size_t total(0);
+	for(const auto& item: _items){
+		total += item.second;
+	}
+	return total;
+}
+size_t MemoryFootprint::getBytes(const std::string& item) const {
+	for(const auto& it: _items){
+		if( it.first == item ){
+			return it.second;
+		}
+	}
+	return 0;
+}
+
+/*
+ * add(const std::string&, const size_t&) method: add the given number of bytes to the given item (the item is created if needed)
+ */
+void MemoryFootprint::add(const std::string& item, const size_t& bytes){
+	for(auto& it: _items){
+		if( it.first == item ){
+			it.second += bytes;
+			return;
+		}
+	}
+	_items.push_back( std::make_pair( item , bytes ) );
+}
+
+/*
+ * add(const MemoryFootprint&) method: add all the items of the given footprint to the current one (items with the same name are summed)
+ */
+void MemoryFootprint::add(const MemoryFootprint& footprint){
+	for(const auto& item: footprint._items){
+		add( item.first , item.second );
+	}
+}
+
+/*
+ * printBytes(std::ostream&, const size_t&) function: print a number of bytes with a readable unit (B, kB, MB or GB)
+ */
+static void printBytes(std::ostream& os, const size_t& bytes){
+	const char* units[] = { "B" , "kB" , "MB" , "GB" };
+	double value( bytes );
+	uint32_t unit(0);
+	while( value >= 1024 && unit < 3 ){
+		value /= 1024;
+		++unit;
+	}
+	os << std::fixed << std::setprecision( unit == 0 ? 0 : 1 ) << value << " " << units[unit];
+}
+
+/*
+ * << operator: print the total and the items of the footprint, in a readable unit
+ * format: <name> <total> (<item1> <bytes1>, <item2> <bytes2>...)
+ */
+std::ostream& operator<<(std::ostream& os, const MemoryFootprint& footprint){
+	const std::ios::fmtflags flags( os.flags() );
+	const std::streamsize precision( os.precision() );
+	os << footprint._name << " ";
+	printBytes( os , footprint.getTotal() );
+	os << " (";
+	for(auto it = footprint._items.begin() ; it != footprint._items.end() ; ++it){
+		os << ( it == footprint._items.begin() ? "" : ", " ) << it->first << " ";
+		printBytes( os , it->second );
+	}
+	os << ")";
+	os.flags(flags);
+	os.precision(precision);
+	return os;
+}
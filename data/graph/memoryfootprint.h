@@ -0,0 +1,91 @@
+/*
+ * memoryfootprint.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_GRAPH_MEMORYFOOTPRINT_H_
+#define DATA_GRAPH_MEMORYFOOTPRINT_H_
+
+#include <cstddef>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * class MemoryFootprint: memory held by a structure, in bytes, broken down into named items (eg topology, weights, dummy padding)
+ * Sizes count the allocated capacity of the containers. For node-based containers (map, set, deque...), whose allocations are not visible,
+ * the bytes() methods estimate them from the size of the elements and the usual per-node overhead of the standard library.
+ * bytes() only counts the container storage: the memory allocated by the elements themselves is to be added by the caller.
+ */
+class MemoryFootprint{
+public:
+	/*
+	 * Constructors
+	 */
+	MemoryFootprint(const std::string& name);
+
+	/*
+	 * Getters
+	 */
+	const std::string& getName() const;
+	size_t getTotal() const;
+	size_t getBytes(const std::string& item) const;
+
+	/*
+	 * add(const std::string&, const size_t&) method: add the given number of bytes to the given item (the item is created if needed)
+	 */
+	void add(const std::string& item, const size_t& bytes);
+
+	/*
+	 * add(const MemoryFootprint&) method: add all the items of the given footprint to the current one (items with the same name are summed)
+	 */
+	void add(const MemoryFootprint& footprint);
+
+	/*
+	 * << operator: print the total and the items of the footprint, in a readable unit
+	 * format: <name> <total> (<item1> <bytes1>, <item2> <bytes2>...)
+	 */
+	friend std::ostream& operator<<(std::ostream& os, const MemoryFootprint& footprint);
+
+	/*
+	 * bytes(...) methods: return the memory allocated by a container (not including the memory allocated by its elements)
+	 */
+	template<typename T>
+	static size_t bytes(const std::vector<T>& v){ return v.capacity() * sizeof(T); }
+	static size_t bytes(const std::vector<bool>& v){ return v.capacity() / 8; }
+	template<typename T>
+	static size_t bytes(const std::deque<T>& d){
+		const size_t blockSize( sizeof(T) < DEQUE_BLOCK_SIZE ? DEQUE_BLOCK_SIZE / sizeof(T) : 1 ); // Number of elements per block
+		return ( d.size() / blockSize + 1 ) * blockSize * sizeof(T) + ( d.size() / blockSize + 8 ) * sizeof(void*);
+	}
+	template<typename K, typename C>
+	static size_t bytes(const std::set<K,C>& s){ return s.size() * ( sizeof(K) + TREE_NODE_OVERHEAD ); }
+	template<typename K, typename V, typename C>
+	static size_t bytes(const std::map<K,V,C>& m){ return m.size() * ( sizeof(std::pair<const K,V>) + TREE_NODE_OVERHEAD ); }
+	template<typename K, typename V, typename C>
+	static size_t bytes(const std::multimap<K,V,C>& m){ return m.size() * ( sizeof(std::pair<const K,V>) + TREE_NODE_OVERHEAD ); }
+	template<typename K, typename V, typename H, typename E>
+	static size_t bytes(const std::unordered_map<K,V,H,E>& m){ return m.bucket_count() * sizeof(void*) + m.size() * ( sizeof(std::pair<const K,V>) + HASH_NODE_OVERHEAD ); }
+	template<typename K, typename V, typename H, typename E>
+	static size_t bytes(const std::unordered_multimap<K,V,H,E>& m){ return m.bucket_count() * sizeof(void*) + m.size() * ( sizeof(std::pair<const K,V>) + HASH_NODE_OVERHEAD ); }
+
+	static constexpr size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*); // Per-element overhead of red-black tree nodes (color, parent, left and right links)
+	static constexpr size_t HASH_NODE_OVERHEAD = 2 * sizeof(void*); // Per-element overhead of hash table nodes (next link and cached hash value)
+	static constexpr size_t DEQUE_BLOCK_SIZE = 512; // Size of the blocks allocated by deques, in bytes
+
+private:
+	/*
+	 * Attributes
+	 */
+	std::string _name; // Name of the structure
+	std::vector< std::pair<std::string,size_t> > _items; // Number of bytes of each item, in insertion order
+};
+
+#endif /* DATA_GRAPH_MEMORYFOOTPRINT_H_ */
@@ -10,37 +10,35 @@
 /*
  * Constructors
  */
-Node::Node(): _fwbegin(INVALID_EDGE_ID), _fwend(INVALID_EDGE_ID), _bwbegin(INVALID_EDGE_ID), _bwend(INVALID_EDGE_ID){}
+Node::Node(): _fwbegin(INVALID_EDGE_ID), _fwdegree(0), _bwbegin(INVALID_EDGE_ID), _bwdegree(0){}
 
 /*
  * Getters
  */
 Edge_id Node::getBeginFW() const{ return _fwbegin; }
-Edge_id Node::getEndFW() const{ return _fwend; }
+Edge_id Node::getEndFW() const{ return Edge_id( _fwbegin + _fwdegree ); }
 Edge_id Node::getBeginBW() const{ return _bwbegin; }
-Edge_id Node::getEndBW() const{ return _bwend; }
+Edge_id Node::getEndBW() const{ return Edge_id( _bwbegin + _bwdegree ); }
+uint32_t Node::getDegreeFW() const{ return _fwdegree; }
+uint32_t Node::getDegreeBW() const{ return _bwdegree; }
 
 /*
- * Setters
+ * Setters: setting the first edge moves the whole range (the degree is kept), setting the end edge sets the degree
  */
 void Node::setBeginFW(const Edge_id& n){ _fwbegin = n; }
-void Node::setEndFW(const Edge_id& n){ _fwend = n; }
+void Node::setEndFW(const Edge_id& n){ _fwdegree = n - _fwbegin; }
 void Node::setBeginBW(const Edge_id& n){ _bwbegin = n; }
-void Node::setEndBW(const Edge_id& n){ _bwend = n; }
+void Node::setEndBW(const Edge_id& n){ _bwdegree = n - _bwbegin; }
 
-void Node::decreaseBeginFW(){ --_fwbegin; }
-void Node::decreaseEndFW(){ --_fwend; }
-void Node::decreaseBeginBW(){ --_bwbegin; }
-void Node::decreaseEndBW(){ --_bwend; }
-void Node::increaseBeginFW(){ ++_fwbegin; }
-void Node::increaseEndFW(){ ++_fwend; }
-void Node::increaseBeginBW(){ ++_bwbegin; }
-void Node::increaseEndBW(){ ++_bwend; }
+void Node::decreaseDegreeFW(){ --_fwdegree; }
+void Node::decreaseDegreeBW(){ --_bwdegree; }
+void Node::increaseDegreeFW(){ ++_fwdegree; }
+void Node::increaseDegreeBW(){ ++_bwdegree; }
 
 /*
  * << operator: return an outstream version of the node (printing purpose)
  */
 std::ostream& operator<<(std::ostream& os, const Node& node){
-	os << "[FW] <" << node._fwbegin << "-" << node._fwend << "> [BW] <" << node._bwbegin << "-" << node._bwend << ">\n";
+	os << "[FW] <" << node._fwbegin << "-" << node.getEndFW() << "> [BW] <" << node._bwbegin << "-" << node.getEndBW() << ">\n";
     return os;
 }
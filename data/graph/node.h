@@ -12,6 +12,10 @@
 
 #include "../../misc.h"
 
+/*
+ * class Node: packed node record (16 bytes), giving the first edge and the number of live edges of the node, in both directions
+ * Edge ranges are [begin;begin+degree[, begin being INVALID_EDGE_ID (and degree 0) as long as the node has no edge block.
+ */
 class Node{
 public:
 	/*
@@ -26,6 +30,8 @@ public:
 	Edge_id getEndFW() const;
 	Edge_id getBeginBW() const;
 	Edge_id getEndBW() const;
+	uint32_t getDegreeFW() const;
+	uint32_t getDegreeBW() const;
 
 	/*
 	 * Setters
@@ -35,14 +41,10 @@ public:
 	void setBeginBW(const Edge_id& n);
 	void setEndBW(const Edge_id& n);
 
-	void decreaseBeginFW();
-	void decreaseEndFW();
-	void decreaseBeginBW();
-	void decreaseEndBW();
-	void increaseBeginFW();
-	void increaseEndFW();
-	void increaseBeginBW();
-	void increaseEndBW();
+	void decreaseDegreeFW();
+	void decreaseDegreeBW();
+	void increaseDegreeFW();
+	void increaseDegreeBW();
 
 	/*
 	 * print() method: print the node on the console
@@ -56,11 +58,12 @@ private:
 	/*
 	 * Attributes
 	 */
-	Edge_id _fwbegin;
-	Edge_id _fwend;
-	Edge_id _bwbegin;
-	Edge_id _bwend;
-
+	Edge_id _fwbegin; // First forward edge
+	uint32_t _fwdegree; // Number of forward edges (the following edges of the block are dummy edges)
+	Edge_id _bwbegin; // First backward edge
+	uint32_t _bwdegree; // Number of backward edges (the following edges of the block are dummy edges)
 };
 
+static_assert( sizeof(Node) == 16 , "Node records must stay packed on 16 bytes" );
+
 #endif /* DATA_NODE_H_ */
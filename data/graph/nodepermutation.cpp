@@ -0,0 +1,186 @@
+/*
+ * nodepermutation.cpp
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#include "nodepermutation.h"
+#include "memoryfootprint.h"
+
+#include <algorithm> // Command max
+#include <cstdlib> // Command abort
+#include <queue>
+
+/*
+ * adjacencyLists(const std::vector<Edge>&) function: return the neighbours of each node (predecessors and successors, sorted by ids), the graph
+ * having as many nodes as the largest node id plus one
+ */
+static std::vector< std::vector<Node_id> > adjacencyLists(const std::vector<Edge>& edges){
+	Node_id maxNodeId(0);
+	for(const Edge& edge: edges){
+		maxNodeId = std::max( maxNodeId , std::max( edge.getOrigin() , edge.getDestination() ) );
+	}
+	std::vector< std::vector<Node_id> > neighbours( edges.empty() ? 0 : maxNodeId + 1 );
+	for(const Edge& edge: edges){
+		neighbours[edge.getOrigin()].push_back( edge.getDestination() );
+		neighbours[edge.getDestination()].push_back( edge.getOrigin() );
+	}
+	for(auto& nodeNeighbours: neighbours){
+		std::sort( nodeNeighbours.begin() , nodeNeighbours.end() );
+	}
+	return neighbours;
+}
+
+/*
+ * Constructors
+ */
+NodePermutation::NodePermutation(){}
+NodePermutation::NodePermutation(const std::vector<Node_id>& originalIds): _internalIds( originalIds.size() , INVALID_NODE_ID ), _originalIds(originalIds){
+	if( !isPermutation(_originalIds) ){
+		ERROR("Invalid node permutation: some node ids are out of range or duplicated.\n");
+		std::abort();
+	}
+	for(uint32_t n(0) ; n < _originalIds.size() ; ++n){
+		_internalIds[_originalIds[n]] = Node_id(n);
+	}
+}
+
+/*
+ * isPermutation(const std::vector<Node_id>&) method: return true if the given original ids are a permutation of 0..#ids-1, ie a valid
+ * input of the constructor (each id is in range and appears once)
+ */
+bool NodePermutation::isPermutation(const std::vector<Node_id>& originalIds){
+	std::vector<bool> seen( originalIds.size() , false );
+	for(const Node_id& n: originalIds){
+		if( uint32_t(n) >= seen.size() || seen[n] ){
+			return false;
+		}
+		seen[n] = true;
+	}
+	return true;
+}
+
+/*
+ * breadthFirst(const std::vector<Edge>&) method: return the permutation that numbers nodes in breadth-first order over the given edges (both directions),
+ * starting from the smallest original id of each connected component
+ */
+NodePermutation NodePermutation::breadthFirst(const std::vector<Edge>& edges){
+	const std::vector< std::vector<Node_id> > neighbours( adjacencyLists(edges) );
+	std::vector<bool> visited( neighbours.size() , false );
+	std::vector<Node_id> order;
+	order.reserve( neighbours.size() );
+	for(uint32_t root(0) ; root < neighbours.size() ; ++root){
+		if( visited[root] ){
+			continue;
+		}
+		std::queue<Node_id> fifoqueue;
+		fifoqueue.push( Node_id(root) );
+		visited[root] = true;
+		while( !fifoqueue.empty() ){
+			const Node_id u( fifoqueue.front() );
+			fifoqueue.pop();
+			order.push_back(u);
+			for(const Node_id& v: neighbours[u]){
+				if( !visited[v] ){
+					visited[v] = true;
+					fifoqueue.push(v);
+				}
+			}
+		}
+	}
+	return NodePermutation(order);
+}
+
+/*
+ * Getters
+ */
+bool NodePermutation::isIdentity() const { return _originalIds.empty(); }
+uint32_t NodePermutation::getNbNodes() const { return _originalIds.size(); }
+Node_id NodePermutation::toInternal(const Node_id& n) const { return ( isIdentity() || n == INVALID_NODE_ID ) ? n : _internalIds[n]; }
+Node_id NodePermutation::toOriginal(const Node_id& n) const { return ( isIdentity() || n == INVALID_NODE_ID ) ? n : _originalIds[n]; }
+
+/*
+ * toInternal(std::vector<Edge>&) method: translate the origins, destinations and middle nodes of the given edges into internal ids
+ */
+void NodePermutation::toInternal(std::vector<Edge>& edges) const {
+	if( isIdentity() ){
+		return;
+	}
+	for(Edge& edge: edges){
+		edge.setOrigin( toInternal( edge.getOrigin() ) );
+		edge.setDestination( toInternal( edge.getDestination() ) );
+		edge.setMiddleNode( toInternal( edge.getMiddleNode() ) );
+	}
+}
+
+/*
+ * toOriginal(std::vector<Edge>&) method: translate the origins, destinations and middle nodes of the given edges into original ids
+ */
+void NodePermutation::toOriginal(std::vector<Edge>& edges) const {
+	if( isIdentity() ){
+		return;
+	}
+	for(Edge& edge: edges){
+		edge.setOrigin( toOriginal( edge.getOrigin() ) );
+		edge.setDestination( toOriginal( edge.getDestination() ) );
+		edge.setMiddleNode( toOriginal( edge.getMiddleNode() ) );
+	}
+}
+
+/*
+ * internalIds(const std::vector<Node_id>&) method: return the given node ids, translated into internal ids (same order)
+ */
+std::vector<Node_id> NodePermutation::internalIds(const std::vector<Node_id>& nodes) const {
+	std::vector<Node_id> result( nodes );
+	for(Node_id& n: result){
+		n = toInternal(n);
+	}
+	return result;
+}
+
+/*
+ * originalIds(const std::vector<Node_id>&) method: return the given node ids, translated into original ids (same order)
+ */
+std::vector<Node_id> NodePermutation::originalIds(const std::vector<Node_id>& nodes) const {
+	std::vector<Node_id> result( nodes );
+	for(Node_id& n: result){
+		n = toOriginal(n);
+	}
+	return result;
+}
+
+/*
+ * internalIndexing(const std::vector<uint32_t>&) method: return the given node values (indexed by original ids), indexed by internal ids
+ */
+std::vector<uint32_t> NodePermutation::internalIndexing(const std::vector<uint32_t>& values) const {
+	if( isIdentity() ){
+		return values;
+	}
+	std::vector<uint32_t> result( values.size() );
+	for(uint32_t n(0) ; n < values.size() ; ++n){
+		result[_internalIds[n]] = values[n];
+	}
+	return result;
+}
+
+/*
+ * originalIndexing(const std::vector<uint32_t>&) method: return the given node values (indexed by internal ids), indexed by original ids
+ */
+std::vector<uint32_t> NodePermutation::originalIndexing(const std::vector<uint32_t>& values) const {
+	if( isIdentity() ){
+		return values;
+	}
+	std::vector<uint32_t> result( values.size() );
+	for(uint32_t n(0) ; n < values.size() ; ++n){
+		result[_originalIds[n]] = values[n];
+	}
+	return result;
+}
+
+/*
+ * getMemorySize() method: return the memory allocated for both id tables, in bytes
+ */
+size_t NodePermutation::getMemorySize() const {
+	return MemoryFootprint::bytes(_internalIds) + MemoryFootprint::bytes(_originalIds);
+}
@@ -0,0 +1,94 @@
+/*
+ * nodepermutation.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_GRAPH_NODEPERMUTATION_H_
+#define DATA_GRAPH_NODEPERMUTATION_H_
+
+#include <string>
+#include <vector>
+
+#include "../../misc.h"
+#include "edge.h"
+
+/*
+ * Class NodePermutation: correspondence between the node ids of the instance files (original ids) and the node ids used in memory (internal ids)
+ * Graphs may be built with a locality-preserving internal order, so that nodes that are visited together by searches are stored together:
+ * breadth-first order for preprocessing, level order for a contracted hierarchy. Ids are translated at the API boundary only
+ * (graph files, hierarchy files, query origins and destinations, routing policies). An empty permutation is the identity.
+ */
+class NodePermutation{
+public:
+	/*
+	 * Constructors
+	 */
+	NodePermutation();
+	NodePermutation(const std::vector<Node_id>& originalIds); // <originalIds> must be a permutation (see isPermutation), the program is aborted otherwise
+
+	/*
+	 * isPermutation(const std::vector<Node_id>&) method: return true if the given original ids are a permutation of 0..#ids-1, ie a valid
+	 * input of the constructor (to be checked on ids read from files)
+	 */
+	static bool isPermutation(const std::vector<Node_id>& originalIds);
+
+	/*
+	 * breadthFirst(const std::vector<Edge>&) method: return the permutation that numbers nodes in breadth-first order over the given edges (both directions),
+	 * starting from the smallest original id of each connected component
+	 */
+	static NodePermutation breadthFirst(const std::vector<Edge>& edges);
+
+	/*
+	 * Getters
+	 */
+	bool isIdentity() const;
+	uint32_t getNbNodes() const;
+	Node_id toInternal(const Node_id& n) const;
+	Node_id toOriginal(const Node_id& n) const;
+
+	/*
+	 * toInternal(std::vector<Edge>&) method: translate the origins, destinations and middle nodes of the given edges into internal ids
+	 */
+	void toInternal(std::vector<Edge>& edges) const;
+
+	/*
+	 * toOriginal(std::vector<Edge>&) method: translate the origins, destinations and middle nodes of the given edges into original ids
+	 */
+	void toOriginal(std::vector<Edge>& edges) const;
+
+	/*
+	 * internalIds(const std::vector<Node_id>&) method: return the given node ids, translated into internal ids (same order)
+	 */
+	std::vector<Node_id> internalIds(const std::vector<Node_id>& nodes) const;
+
+	/*
+	 * originalIds(const std::vector<Node_id>&) method: return the given node ids, translated into original ids (same order)
+	 */
+	std::vector<Node_id> originalIds(const std::vector<Node_id>& nodes) const;
+
+	/*
+	 * internalIndexing(const std::vector<uint32_t>&) method: return the given node values (indexed by original ids), indexed by internal ids
+	 */
+	std::vector<uint32_t> internalIndexing(const std::vector<uint32_t>& values) const;
+
+	/*
+	 * originalIndexing(const std::vector<uint32_t>&) method: return the given node values (indexed by internal ids), indexed by original ids
+	 */
+	std::vector<uint32_t> originalIndexing(const std::vector<uint32_t>& values) const;
+
+	/*
+	 * getMemorySize() method: return the memory allocated for both id tables, in bytes
+	 */
+	size_t getMemorySize() const;
+
+private:
+	/*
+	 * Attributes
+	 */
+	std::vector<Node_id> _internalIds; // Internal id of each node (sorted by original ids)
+	std::vector<Node_id> _originalIds; // Original id of each node (sorted by internal ids)
+};
+
+#endif /* DATA_GRAPH_NODEPERMUTATION_H_ */
@@ -0,0 +1,230 @@
+/*
+ * quantizedcdf.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_GRAPH_QUANTIZEDCDF_H_
+#define DATA_GRAPH_QUANTIZEDCDF_H_
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "distribution.h"
+
+/*
+ * class QuantizedCdf: compact storage of a Distribution, where the cdf is kept as fixed-point integers (Quantum being uint16_t or uint32_t)
+ * F(t) is stored as q(t) = round(F(t).QMAX), so that |F(t)-q(t)/QMAX| <= 1/(2.QMAX); the pdf is not stored, but rebuilt as p(t) = F(t)-F(t-1)
+ * (hence |p(t)-p'(t)| <= 1/QMAX). As for Distribution, only the window of non-trivial values is stored.
+ * Dominance checks are done on integers; the EPSILON tolerance of misc.h is converted into a number of quanta (0 for 16-bit quanta, as 1/QMAX > EPSILON).
+ */
+template<typename Quantum>
+class QuantizedCdf{
+public:
+	/*
+	 * Constructors
+	 */
+	QuantizedCdf(): _size(1), _delta(1), _start(0), _cdf(1,QMAX), _minIndex(0), _maxIndex(0){}
+	QuantizedCdf(const Distribution& dist): _size(dist.getSize()), _delta( std::max( dist.getDelta() , uint32_t(1) ) ), _start(dist.getWindowBegin()){
+		_cdf.reserve( dist.getWindowEnd() - _start );
+		for(uint32_t t(_start) ; t < dist.getWindowEnd() ; ++t){
+			_cdf.push_back( quantize( dist.getCdfT(t) ) );
+		}
+		trim();
+	}
+
+	/*
+	 * Getters
+	 */
+	uint32_t getSize() const { return _size; }
+	uint32_t getSupT(const uint32_t& t) const { return t * _delta; }
+	double getCdfT(const uint32_t& t) const { return dequantize( quantumAt(t) ); }
+	double getPdfT(const uint32_t& t) const { return (t > 0) ? getCdfT(t) - getCdfT(t-1) : getCdfT(t); }
+
+	/*
+	 * toDistribution() method: return the (double precision) distribution corresponding to the stored cdf
+	 */
+	Distribution toDistribution() const {
+		std::vector<double> pdf(_cdf.size()), cdf(_cdf.size());
+		double previous(0);
+		for(uint32_t i(0) ; i < _cdf.size() ; ++i){
+			cdf[i] = dequantize( _cdf[i] );
+			pdf[i] = cdf[i] - previous;
+			previous = cdf[i];
+		}
+		return Distribution(_size, _delta, _start, pdf, cdf);
+	}
+
+	/*
+	 * min() method: return the minimum possible realization (cached, O(1))
+	 */
+	uint32_t min() const { return _minIndex * _delta; }
+
+	/*
+	 * max() method: return the maximum possible realization (cached, O(1))
+	 */
+	uint32_t max() const { return _maxIndex * _delta; }
+
+	/*
+	 * range() method: return the definition range of the distribution, namely max()-min()
+	 */
+	uint32_t range() const { return max() - min(); }
+
+	/*
+	 * reset() method: reset the distribution
+	 */
+	void reset(){
+		_size = 1;
+		_start = 0;
+		_cdf.assign(1,QMAX);
+		_minIndex = 0;
+		_maxIndex = 0;
+	}
+
+	/*
+	 * dominates(const QuantizedCdf&) method: return true if current cdf dominates the given one, for each support points (ie F1(t)>=F2(t) forall t, and at least one t such that F1(t)>F2(t))
+	 * same scanning rules as Distribution::dominates, with integer comparisons
+	 */
+	bool dominates(const QuantizedCdf& q) const {
+		bool response(false);
+		const uint32_t last( lastIndex(q) );
+		for(uint32_t t( std::min( _start , q._start ) ) ; t <= last ; ++t){
+			const uint64_t cur( quantumAt(t) ), alt( q.quantumAt(t) );
+			if( alt > cur + EPSILON_QUANTA ){
+				return false;
+			}
+			if( cur > alt + EPSILON_QUANTA ){
+				response = true;
+			}
+			if( isOne(cur) && isOne(alt) ){
+				return response;
+			}
+		}
+		return response;
+	}
+
+	/*
+	 * isLargerThan(const QuantizedCdf&) method: return true if current cdf is larger than the given one, for each support points (ie F1(t)>=F2(t) forall t), false otherwise
+	 */
+	bool isLargerThan(const QuantizedCdf& q) const {
+		const uint32_t last( lastIndex(q) );
+		for(uint32_t t( std::min( _start , q._start ) ) ; t <= last ; ++t){
+			const uint64_t cur( quantumAt(t) ), alt( q.quantumAt(t) );
+			if( alt > cur + EPSILON_QUANTA ){
+				return false;
+			}
+			if( isOne(cur) && isOne(alt) ){
+				return true;
+			}
+		}
+		return true;
+	}
+
+	/*
+	 * hash() method: return a hash value of the quantized cdf (support definition and stored quanta)
+	 */
+	size_t hash() const {
+		size_t seed(0);
+		boost::hash_combine(seed, _size);
+		boost::hash_combine(seed, _delta);
+		boost::hash_combine(seed, _start);
+		boost::hash_range(seed, _cdf.begin(), _cdf.end());
+		return seed;
+	}
+
+	/*
+	 * == operator: return true if both quantized cdf have the same support and the same quanta
+	 */
+	bool operator==(const QuantizedCdf& q) const {
+		return _size == q._size && _delta == q._delta && _start == q._start && _cdf == q._cdf;
+	}
+
+	/*
+	 * getErrorBound() method: return the maximal absolute error on the stored cdf values
+	 */
+	static double getErrorBound() { return 0.5 / QMAX; }
+
+	/*
+	 * getMemorySize() method: return the memory allocated for the quantized cdf, in bytes
+	 */
+	size_t getMemorySize() const { return _cdf.capacity() * sizeof(Quantum); }
+
+	/*
+	 * << operator: return an outstream version of the distribution (printing purpose), same format as Distribution
+	 */
+	friend std::ostream& operator<<(std::ostream& os, const QuantizedCdf& q){
+		for(uint32_t t(0) ; t < q._size ; ++t){
+			os << "(" << q.getSupT(t) << ";" << q.getPdfT(t) << ";" << q.getCdfT(t) << ") ";
+		}
+		return os;
+	}
+
+private:
+	static constexpr Quantum QMAX = std::numeric_limits<Quantum>::max();
+	static constexpr uint64_t EPSILON_QUANTA = uint64_t( EPSILON * std::numeric_limits<Quantum>::max() ); // EPSILON tolerance, in quanta (rounded down)
+
+	static Quantum quantize(const double& value) { return Quantum( std::min( std::max( value , 0.0 ) , 1.0 ) * QMAX + 0.5 ); }
+	static double dequantize(const Quantum& value) { return double(value) / QMAX; }
+	static bool isOne(const uint64_t& value) { return value + EPSILON_QUANTA >= QMAX; }
+
+	/*
+	 * quantumAt(const uint32_t&) method: return the stored quantum at a given index, including the implicit values outside the stored window
+	 */
+	Quantum quantumAt(const uint32_t& t) const {
+		if(t < _start){
+			return 0;
+		}
+		return (t - _start < _cdf.size()) ? _cdf[t - _start] : _cdf.back();
+	}
+
+	/*
+	 * lastIndex(const QuantizedCdf&) method: return the last index to check when comparing both cdf (one point after the union of both windows)
+	 */
+	uint32_t lastIndex(const QuantizedCdf& q) const {
+		return std::min( uint32_t( std::max( _start + _cdf.size() , q._start + q._cdf.size() ) ) , _size-1 );
+	}
+
+	/*
+	 * trim() method: remove the leading null quanta and the trailing repeated ones, then compute the cached min and max indexes
+	 * (same tolerances as Distribution::min and Distribution::max, on the dequantized values)
+	 */
+	void trim(){
+		uint32_t first(0), last(_cdf.size()-1);
+		while( first < last && _cdf[first] == 0 ){
+			++first;
+		}
+		while( last > first && _cdf[last] == _cdf[last-1] ){
+			--last;
+		}
+		_cdf.erase(_cdf.begin()+last+1, _cdf.end());
+		_cdf.erase(_cdf.begin(), _cdf.begin()+first);
+		_start += first;
+		_minIndex = _maxIndex = _size-1;
+		for(uint32_t i(_cdf.size()) ; i-- > 0 ; ){
+			if( gt( dequantize(_cdf[i]) , 0 ) ){
+				_minIndex = _start + i;
+			}
+			if( eq( dequantize(_cdf[i]) , 1 ) ){
+				_maxIndex = _start + i;
+			}
+		}
+	}
+
+	/*
+	 * Attributes
+	 */
+	uint32_t _size; // Number of support points
+	uint32_t _delta; // Difference between two consecutive support points
+	uint32_t _start; // Index of the first stored support point
+	std::vector<Quantum> _cdf; // Quantized cumulative distribution function (stored window only)
+	uint32_t _minIndex; // Index of the minimum possible realization
+	uint32_t _maxIndex; // Index of the maximum possible realization
+};
+
+template<typename Quantum> constexpr Quantum QuantizedCdf<Quantum>::QMAX;
+template<typename Quantum> constexpr uint64_t QuantizedCdf<Quantum>::EPSILON_QUANTA;
+
+#endif /* DATA_GRAPH_QUANTIZEDCDF_H_ */
@@ -0,0 +1,350 @@
+/*
+ * upwardgraph.cpp
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#include "upwardgraph.h"
+
+#include <algorithm> // Command stable_sort
+#include <numeric> // Commands iota, partial_sum
+#include <unordered_map>
+
+/*
+ * sortRows(const std::vector<Edge_id>&, std::vector<Node_id>&, std::vector<Node_id>&, std::vector<Weight_id>&) function: sort the edges of each
+ * CSR row by their other end (destination of forward edges, origin of backward edges), their current order breaking ties
+ */
+static void sortRows(const std::vector<Edge_id>& first, std::vector<Node_id>& ends, std::vector<Node_id>& middleNodes, std::vector<Weight_id>& weights){
+	std::vector<uint32_t> order;
+	std::vector<Node_id> rowEnds, rowMiddleNodes;
+	std::vector<Weight_id> rowWeights;
+	for(size_t l(0) ; l+1 < first.size() ; ++l){
+		const uint32_t begin( first[l] ), size( first[l+1] - first[l] );
+		order.resize( size );
+		std::iota( order.begin() , order.end() , 0 );
+		std::stable_sort( order.begin() , order.end() , [&ends,begin](const uint32_t& i1, const uint32_t& i2) -> bool {
+			return ends[begin+i1] < ends[begin+i2];
+		} );
+		rowEnds.assign( ends.begin() + begin , ends.begin() + begin + size );
+		rowMiddleNodes.assign( middleNodes.begin() + begin , middleNodes.begin() + begin + size );
+		rowWeights.assign( weights.begin() + begin , weights.begin() + begin + size );
+		for(uint32_t k(0) ; k < size ; ++k){
+			ends[begin+k] = rowEnds[order[k]];
+			middleNodes[begin+k] = rowMiddleNodes[order[k]];
+			weights[begin+k] = rowWeights[order[k]];
+		}
+	}
+}
+
+/*
+ * Constructors
+ * the upward edges of each node are copied level by level, in their order of the contracted graph (edges v->w with level(w) < level(v) are dropped)
+ * the scan constructor builds the same upward graph as the contracted graph made of the scanned edges (original ids, sortedNodes giving
+ * the original id of each level) would give, without gathering the edges: they are scanned twice, to count then to copy the upward edges
+ * of each level, rows being then sorted as in the contracted graph (the upward graph is left empty if an edge has an unknown node)
+ * the image constructor loads a hierarchy image written by write() into its own arrays, the image being unmapped afterwards
+ * (the upward graph is left empty if the image is not valid)
+ */
+UpwardGraph::UpwardGraph(): _fwFirst(1,Edge_id(0)), _bwFirst(1,Edge_id(0)){}
+UpwardGraph::UpwardGraph(const Graph& graph): _specif( graph.getSpecif() ), _permutation( graph.getPermutation() ), _levels( graph.getLevels() ){
+	const uint32_t nbNodes( _levels.size() );
+	_fwFirst.reserve( nbNodes+1 );
+	_bwFirst.reserve( nbNodes+1 );
+	for ( uint32_t l = 0 ; l < nbNodes ; ++l ){
+		const Node_id u( graph.getSortedNode(l) );
+		_fwFirst.push_back( Edge_id(_fwDestinations.size()) );
+		for ( Edge_id e = graph.getNodeBeginFW(u) ; e < graph.getNodeEndFW(u) ; ++e ){
+			if ( graph.getLevel( graph.getFwDestination(e) ) < l ){
+				continue;
+			}
+			_fwDestinations.push_back( graph.getFwDestination(e) );
+			_fwMiddleNodes.push_back( graph.getFwMiddleNode(e) );
+			_fwWeights.push_back( graph.getFwWeightId(e) );
+		}
+		_bwFirst.push_back( Edge_id(_bwOrigins.size()) );
+		for ( Edge_id e = graph.getNodeBeginBW(u) ; e < graph.getNodeEndBW(u) ; ++e ){
+			if ( graph.getLevel( graph.getBwOrigin(e) ) < l ){
+				continue;
+			}
+			_bwOrigins.push_back( graph.getBwOrigin(e) );
+			_bwMiddleNodes.push_back( graph.getBwMiddleNode(e) );
+			_bwWeights.push_back( graph.getBwWeightId(e) );
+		}
+	}
+	_fwFirst.push_back( Edge_id(_fwDestinations.size()) );
+	_bwFirst.push_back( Edge_id(_bwOrigins.size()) );
+}
+UpwardGraph::UpwardGraph(const EdgeScan& scan, const Specif& specif, const std::vector<Node_id>& sortedNodes): _fwFirst(1,Edge_id(0)), _bwFirst(1,Edge_id(0)){
+	if( !NodePermutation::isPermutation(sortedNodes) ){
+		ERROR("Invalid node order: some node ids are out of range or duplicated.\n");
+		return;
+	}
+	const uint32_t nbNodes( sortedNodes.size() );
+	const NodePermutation permutation( sortedNodes ); // Internal ids are levels
+	// Count the upward edges of each level: u->v is a forward edge of u if level(v) >= level(u), and a backward edge of v if level(u) >= level(v)
+	std::vector<uint32_t> fwOffsets( nbNodes+1 , 0 ), bwOffsets( nbNodes+1 , 0 );
+	bool valid(true);
+	scan( [&](const Edge& edge){
+		if( edge.getOrigin() >= nbNodes || edge.getDestination() >= nbNodes || ( edge.getMiddleNode() >= nbNodes && edge.getMiddleNode() != INVALID_NODE_ID ) ){
+			valid = false;
+			return;
+		}
+		const Node_id u( permutation.toInternal( edge.getOrigin() ) ), v( permutation.toInternal( edge.getDestination() ) );
+		if( v >= u ){
+			++fwOffsets[u+1];
+		}
+		if( u >= v ){
+			++bwOffsets[v+1];
+		}
+	} );
+	if( !valid ){
+		ERROR("Contracted graph edges with unknown nodes.\n");
+		return;
+	}
+	std::partial_sum( fwOffsets.begin() , fwOffsets.end() , fwOffsets.begin() );
+	std::partial_sum( bwOffsets.begin() , bwOffsets.end() , bwOffsets.begin() );
+	// Copy the upward edges in their scan order, then sort each row
+	std::vector<uint32_t> fwCursors( fwOffsets.begin() , fwOffsets.end() - 1 ), bwCursors( bwOffsets.begin() , bwOffsets.end() - 1 );
+	_fwDestinations.resize( fwOffsets[nbNodes] );
+	_fwMiddleNodes.resize( fwOffsets[nbNodes] );
+	_fwWeights.resize( fwOffsets[nbNodes] );
+	_bwOrigins.resize( bwOffsets[nbNodes] );
+	_bwMiddleNodes.resize( bwOffsets[nbNodes] );
+	_bwWeights.resize( bwOffsets[nbNodes] );
+	scan( [&](const Edge& edge){
+		const Node_id u( permutation.toInternal( edge.getOrigin() ) ), v( permutation.toInternal( edge.getDestination() ) );
+		const Node_id middleNode( permutation.toInternal( edge.getMiddleNode() ) );
+		if( v >= u ){
+			const uint32_t e( fwCursors[u]++ );
+			_fwDestinations[e] = v;
+			_fwMiddleNodes[e] = middleNode;
+			_fwWeights[e] = edge.getWeightId();
+		}
+		if( u >= v ){
+			const uint32_t e( bwCursors[v]++ );
+			_bwOrigins[e] = u;
+			_bwMiddleNodes[e] = middleNode;
+			_bwWeights[e] = edge.getWeightId();
+		}
+	} );
+	_fwFirst.assign( fwOffsets.begin() , fwOffsets.end() );
+	_bwFirst.assign( bwOffsets.begin() , bwOffsets.end() );
+	sortRows( _fwFirst , _fwDestinations , _fwMiddleNodes , _fwWeights );
+	sortRows( _bwFirst , _bwOrigins , _bwMiddleNodes , _bwWeights );
+	_specif = specif;
+	_permutation = permutation;
+	_levels.resize( nbNodes );
+	std::iota( _levels.begin() , _levels.end() , 0 );
+}
+UpwardGraph::UpwardGraph(const std::string& imageFileName): _fwFirst(1,Edge_id(0)), _bwFirst(1,Edge_id(0)){
+	HierarchyImageIO image( imageFileName );
+	if( !image.isValid() ){
+		return;
+	}
+	const HierarchyImageIO::Header& header( image.getHeader() );
+	const uint32_t nbNodes( header.nbNodes );
+	const uint32_t* fwFirst( image.getSection<uint32_t>(HierarchyImageIO::FW_FIRST) );
+	const uint32_t* bwFirst( image.getSection<uint32_t>(HierarchyImageIO::BW_FIRST) );
+	const uint32_t* fwWeights( image.getSection<uint32_t>(HierarchyImageIO::FW_WEIGHTS) );
+	const uint32_t* bwWeights( image.getSection<uint32_t>(HierarchyImageIO::BW_WEIGHTS) );
+	const uint64_t* weightOffsets( image.getSection<uint64_t>(HierarchyImageIO::WEIGHT_OFFSETS) );
+	bool valid( image.getCount<uint32_t>(HierarchyImageIO::ORIGINAL_IDS) == nbNodes && image.getCount<uint32_t>(HierarchyImageIO::LEVELS) == nbNodes
+			&& image.getCount<uint32_t>(HierarchyImageIO::FW_FIRST) == nbNodes+1 && image.getCount<uint32_t>(HierarchyImageIO::BW_FIRST) == nbNodes+1
+			&& image.getCount<uint64_t>(HierarchyImageIO::WEIGHT_OFFSETS) == header.nbWeights+1
+			&& image.getCount<uint32_t>(HierarchyImageIO::WEIGHT_SIZES) == header.nbWeights && image.getCount<uint32_t>(HierarchyImageIO::WEIGHT_DELTAS) == header.nbWeights
+			&& image.getCount<uint32_t>(HierarchyImageIO::WEIGHT_STARTS) == header.nbWeights );
+	valid = valid && weightOffsets[header.nbWeights] == image.getCount<double>(HierarchyImageIO::WEIGHT_VALUES);
+	for(const HierarchyImageIO::Section& section: { HierarchyImageIO::FW_DESTINATIONS , HierarchyImageIO::FW_MIDDLE_NODES , HierarchyImageIO::FW_WEIGHTS }){
+		valid = valid && image.getCount<uint32_t>(section) == fwFirst[nbNodes];
+	}
+	for(const HierarchyImageIO::Section& section: { HierarchyImageIO::BW_ORIGINS , HierarchyImageIO::BW_MIDDLE_NODES , HierarchyImageIO::BW_WEIGHTS }){
+		valid = valid && image.getCount<uint32_t>(section) == bwFirst[nbNodes];
+	}
+	for(uint32_t e(0) ; valid && e < fwFirst[nbNodes] ; ++e){
+		valid = fwWeights[e] < header.nbWeights;
+	}
+	for(uint32_t e(0) ; valid && e < bwFirst[nbNodes] ; ++e){
+		valid = bwWeights[e] < header.nbWeights;
+	}
+	if( !valid ){
+		ERROR("Hierarchy image '" << imageFileName << "' corrupted: inconsistent section sizes.\n");
+		return;
+	}
+	// Edge ranges and weight positions must be monotonic, node ids must be in range (middle nodes may be INVALID_NODE_ID), original ids and
+	// levels must be permutations, and each weight window must fit in its support
+	const uint32_t* originalIds( image.getSection<uint32_t>(HierarchyImageIO::ORIGINAL_IDS) );
+	const uint32_t* levels( image.getSection<uint32_t>(HierarchyImageIO::LEVELS) );
+	const uint32_t* fwDestinations( image.getSection<uint32_t>(HierarchyImageIO::FW_DESTINATIONS) );
+	const uint32_t* fwMiddleNodes( image.getSection<uint32_t>(HierarchyImageIO::FW_MIDDLE_NODES) );
+	const uint32_t* bwOrigins( image.getSection<uint32_t>(HierarchyImageIO::BW_ORIGINS) );
+	const uint32_t* bwMiddleNodes( image.getSection<uint32_t>(HierarchyImageIO::BW_MIDDLE_NODES) );
+	const uint32_t* weightSizes( image.getSection<uint32_t>(HierarchyImageIO::WEIGHT_SIZES) );
+	const uint32_t* weightStarts( image.getSection<uint32_t>(HierarchyImageIO::WEIGHT_STARTS) );
+	valid = fwFirst[0] == 0 && bwFirst[0] == 0 && weightOffsets[0] == 0;
+	for(uint32_t l(0) ; valid && l < nbNodes ; ++l){
+		valid = fwFirst[l] <= fwFirst[l+1] && bwFirst[l] <= bwFirst[l+1];
+	}
+	for(uint32_t w(0) ; valid && w < header.nbWeights ; ++w){
+		valid = weightOffsets[w] < weightOffsets[w+1] && weightStarts[w] + ( weightOffsets[w+1] - weightOffsets[w] ) <= weightSizes[w];
+	}
+	for(uint32_t e(0) ; valid && e < fwFirst[nbNodes] ; ++e){
+		valid = fwDestinations[e] < nbNodes && ( fwMiddleNodes[e] < nbNodes || fwMiddleNodes[e] == INVALID_NODE_ID );
+	}
+	for(uint32_t e(0) ; valid && e < bwFirst[nbNodes] ; ++e){
+		valid = bwOrigins[e] < nbNodes && ( bwMiddleNodes[e] < nbNodes || bwMiddleNodes[e] == INVALID_NODE_ID );
+	}
+	std::vector<Node_id> permutation( originalIds , originalIds + nbNodes );
+	valid = valid && NodePermutation::isPermutation(permutation) && NodePermutation::isPermutation( std::vector<Node_id>( levels , levels + nbNodes ) );
+	if( !valid ){
+		ERROR("Hierarchy image '" << imageFileName << "' corrupted: invalid node ids, edge ranges or weights.\n");
+		return;
+	}
+	_specif = Specif( nbNodes , header.nbEdges , header.nbPts , header.delta );
+	_permutation = NodePermutation( permutation );
+	_levels.assign( levels , levels + nbNodes );
+	_fwFirst.assign( fwFirst , fwFirst + nbNodes + 1 );
+	_bwFirst.assign( bwFirst , bwFirst + nbNodes + 1 );
+	_fwDestinations.assign( fwDestinations , fwDestinations + fwFirst[nbNodes] );
+	_fwMiddleNodes.assign( fwMiddleNodes , fwMiddleNodes + fwFirst[nbNodes] );
+	_bwOrigins.assign( bwOrigins , bwOrigins + bwFirst[nbNodes] );
+	_bwMiddleNodes.assign( bwMiddleNodes , bwMiddleNodes + bwFirst[nbNodes] );
+	// Weights are interned once per distinct distribution (the cdf being the partial sums of the pdf, as in text files), edges then get the dictionary id of their weight
+	const uint32_t* weightDeltas( image.getSection<uint32_t>(HierarchyImageIO::WEIGHT_DELTAS) );
+	const double* weightValues( image.getSection<double>(HierarchyImageIO::WEIGHT_VALUES) );
+	std::vector<Weight_id> weightIds( header.nbWeights );
+	std::vector<double> pdf, cdf;
+	for(uint32_t w(0) ; w < header.nbWeights ; ++w){
+		pdf.assign( weightValues + weightOffsets[w] , weightValues + weightOffsets[w+1] );
+		cdf.resize( pdf.size() );
+		std::partial_sum( pdf.begin() , pdf.end() , cdf.begin() );
+		weightIds[w] = getWeightDictionary().intern( Distribution( weightSizes[w] , weightDeltas[w] , weightStarts[w] , pdf , cdf ) );
+	}
+	_fwWeights.resize( fwFirst[nbNodes] );
+	for(uint32_t e(0) ; e < fwFirst[nbNodes] ; ++e){
+		_fwWeights[e] = weightIds[ fwWeights[e] ];
+	}
+	_bwWeights.resize( bwFirst[nbNodes] );
+	for(uint32_t e(0) ; e < bwFirst[nbNodes] ; ++e){
+		_bwWeights[e] = weightIds[ bwWeights[e] ];
+	}
+}
+
+/*
+ * Getters
+ */
+const Specif& UpwardGraph::getSpecif() const { return _specif; }
+const NodePermutation& UpwardGraph::getPermutation() const { return _permutation; }
+uint32_t UpwardGraph::getNbNodes() const { return _levels.size(); }
+uint32_t UpwardGraph::getNbFwEdges() const { return _fwDestinations.size(); }
+uint32_t UpwardGraph::getNbBwEdges() const { return _bwOrigins.size(); }
+uint32_t UpwardGraph::getLevel(const Node_id& n) const { return _levels[n]; }
+Edge_id UpwardGraph::getNodeBeginFW(const Node_id& n) const { return _fwFirst[ _levels[n] ]; }
+Edge_id UpwardGraph::getNodeEndFW(const Node_id& n) const { return _fwFirst[ _levels[n]+1 ]; }
+Edge_id UpwardGraph::getNodeBeginBW(const Node_id& n) const { return _bwFirst[ _levels[n] ]; }
+Edge_id UpwardGraph::getNodeEndBW(const Node_id& n) const { return _bwFirst[ _levels[n]+1 ]; }
+Node_id UpwardGraph::getFwDestination(const Edge_id& e) const { return _fwDestinations[e]; }
+Node_id UpwardGraph::getBwOrigin(const Edge_id& e) const { return _bwOrigins[e]; }
+Node_id UpwardGraph::getFwMiddleNode(const Edge_id& e) const { return _fwMiddleNodes[e]; }
+Node_id UpwardGraph::getBwMiddleNode(const Edge_id& e) const { return _bwMiddleNodes[e]; }
+Weight_id UpwardGraph::getFwWeightId(const Edge_id& e) const { return _fwWeights[e]; }
+Weight_id UpwardGraph::getBwWeightId(const Edge_id& e) const { return _bwWeights[e]; }
+WeightView UpwardGraph::getFwWeight(const Edge_id& e) const { return getWeightDictionary().getDistribution( _fwWeights[e] ); }
+WeightView UpwardGraph::getBwWeight(const Edge_id& e) const { return getWeightDictionary().getDistribution( _bwWeights[e] ); }
+
+/*
+ * identifyFwEdge(const Node_id&, const Node_id&) method: if there is an upward forward edge between given source and destination, return its id (INVALID_EDGE_ID otherwise)
+ */
+Edge_id UpwardGraph::identifyFwEdge(const Node_id& origin, const Node_id& destination) const {
+	for ( Edge_id e = getNodeBeginFW(origin) ; e != getNodeEndFW(origin) ; ++e ){
+		if ( _fwDestinations[e] == destination ){
+			return e;
+		}
+	}
+	return INVALID_EDGE_ID;
+}
+
+/*
+ * identifyBwEdge(const Node_id&, const Node_id&) method: if there is an upward backward edge between given source and destination, return its id (INVALID_EDGE_ID otherwise)
+ */
+Edge_id UpwardGraph::identifyBwEdge(const Node_id& origin, const Node_id& destination) const {
+	for ( Edge_id e = getNodeBeginBW(destination) ; e != getNodeEndBW(destination) ; ++e ){
+		if ( _bwOrigins[e] == origin ){
+			return e;
+		}
+	}
+	return INVALID_EDGE_ID;
+}
+
+/*
+ * write(const std::string&) method: write the upward graph into a hierarchy image (see HierarchyImageIO), that the image constructor loads
+ * each distinct weight is written once (pdf of the stored window only), in the order of its first use by the forward then the backward edges
+ */
+void UpwardGraph::write(const std::string& imageFileName) const {
+	static_assert( sizeof(Node_id) == sizeof(uint32_t) && sizeof(Edge_id) == sizeof(uint32_t) , "Node and edge ids are written as uint32_t" );
+	const uint32_t nbNodes( getNbNodes() );
+	std::vector<uint32_t> originalIds( nbNodes ), sortedNodes( nbNodes );
+	for(uint32_t n(0) ; n < nbNodes ; ++n){
+		originalIds[n] = _permutation.toOriginal( Node_id(n) );
+		sortedNodes[ _levels[n] ] = n;
+	}
+	std::unordered_map<uint32_t,uint32_t> weightIndexes; // Index of each written weight, by dictionary id
+	std::vector<uint32_t> weightSizes, weightDeltas, weightStarts;
+	std::vector<uint64_t> weightOffsets(1,0);
+	std::vector<double> weightValues;
+	std::vector<uint32_t> fwWeights( _fwWeights.size() ), bwWeights( _bwWeights.size() );
+	for(uint32_t d(0) ; d < 2 ; ++d){
+		const std::vector<Weight_id>& edgeWeights( d == 0 ? _fwWeights : _bwWeights );
+		std::vector<uint32_t>& indexes( d == 0 ? fwWeights : bwWeights );
+		for(uint32_t e(0) ; e < edgeWeights.size() ; ++e){
+			auto inserted = weightIndexes.insert( std::make_pair( uint32_t(edgeWeights[e]) , uint32_t(weightSizes.size()) ) );
+			if( inserted.second ){
+				WeightView dist( getWeightDictionary().getDistribution( edgeWeights[e] ) );
+				weightSizes.push_back( dist.getSize() );
+				weightDeltas.push_back( dist.getDelta() );
+				weightStarts.push_back( dist.getWindowBegin() );
+				for(uint32_t t(dist.getWindowBegin()) ; t < dist.getWindowEnd() ; ++t){
+					weightValues.push_back( dist.getPdfT(t) );
+				}
+				weightOffsets.push_back( weightValues.size() );
+			}
+			indexes[e] = inserted.first->second;
+		}
+	}
+	HierarchyImageIO::Header header;
+	header.nbNodes = nbNodes;
+	header.nbEdges = _specif.getNbEdges();
+	header.nbPts = _specif.getNbPts();
+	header.delta = _specif.getDelta();
+	header.nbWeights = weightSizes.size();
+	std::vector< std::pair<const void*,size_t> > sections( HierarchyImageIO::NB_SECTIONS );
+	sections[HierarchyImageIO::ORIGINAL_IDS] = std::make_pair( originalIds.data() , originalIds.size() * sizeof(uint32_t) );
+	sections[HierarchyImageIO::LEVELS] = std::make_pair( _levels.data() , _levels.size() * sizeof(uint32_t) );
+	sections[HierarchyImageIO::SORTED_NODES] = std::make_pair( sortedNodes.data() , sortedNodes.size() * sizeof(uint32_t) );
+	sections[HierarchyImageIO::FW_FIRST] = std::make_pair( _fwFirst.data() , _fwFirst.size() * sizeof(Edge_id) );
+	sections[HierarchyImageIO::FW_DESTINATIONS] = std::make_pair( _fwDestinations.data() , _fwDestinations.size() * sizeof(Node_id) );
+	sections[HierarchyImageIO::FW_MIDDLE_NODES] = std::make_pair( _fwMiddleNodes.data() , _fwMiddleNodes.size() * sizeof(Node_id) );
+	sections[HierarchyImageIO::FW_WEIGHTS] = std::make_pair( fwWeights.data() , fwWeights.size() * sizeof(uint32_t) );
+	sections[HierarchyImageIO::BW_FIRST] = std::make_pair( _bwFirst.data() , _bwFirst.size() * sizeof(Edge_id) );
+	sections[HierarchyImageIO::BW_ORIGINS] = std::make_pair( _bwOrigins.data() , _bwOrigins.size() * sizeof(Node_id) );
+	sections[HierarchyImageIO::BW_MIDDLE_NODES] = std::make_pair( _bwMiddleNodes.data() , _bwMiddleNodes.size() * sizeof(Node_id) );
+	sections[HierarchyImageIO::BW_WEIGHTS] = std::make_pair( bwWeights.data() , bwWeights.size() * sizeof(uint32_t) );
+	sections[HierarchyImageIO::WEIGHT_SIZES] = std::make_pair( weightSizes.data() , weightSizes.size() * sizeof(uint32_t) );
+	sections[HierarchyImageIO::WEIGHT_DELTAS] = std::make_pair( weightDeltas.data() , weightDeltas.size() * sizeof(uint32_t) );
+	sections[HierarchyImageIO::WEIGHT_STARTS] = std::make_pair( weightStarts.data() , weightStarts.size() * sizeof(uint32_t) );
+	sections[HierarchyImageIO::WEIGHT_OFFSETS] = std::make_pair( weightOffsets.data() , weightOffsets.size() * sizeof(uint64_t) );
+	sections[HierarchyImageIO::WEIGHT_VALUES] = std::make_pair( weightValues.data() , weightValues.size() * sizeof(double) );
+	HierarchyImageIO::write( imageFileName , header , sections );
+}
+
+/*
+ * memoryFootprint() method: return the memory held by the upward graph: node data, topology (CSR arrays) and weight ids
+ */
+MemoryFootprint UpwardGraph::memoryFootprint() const {
+	MemoryFootprint footprint("UpwardGraph");
+	footprint.add("nodes", MemoryFootprint::bytes(_levels) + _permutation.getMemorySize());
+	footprint.add("topology", MemoryFootprint::bytes(_fwFirst) + MemoryFootprint::bytes(_fwDestinations) + MemoryFootprint::bytes(_fwMiddleNodes)
+			+ MemoryFootprint::bytes(_bwFirst) + MemoryFootprint::bytes(_bwOrigins) + MemoryFootprint::bytes(_bwMiddleNodes));
+	footprint.add("weight ids", MemoryFootprint::bytes(_fwWeights) + MemoryFootprint::bytes(_bwWeights));
+	return footprint;
+}
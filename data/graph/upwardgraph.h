@@ -0,0 +1,97 @@
+/*
+ * upwardgraph.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_GRAPH_UPWARDGRAPH_H_
+#define DATA_GRAPH_UPWARDGRAPH_H_
+
+#include <functional>
+#include <vector>
+
+#include "../../misc.h"
+#include "../../data_io/hierarchyimage_io.h"
+#include "graph.h"
+#include "weightdictionary.h"
+
+/*
+ * Class UpwardGraph: compact, read-only version of a contracted graph, for querying purpose
+ * Only the upward edges are kept (forward edges u->v and backward edges v->u such that v has a larger level than u), in CSR form:
+ * the edges of the node of level l are stored between _fwFirst[l] (resp. _bwFirst[l]) and _fwFirst[l+1] (resp. _bwFirst[l+1]), without any dummy edge.
+ * Nodes keep their ids (as search structures and paths do); the adjacency arrays are sorted by level, so that upward searches
+ * scan them in increasing address order. Edge ids handled by the query and the paths are indexes in these arrays.
+ */
+class UpwardGraph{
+public:
+	typedef std::function< void(const std::function<void(const Edge&)>&) > EdgeScan; // Scan of the contracted graph edges (see EdgeSink::scanEdges())
+
+	/*
+	 * Constructors
+	 */
+	UpwardGraph();
+	UpwardGraph(const Graph& graph);
+	UpwardGraph(const EdgeScan& scan, const Specif& specif, const std::vector<Node_id>& sortedNodes);
+	UpwardGraph(const std::string& imageFileName);
+
+	/*
+	 * Getters
+	 */
+	const Specif& getSpecif() const;
+	const NodePermutation& getPermutation() const;
+	uint32_t getNbNodes() const;
+	uint32_t getNbFwEdges() const;
+	uint32_t getNbBwEdges() const;
+	uint32_t getLevel(const Node_id& n) const;
+	Edge_id getNodeBeginFW(const Node_id& n) const;
+	Edge_id getNodeEndFW(const Node_id& n) const;
+	Edge_id getNodeBeginBW(const Node_id& n) const;
+	Edge_id getNodeEndBW(const Node_id& n) const;
+	Node_id getFwDestination(const Edge_id& e) const;
+	Node_id getBwOrigin(const Edge_id& e) const;
+	Node_id getFwMiddleNode(const Edge_id& e) const;
+	Node_id getBwMiddleNode(const Edge_id& e) const;
+	Weight_id getFwWeightId(const Edge_id& e) const;
+	Weight_id getBwWeightId(const Edge_id& e) const;
+	WeightView getFwWeight(const Edge_id& e) const;
+	WeightView getBwWeight(const Edge_id& e) const;
+
+	/*
+	 * identifyFwEdge(const Node_id&, const Node_id&) method: if there is an upward forward edge between given source and destination, return its id (INVALID_EDGE_ID otherwise)
+	 */
+	Edge_id identifyFwEdge(const Node_id& origin, const Node_id& destination) const;
+
+	/*
+	 * identifyBwEdge(const Node_id&, const Node_id&) method: if there is an upward backward edge between given source and destination, return its id (INVALID_EDGE_ID otherwise)
+	 */
+	Edge_id identifyBwEdge(const Node_id& origin, const Node_id& destination) const;
+
+	/*
+	 * write(const std::string&) method: write the upward graph into a hierarchy image (see HierarchyImageIO), that the image constructor loads
+	 */
+	void write(const std::string& imageFileName) const;
+
+	/*
+	 * memoryFootprint() method: return the memory held by the upward graph: node data, topology (CSR arrays) and weight ids
+	 */
+	MemoryFootprint memoryFootprint() const;
+
+private:
+	/*
+	 * Attributes
+	 */
+	Specif _specif; // Instance specification
+	NodePermutation _permutation; // Correspondence between original and internal node ids (the ones of the contracted graph)
+	std::vector<uint32_t> _levels; // Node level into the hierarchy (sorted by nodes), ie the CSR row of each node
+	std::vector<Edge_id> _fwFirst; // First upward forward edge of each level (plus the total number of forward edges)
+	std::vector<Node_id> _fwDestinations; // Destination of each upward forward edge
+	std::vector<Node_id> _fwMiddleNodes; // Middle node of each upward forward edge (INVALID_NODE_ID for original edges)
+	std::vector<Weight_id> _fwWeights; // Weight id of each upward forward edge
+	std::vector<Edge_id> _bwFirst; // First upward backward edge of each level (plus the total number of backward edges)
+	std::vector<Node_id> _bwOrigins; // Origin of each upward backward edge
+	std::vector<Node_id> _bwMiddleNodes; // Middle node of each upward backward edge (INVALID_NODE_ID for original edges)
+	std::vector<Weight_id> _bwWeights; // Weight id of each upward backward edge
+};
+
+#endif /* DATA_GRAPH_UPWARDGRAPH_H_ */
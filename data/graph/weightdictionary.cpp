@@ -0,0 +1,157 @@
+/*
+ * weightdictionary.cpp
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#include "weightdictionary.h"
+
+#include <algorithm> // Command min
+#include <cstdlib> // Command abort
+
+const Weight_id WeightDictionary::DEFAULT_WEIGHT_ID(0);
+
+/*
+ * Constructor: the default distribution gets the first id
+ */
+WeightDictionary::WeightDictionary(): _nbWeights(0){
+	intern( Distribution() );
+}
+
+/*
+ * Getters
+ */
+uint32_t WeightDictionary::getNbWeights() const { return _nbWeights; }
+
+/*
+ * get(const Weight_id&) method: return the weight stored with the given id
+ * no lock is needed: a stored weight is never modified nor moved, and its id is known by the caller only once it is stored
+ */
+const EdgeWeight& WeightDictionary::get(const Weight_id& id) const{
+	assert( id < _nbWeights );
+	const uint32_t chunk( id / CHUNK_SIZE );
+	return _chunkTable[chunk / CHUNKS_PER_BLOCK][chunk % CHUNKS_PER_BLOCK][id % CHUNK_SIZE];
+}
+
+/*
+ * at(const uint32_t&) method: return the storage slot of the given id (its chunk must be allocated)
+ */
+EdgeWeight& WeightDictionary::at(const uint32_t& id){
+	const uint32_t chunk( id / CHUNK_SIZE );
+	return _chunkTable[chunk / CHUNKS_PER_BLOCK][chunk % CHUNKS_PER_BLOCK][id % CHUNK_SIZE];
+}
+
+/*
+ * getDistribution(const Weight_id&) method: return the distribution stored with the given id (see WeightView)
+ */
+#ifdef SCH_QUANTIZED_WEIGHTS
+WeightView WeightDictionary::getDistribution(const Weight_id& id) const { return get(id).toDistribution(); }
+#else
+WeightView WeightDictionary::getDistribution(const Weight_id& id) const { return get(id); }
+#endif
+
+/*
+ * intern(const Distribution&) method: return the id of the given distribution, after storing it if it is not in the dictionary yet
+ * weights are compared in their storage format (hence with quantized weights, distributions with the same quanta share their id)
+ */
+Weight_id WeightDictionary::intern(const Distribution& dist){
+	DistributionArena::Scope heapScope; // Stored weights live as long as the dictionary, their buffers are not taken from thread arenas
+	EdgeWeight weight(dist);
+#ifndef SCH_QUANTIZED_WEIGHTS
+	weight.updateSummary(); // Summary queries on stored weights are then O(1)
+#endif
+	const size_t key( weight.hash() );
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto range = _index.equal_range(key);
+	for(auto it = range.first ; it != range.second ; ++it){
+		if( get(it->second) == weight ){
+			return it->second;
+		}
+	}
+	const uint32_t id( _nbWeights );
+	const uint32_t chunk( id / CHUNK_SIZE );
+	if( id % CHUNK_SIZE == 0 ){
+		if( chunk >= MAX_CHUNKS ){
+			ERROR("Weight dictionary is full (" << id << " weights).\n");
+			std::abort();
+		}
+		if( chunk % CHUNKS_PER_BLOCK == 0 ){
+			_chunkTable[chunk / CHUNKS_PER_BLOCK].reset( new std::unique_ptr<EdgeWeight[]>[CHUNKS_PER_BLOCK] );
+		}
+		_chunkTable[chunk / CHUNKS_PER_BLOCK][chunk % CHUNKS_PER_BLOCK].reset( new EdgeWeight[CHUNK_SIZE] );
+	}
+	at(id) = std::move(weight);
+	_index.insert( std::make_pair( key , Weight_id(id) ) );
+	++_nbWeights;
+	return Weight_id(id);
+}
+
+/*
+ * compact(const std::vector<bool>&) method: keep the used weights (and the default one), renumbered in their order, and release the other ones;
+ * return the new id of each former id (INVALID_WEIGHT_ID for a released weight)
+ * kept weights are moved down in place (a new id is never greater than the former one), then the chunks beyond the last kept weight are
+ * released and the index is rebuilt
+ */
+std::vector<Weight_id> WeightDictionary::compact(const std::vector<bool>& used){
+	DistributionArena::Scope heapScope; // Released weights give their buffers back to the heap
+	std::lock_guard<std::mutex> lock(_mutex);
+	const uint32_t nbWeights( _nbWeights );
+	std::vector<Weight_id> newIds( nbWeights , INVALID_WEIGHT_ID );
+	std::unordered_multimap<size_t, Weight_id> index;
+	uint32_t nbKept(0);
+	for(uint32_t id(0) ; id < nbWeights ; ++id){
+		if( id == DEFAULT_WEIGHT_ID || ( id < used.size() && used[id] ) ){
+			if( nbKept != id ){
+				at(nbKept) = std::move( at(id) );
+			}
+			index.insert( std::make_pair( at(nbKept).hash() , Weight_id(nbKept) ) );
+			newIds[id] = Weight_id(nbKept);
+			++nbKept;
+		}
+	}
+	const uint32_t nbChunks( ( nbWeights + CHUNK_SIZE - 1 ) / CHUNK_SIZE ), nbKeptChunks( ( nbKept + CHUNK_SIZE - 1 ) / CHUNK_SIZE );
+	for(uint32_t id(nbKept) ; id < std::min( nbWeights , nbKeptChunks * CHUNK_SIZE ) ; ++id){
+		at(id) = EdgeWeight();
+	}
+	for(uint32_t chunk(nbChunks) ; chunk > nbKeptChunks ; --chunk){ // From the last chunk, so that a block is released after its chunks
+		_chunkTable[(chunk - 1) / CHUNKS_PER_BLOCK][(chunk - 1) % CHUNKS_PER_BLOCK].reset();
+		if( ( chunk - 1 ) % CHUNKS_PER_BLOCK == 0 ){
+			_chunkTable[(chunk - 1) / CHUNKS_PER_BLOCK].reset();
+		}
+	}
+	_index.swap(index);
+	_nbWeights = nbKept;
+	return newIds;
+}
+
+/*
+ * clear() method: release all the weights but the default one
+ */
+void WeightDictionary::clear(){ compact( std::vector<bool>() ); }
+
+/*
+ * getWeightDictionary() method: return the weight dictionary of the process
+ */
+WeightDictionary& getWeightDictionary(){
+	static WeightDictionary dictionary;
+	return dictionary;
+}
+
+/*
+ * memoryFootprint() method: return the memory held by the dictionary: stored weights, unused slots of the last chunk, chunk table and hash index
+ */
+MemoryFootprint WeightDictionary::memoryFootprint() const {
+	MemoryFootprint footprint("WeightDictionary");
+	std::lock_guard<std::mutex> lock(_mutex);
+	const uint32_t nbWeights( _nbWeights );
+	size_t weightBytes( nbWeights * sizeof(EdgeWeight) );
+	for(uint32_t id(0) ; id < nbWeights ; ++id){
+		weightBytes += get(Weight_id(id)).getMemorySize();
+	}
+	footprint.add("weights", weightBytes);
+	footprint.add("unused slots", ( CHUNK_SIZE - 1 - ( nbWeights + CHUNK_SIZE - 1 ) % CHUNK_SIZE ) * sizeof(EdgeWeight));
+	footprint.add("chunk table", sizeof(_chunkTable) + ( nbWeights + CHUNK_SIZE * CHUNKS_PER_BLOCK - 1 ) / ( CHUNK_SIZE * CHUNKS_PER_BLOCK ) * CHUNKS_PER_BLOCK * sizeof(std::unique_ptr<EdgeWeight[]>));
+	footprint.add("index", MemoryFootprint::bytes(_index));
+	return footprint;
+}
@@ -0,0 +1,126 @@
+/*
+ * weightdictionary.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_GRAPH_WEIGHTDICTIONARY_H_
+#define DATA_GRAPH_WEIGHTDICTIONARY_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../../misc.h"
+#include "distribution.h"
+#include "memoryfootprint.h"
+#include "quantizedcdf.h"
+
+/*
+ * Edge weight storage: edge weights are kept as Distribution by default; building with SCH_QUANTIZED_WEIGHTS set to 16 or 32
+ * (eg -DSCH_QUANTIZED_WEIGHTS=16) stores them as fixed-point cdf instead (see QuantizedCdf), with a much smaller memory footprint
+ */
+#if !defined(SCH_QUANTIZED_WEIGHTS)
+typedef Distribution EdgeWeight;
+#elif SCH_QUANTIZED_WEIGHTS == 16
+typedef QuantizedCdf<uint16_t> EdgeWeight;
+#elif SCH_QUANTIZED_WEIGHTS == 32
+typedef QuantizedCdf<uint32_t> EdgeWeight;
+#else
+#error "SCH_QUANTIZED_WEIGHTS must be 16 or 32"
+#endif
+
+/*
+ * WeightView: read-only access to a stored weight as a Distribution, a reference into the dictionary by default (no copy),
+ * a converted value if weights are quantized
+ */
+#ifdef SCH_QUANTIZED_WEIGHTS
+typedef Distribution WeightView;
+#else
+typedef const Distribution& WeightView;
+#endif
+
+/*
+ * class WeightDictionary: store each distinct edge weight once, edges refer to it through a 32-bit Weight_id
+ * Weights are stored by chunks that are never moved, so that get() needs no lock; intern() is thread-safe. The chunk table is made of
+ * blocks of CHUNKS_PER_BLOCK chunk pointers, allocated as the dictionary grows (neither blocks nor chunks are moved once allocated).
+ * The dictionary is shared by all the graphs of the process (see getWeightDictionary()): only the weights of graph edges are interned
+ * (intermediate convolution results are kept by ConvolutionCache). Weights are released by compact(), the ordering process keeping the
+ * ones still referred to by its graph and its edge sink, or by clear() once no graph of the previous instance is left.
+ */
+class WeightDictionary{
+public:
+	/*
+	 * Constructors
+	 */
+	WeightDictionary();
+	WeightDictionary(const WeightDictionary&) = delete;
+	WeightDictionary& operator=(const WeightDictionary&) = delete;
+
+	/*
+	 * Getters
+	 */
+	uint32_t getNbWeights() const;
+
+	/*
+	 * get(const Weight_id&) method: return the weight stored with the given id
+	 */
+	const EdgeWeight& get(const Weight_id& id) const;
+
+	/*
+	 * getDistribution(const Weight_id&) method: return the distribution stored with the given id (see WeightView)
+	 */
+	WeightView getDistribution(const Weight_id& id) const;
+
+	/*
+	 * intern(const Distribution&) method: return the id of the given distribution, after storing it if it is not in the dictionary yet
+	 * (the process is aborted if the dictionary is full)
+	 */
+	Weight_id intern(const Distribution& dist);
+
+	/*
+	 * compact(const std::vector<bool>&) method: keep the weights whose ids are marked as used (and the default one), renumbered in their
+	 * order, and release the other ones; return the new id of each former id (INVALID_WEIGHT_ID for a released weight)
+	 * the caller must then replace every former id it holds, no other thread using the dictionary meanwhile
+	 */
+	std::vector<Weight_id> compact(const std::vector<bool>& used);
+
+	/*
+	 * clear() method: release all the weights but the default one (every id handed out before, but DEFAULT_WEIGHT_ID, is no longer valid)
+	 */
+	void clear();
+
+	static constexpr uint32_t CHUNK_SIZE = 1024; // Number of weights per storage chunk
+	static constexpr uint32_t CHUNKS_PER_BLOCK = 1024; // Number of chunk pointers per block of the chunk table
+	static constexpr uint32_t MAX_CHUNKS = 1 << 20; // Maximal number of storage chunks
+	static const Weight_id DEFAULT_WEIGHT_ID; // Id of the default distribution (Distribution()), stored at construction
+
+	/*
+	 * memoryFootprint() method: return the memory held by the dictionary: stored weights, unused slots of the last chunk, chunk table and hash index
+	 */
+	MemoryFootprint memoryFootprint() const;
+
+private:
+	/*
+	 * at(const uint32_t&) method: return the storage slot of the given id (its chunk must be allocated)
+	 */
+	EdgeWeight& at(const uint32_t& id);
+
+	/*
+	 * Attributes
+	 */
+	std::unique_ptr< std::unique_ptr<EdgeWeight[]>[] > _chunkTable[MAX_CHUNKS / CHUNKS_PER_BLOCK]; // Weight storage: blocks of chunk pointers, then chunks
+	std::atomic<uint32_t> _nbWeights; // Number of stored weights
+	std::unordered_multimap<size_t, Weight_id> _index; // Stored weight ids, indexed by weight hash values
+	mutable std::mutex _mutex; // Lock on the index and the storage growth
+};
+
+/*
+ * getWeightDictionary() method: return the weight dictionary of the process
+ */
+WeightDictionary& getWeightDictionary();
+
+#endif /* DATA_GRAPH_WEIGHTDICTIONARY_H_ */
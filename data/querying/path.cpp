@@ -6,6 +6,7 @@
  */
 
 #include "path.h"
+#include "../graph/memoryfootprint.h"
 #include <map>
 #include <stack>
 
@@ -150,11 +151,11 @@ void Path::develop(const Graph* g){
 			Node_id midnod(INVALID_NODE_ID);
 			if( g->getLevel(u) < g->getLevel(v) ){
 //				TRACE("Current stack item: N" << u << "(L" << g->getLevel(u) << ")-[fwE" << e << "]->N" << v << "(L" << g->getLevel(v) << ")" );
-				midnod = g->getFwEdge(e).getMiddleNode();
+				midnod = g->getFwMiddleNode(e);
 			}
 			else{
 //				TRACE("Current stack item: N" << u << "(L" << g->getLevel(u) << ")-[bwE" << e << "]->N" << v << "(L" << g->getLevel(v) << ")" );
-				midnod = g->getBwEdge(e).getMiddleNode();
+				midnod = g->getBwMiddleNode(e);
 			}
 			if ( midnod == INVALID_NODE_ID ){
 //				TRACE("Original edge => end of the search for this path section");
@@ -165,14 +166,14 @@ void Path::develop(const Graph* g){
 			Edge_id incomingedge = INVALID_EDGE_ID, outcomingedge = INVALID_EDGE_ID;
 			for(Edge_id edgein = g->getNodeBeginBW(midnod) ; edgein < g->getNodeEndBW(midnod) ; ++edgein ){
 //				TRACE("INCOMING EDGE E" << edgein << ": N" << g->getBwEdge(edgein).getOrigin() << "->N" << g->getBwEdge(edgein).getDestination() );
-				if( g->getBwEdge(edgein).getOrigin() == u){
+				if( g->getBwOrigin(edgein) == u){
 					incomingedge = edgein;
 					break;
 				}
 			}
 			for(Edge_id edgeout = g->getNodeBeginFW(midnod) ; edgeout < g->getNodeEndFW(midnod) ; ++edgeout ){
 //				TRACE("OUTCOMING EDGE E" << edgeout << ": N" << g->getFwEdge(edgeout).getOrigin() << "->N" << g->getFwEdge(edgeout).getDestination() );
-				if( g->getFwEdge(edgeout).getDestination() == v){
+				if( g->getFwDestination(edgeout) == v){
 					outcomingedge = edgeout;
 					break;
 				}
@@ -193,6 +194,56 @@ void Path::develop(const Graph* g){
 //	TRACE("New path: " << *this);
 }
 
+/*
+ * develop(const UpwardGraph* g) method: develop shortcut contained into the current path, edge ids being the ones of the upward graph
+ * a shortcut u->v with middle node x is made of the edge u->x (upward backward edge of x) and the edge x->v (upward forward edge of x)
+ */
+void Path::develop(const UpwardGraph* g){
+	assert( _nodes.size() == _edges.size()+1);
+	// The method does nothing if the path contains only one node
+	if( _nodes.size() == 1 ){
+		return;
+	}
+	std::deque<Node_id> newNodeSeq;
+	newNodeSeq.push_back( getFirstNode() );
+	std::deque<Edge_id> newEdgeSeq;
+	std::deque<Node_id>::iterator itprevnode = _nodes.begin();
+	std::deque<Node_id>::iterator itnode = itprevnode+1;
+	std::deque<Edge_id>::iterator itedge = _edges.begin();
+	while( itnode != _nodes.end() ){
+		std::stack< std::tuple<Node_id,Edge_id,Node_id> > lifostack;
+		lifostack.push( std::tuple<Node_id,Edge_id,Node_id>(*itprevnode , *itedge , *itnode) );
+		while( !lifostack.empty() ){
+			Node_id u = std::get<0>( lifostack.top() );
+			Edge_id e = std::get<1>( lifostack.top() );
+			Node_id v = std::get<2>( lifostack.top() );
+			lifostack.pop();
+			Node_id midnod( g->getLevel(u) < g->getLevel(v) ? g->getFwMiddleNode(e) : g->getBwMiddleNode(e) );
+			if ( midnod == INVALID_NODE_ID ){
+				newEdgeSeq.push_back(e);
+				newNodeSeq.push_back(v);
+				continue;
+			}
+			lifostack.push( std::make_tuple(midnod, g->identifyFwEdge(midnod, v), v) );
+			lifostack.push( std::make_tuple(u, g->identifyBwEdge(u, midnod), midnod) );
+		}
+		++itprevnode;
+		++itnode;
+		++itedge;
+	}
+	_nodes = newNodeSeq;
+	_edges = newEdgeSeq;
+}
+
+/*
+ * toOriginalIds(const NodePermutation&) method: translate the path nodes into original node ids
+ */
+void Path::toOriginalIds(const NodePermutation& permutation){
+	for(Node_id& n: _nodes){
+		n = permutation.toOriginal(n);
+	}
+}
+
 /*
  * << operator: return an outstream version of the path (printing purpose)
  */
@@ -226,3 +277,10 @@ bool operator<(const Path& lhs, const Path& rhs){
 	// There is not any index such that node_id(left) > node_id(right) or node_id(left) < node_id(right), left-term is smaller only if its size is smaller than right-term size
 	return leftNodes.size() < rightNodes.size();
 }
+
+/*
+ * getMemorySize() method: return the memory allocated for the node and edge sequences and the path distribution, in bytes
+ */
+size_t Path::getMemorySize() const {
+	return MemoryFootprint::bytes(_nodes) + MemoryFootprint::bytes(_edges) + _dist.getMemorySize();
+}
@@ -13,6 +13,7 @@
 #include "../../misc.h"
 #include "../graph/distribution.h"
 #include "../graph/graph.h"
+#include "../graph/upwardgraph.h"
 
 class Path{
 public:
@@ -77,6 +78,16 @@ public:
 	 */
 	void develop(const Graph* g);
 
+	/*
+	 * develop(const UpwardGraph* g) method: develop shortcut contained into the current path, edge ids being the ones of the upward graph
+	 */
+	void develop(const UpwardGraph* g);
+
+	/*
+	 * toOriginalIds(const NodePermutation&) method: translate the path nodes into original node ids
+	 */
+	void toOriginalIds(const NodePermutation& permutation);
+
 	/*
 	 * << operator: return an outstream version of the path (printing purpose)
 	 */
@@ -88,6 +99,11 @@ public:
 	 */
 	friend bool operator<(const Path& lhs, const Path& rhs);
 
+	/*
+	 * getMemorySize() method: return the memory allocated for the node and edge sequences and the path distribution, in bytes
+	 */
+	size_t getMemorySize() const;
+
 private:
 	/*
 	 * Attributes
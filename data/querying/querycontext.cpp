@@ -11,13 +11,14 @@
 /*
  * Constructor
  */
-QueryContext::QueryContext(): _specif(), _heap(), _searchNodes(){}
-QueryContext::QueryContext(const Specif& spec): _specif(spec), _heap(), _searchNodes(){}
+QueryContext::QueryContext(): _specif(), _heap(), _searchNodes(), _arena(){}
+QueryContext::QueryContext(const Specif& spec): _specif(spec), _heap(), _searchNodes(), _arena(spec.getNbPts()+1){}
 
 /*
  * Getters
  */
 uint32_t QueryContext::getNbPts(){ return _specif.getNbPts(); }
+DistributionArena& QueryContext::getArena(){ return _arena; }
 double QueryContext::getDelta(){ return _specif.getDelta(); }
 boost::heap::pairing_heap<HeapElement> QueryContext::getHeap(){ return _heap;	}
 std::map<Node_id,QuerySearchNode> QueryContext::getSearchNodes(){ return _searchNodes;	}
@@ -87,6 +88,7 @@ const double QueryContext::getMinPriority() const{
  * init(const NodeIterator&, const double&) method: insert a first element (node_iterator:priority) in the heap structure
  */
 QuerySearchNode& QueryContext::init(const Node_id& nodeId, const double& priority ){
+	DistributionArena::Scope heapScope; // Node labels live until the end of the query: their buffers are heap ones, sized to their window
 	assert( _heap.empty() );
 	//	const Node_id newnodeid( _searchNodes.rbegin()->first + 1 );
 	// Add the node in the priority queue
@@ -101,7 +103,8 @@ QuerySearchNode& QueryContext::init(const Node_id& nodeId, const double& priorit
 /*
  * insert(const NodeIterator&, const double&) method: insert a new element (node_iterator:priority) in the heap structure
  */
-QuerySearchNode& QueryContext::insert(const Node_id& nodeId, const double& priority , RoutingPolicy& rp , Edge_id& e , Distribution& dist ){
+QuerySearchNode& QueryContext::insert(const Node_id& nodeId, const double& priority , RoutingPolicy& rp , Edge_id& e , const Distribution& dist ){
+	DistributionArena::Scope heapScope; // See init()
 	//	const Node_id newnodeid( _searchNodes.rbegin()->first + 1 );
 	// Add the node in the priority queue
 	const boost::heap::pairing_heap<HeapElement>::handle_type heap_handle = _heap.push( HeapElement(nodeId, priority) );
@@ -134,7 +137,8 @@ void QueryContext::decrease(const Node_id& nodeid, const double& priority){
 /*
  * managePolicy(RoutingPolicy& , Edge_id& , Distribution&, const bool&) method: update an element of the heap if it exists, add it otherwise
  */
-bool QueryContext::managePolicy(const Node_id& nodeid, const double& candidateValue, RoutingPolicy& rp , Edge_id& e , Distribution& dist_uv ){
+bool QueryContext::managePolicy(const Node_id& nodeid, const double& candidateValue, RoutingPolicy& rp , Edge_id& e , const Distribution& dist_uv ){
+	DistributionArena::Scope heapScope; // See init()
 //	TRACE("Policy management: link node N" << nodeid << " with following policy: " << rp);
 	QuerySearchNode& node = getSearchNode( nodeid );
 	// If minimum possible value after edge u->v relaxation is larger than maximum value of node v distribution, the current candidate edge is skipped (deterministic dominance)
@@ -199,6 +203,7 @@ void QueryContext::clearPQ(){
  * clearAll() method: clear all attributes of the current search context
  */
 void QueryContext::clearAll(){
+	DistributionArena::Scope heapScope; // Node labels have heap buffers (see init()), they are not kept by the arena
 	_heap.clear();
 	_searchNodes.clear();
 }
@@ -221,4 +226,18 @@ std::ostream& operator<<(std::ostream& os, const QueryContext& qc){
 	return os;
 }
 
-
+/*
+ * memoryFootprint() method: return the memory held by the search direction: node labels (routing policies), queue and distribution arena
+ * (pairing heap nodes are counted as their element plus four links)
+ */
+MemoryFootprint QueryContext::memoryFootprint() const {
+	MemoryFootprint footprint("QueryContext");
+	size_t labelBytes( MemoryFootprint::bytes(_searchNodes) );
+	for(const auto& node: _searchNodes){
+		labelBytes += node.second.getMemorySize();
+	}
+	footprint.add("labels", labelBytes);
+	footprint.add("queue", _heap.size() * ( sizeof(HeapElement) + 4 * sizeof(void*) ));
+	footprint.add("arena", _arena.getMemorySize());
+	return footprint;
+}
@@ -14,6 +14,7 @@
 
 #include "../witnesssearch/heapitem.h"
 #include "../graph/distribution.h"
+#include "../graph/memoryfootprint.h"
 #include "querysearchnode.h"
 #include "routingpolicy.h"
 
@@ -32,6 +33,7 @@ public:
 	double getDelta();
 	boost::heap::pairing_heap<HeapElement> getHeap();
 	std::map<Node_id,QuerySearchNode> getSearchNodes();
+	DistributionArena& getArena();
 
 	/*
 	 * empty() method: return true if heap is empty, false otherwise
@@ -87,7 +89,7 @@ public:
 	 * insert(const NodeIterator&, const double&) method: insert a new element (node_iterator:priority) in the heap structure
 	 * Build its routing policy starting from its predecessor routing policy
 	 */
-	QuerySearchNode& insert(const Node_id& node_iterator, const double& priority , RoutingPolicy& rp , Edge_id& e , Distribution& dist );
+	QuerySearchNode& insert(const Node_id& node_iterator, const double& priority , RoutingPolicy& rp , Edge_id& e , const Distribution& dist );
 
 	/*
 	 * insertAgain(SearchNode&, const double&) method: re-insert an element in the heap that was already inserted and deleted before
@@ -107,7 +109,7 @@ public:
 	/*
 	 * managePolicy(RoutingPolicy& , Edge_id& , Distribution&, const bool&) method: update an element of the heap if it exists, add it otherwise
 	 */
-	bool managePolicy(const Node_id& nodeid, const double& candidate, RoutingPolicy& rp , Edge_id& e , Distribution& dist_uv );
+	bool managePolicy(const Node_id& nodeid, const double& candidate, RoutingPolicy& rp , Edge_id& e , const Distribution& dist_uv );
 
 	/*
 	 * update(SearchNode&, const double&) method: update an element of the heap if it exists, add it otherwise
@@ -134,6 +136,11 @@ public:
      */
     friend std::ostream& operator<<(std::ostream& os, const QueryContext& sc);
 
+	/*
+	 * memoryFootprint() method: return the memory held by the search direction: node labels (routing policies), queue and distribution arena
+	 */
+	MemoryFootprint memoryFootprint() const;
+
 private:
 	/*
 	 * Attributes
@@ -141,6 +148,7 @@ private:
 	Specif _specif; // Instance specification
 	boost::heap::pairing_heap<HeapElement> _heap; // Priority queue (composed of a set of elements organized as a heap)
 	std::map<Node_id,QuerySearchNode> _searchNodes; // Nodes to consider during the search
+	DistributionArena _arena; // Probability buffers of the temporary distributions of this search direction (node labels are heap ones, see init())
 };
 
 
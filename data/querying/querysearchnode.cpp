@@ -63,3 +63,10 @@ std::ostream& operator<<(std::ostream& os, QuerySearchNode& sn){
 	os << "Node N" << sn._nodeId << (sn._isEnqueued?" (Q) ":" (NQ) ") << sn._policy;
 	return os;
 }
+
+/*
+ * getMemorySize() method: return the memory allocated for the routing policy of the node (its label), in bytes
+ */
+size_t QuerySearchNode::getMemorySize() const {
+	return _policy.getMemorySize();
+}
@@ -78,6 +78,11 @@ public:
 	 */
     friend std::ostream& operator<<(std::ostream& os, QuerySearchNode& sn);
 
+	/*
+	 * getMemorySize() method: return the memory allocated for the routing policy of the node (its label), in bytes
+	 */
+	size_t getMemorySize() const;
+
 private:
 	/*
 	 * Attributes
@@ -6,6 +6,7 @@
  */
 
 #include "routingpolicy.h"
+#include "../graph/memoryfootprint.h"
 
 /*
  * Constructors
@@ -444,6 +445,25 @@ void RoutingPolicy::developPaths(const Graph* g){
 	}
 }
 
+/*
+ * developPaths(const UpwardGraph*) method: develop each local-reliable paths of the current routing policy, edge ids being the ones of the upward graph
+ */
+void RoutingPolicy::developPaths(const UpwardGraph* g){
+	for(auto& path: _paths){
+		path.second.develop( g );
+	}
+}
+
+/*
+ * toOriginalIds(const NodePermutation&) method: translate the routing policy node and the path nodes into original node ids
+ */
+void RoutingPolicy::toOriginalIds(const NodePermutation& permutation){
+	_node = permutation.toOriginal(_node);
+	for(auto& path: _paths){
+		path.second.toOriginalIds( permutation );
+	}
+}
+
 /*
  * serialize(std::string& , std::string&) method: save the routing policy in two text files (one for routing policy distribution and one for path descriptions)
  * format routing policy: [time budget t] <frontier.cdf[t]> <bestpathid[t]> <path1.cdf[t]> <path2.cdf[t]> ...
@@ -511,3 +531,14 @@ std::ostream& operator<<(std::ostream& os, const RoutingPolicy& rp){
 	os << "\n";
 	return os;
 }
+
+/*
+ * getMemorySize() method: return the memory allocated for the frontier and the paths of the policy, in bytes
+ */
+size_t RoutingPolicy::getMemorySize() const {
+	size_t bytes( _frontier.getMemorySize() + MemoryFootprint::bytes(_paths) + MemoryFootprint::bytes(_bestpaths) );
+	for(const auto& path: _paths){
+		bytes += path.second.getMemorySize();
+	}
+	return bytes;
+}
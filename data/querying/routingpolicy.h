@@ -107,6 +107,16 @@ public:
 	 */
 	void developPaths(const Graph* g);
 
+	/*
+	 * developPaths(const UpwardGraph*) method: develop each local-reliable paths of the current routing policy, edge ids being the ones of the upward graph
+	 */
+	void developPaths(const UpwardGraph* g);
+
+	/*
+	 * toOriginalIds(const NodePermutation&) method: translate the routing policy node and the path nodes into original node ids
+	 */
+	void toOriginalIds(const NodePermutation& permutation);
+
 	/*
 	 * serialize(std::string& , std::string&) method: save the routing policy in two text files (one for routing policy distribution and one for path descriptions)
 	 * format routing policy: [time budget t] <frontier.cdf[t]> <bestpathid[t]> <path1.cdf[t]> <path2.cdf[t]> ...
@@ -120,6 +130,11 @@ public:
 	 */
 	friend std::ostream& operator<<(std::ostream& os, const RoutingPolicy& dist);
 
+	/*
+	 * getMemorySize() method: return the memory allocated for the frontier and the paths of the policy, in bytes
+	 */
+	size_t getMemorySize() const;
+
 private:
 	/*
 	 * Attributes
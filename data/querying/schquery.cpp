@@ -10,7 +10,7 @@
 /*
  * Constructors
  */
-SCHQuery::SCHQuery(Graph* graph): _graph(graph), _start(INVALID_NODE_ID), _destination(INVALID_NODE_ID), _forwardDirection( false ), _targettedProb(std::numeric_limits<double>::max()),
+SCHQuery::SCHQuery(const UpwardGraph* graph): _graph(graph), _start(INVALID_NODE_ID), _destination(INVALID_NODE_ID), _forwardDirection( false ), _targettedProb(std::numeric_limits<double>::max()),
 _timeBudget(std::numeric_limits<double>::max()), _uppB(std::numeric_limits<double>::max()){
 	_priorityQueues[0] = QueryContext(_graph->getSpecif()); // Initialize backward priority queue
 	_priorityQueues[1] = QueryContext(_graph->getSpecif()); // Initialize forward priority queue
@@ -31,15 +31,16 @@ bool SCHQuery::flip(){
 
 /*
  * oneToOne() method: compute the shortest path between given origin and destination nodes
- * Work into the ordered graph
+ * Work into the ordered graph, origin and destination being given with their original ids (as the returned routing policy)
  */
 RoutingPolicy SCHQuery::oneToOne(const Node_id& start, const Node_id& destination){
 	//	STATUS("Shortest path query between N" << start << " and N" << destination << "...\n");
 	_timeBudget = std::numeric_limits<double>::max();
-	_start = start;
-	_destination = destination;
+	// Origin and destination are given with their original ids, the search works with internal ones
+	_start = _graph->getPermutation().toInternal(start);
+	_destination = _graph->getPermutation().toInternal(destination);
 	if ( start == destination ){
-		return RoutingPolicy(_destination,_graph->getSpecif().getNbPts(),_graph->getSpecif().getDelta());
+		return RoutingPolicy(destination,_graph->getSpecif().getNbPts(),_graph->getSpecif().getDelta());
 	}
 	_candidates.clear();
 	_priorityQueues[_forwardDirection].clearAll();
@@ -53,6 +54,7 @@ RoutingPolicy SCHQuery::oneToOne(const Node_id& start, const Node_id& destinatio
 //	STATUS("End of solution building" << "\n");
 	// Develop paths to retrieve all physical nodes that are visited by optimal routing policy
 	destinationPolicy.developPaths( _graph );
+	destinationPolicy.toOriginalIds( _graph->getPermutation() );
 //	STATUS("All paths are developed - solution ready" << "\n");
 //	MARK("Routing policy toward node N" << _destination << " is the following:\n" << destinationPolicy);
 	return destinationPolicy;
@@ -81,6 +83,8 @@ void SCHQuery::bidirectionalProfileSearch(){
 			//			TRACE("Change search direction!");
 			flip();
 		}
+		// Distributions built while relaxing the node use the buffers of the current search direction
+		DistributionArena::Scope arenaScope( _priorityQueues[_forwardDirection].getArena() );
 		QuerySearchNode& u = _priorityQueues[_forwardDirection].deleteMin();
 		const Node_id u_id = u.getNodeId();
 //		TRACE( "[" << (_forwardDirection?"FORWARD":"BACKWARD") << " search] Current node: Node N" << u_id);
@@ -110,19 +114,12 @@ void SCHQuery::bidirectionalProfileSearch(){
 			continue;
 		}
 		//		TRACE("Upper bound of the search: " << _uppB);
-		// Relax each incident edge: outcoming forward edges for forward search, incoming backward edges for backward search
+		// Relax each incident edge: outcoming forward edges for forward search, incoming backward edges for backward search (upward edges only)
 		if( _forwardDirection ){
 			for ( Edge_id e = _graph->getNodeBeginFW(u_id) ; e != _graph->getNodeEndFW(u_id) ; ++e ){
-				Edge curEdge( _graph->getFwEdge(e) );
-				const Node_id v_id = curEdge.getDestination();
-				// If node v has a lower level, ignore it (upward search)
-//				TRACE("Node N" << u_id << " has level L" << _graph->getLevel(u_id) << " --> Node N" << v_id << " has level L" << _graph->getLevel(v_id) << (_graph->getLevel(v_id) < _graph->getLevel(u_id)?" --> CANCEL EVALUATION":"") );
-				if( _graph->getLevel(v_id) < _graph->getLevel(u_id) ){
-					continue;
-				}
-//				TRACE("Current edge: " << curEdge);
+				const Node_id v_id = _graph->getFwDestination(e);
 				// Set the current loop information: edge u->v distribution and node v
-				Distribution dist_uv( curEdge.getWeight() );
+				WeightView dist_uv( _graph->getFwWeight(e) );
 				double candidateValue( u.getDistMin()+dist_uv.min() );
 				RoutingPolicy predPolicy = u.getPolicy();
 				// If there is not any policy for node v
@@ -141,16 +138,9 @@ void SCHQuery::bidirectionalProfileSearch(){
 		} /* End if predicate */
 		else{
 			for ( Edge_id e = _graph->getNodeBeginBW(u_id) ; e != _graph->getNodeEndBW(u_id) ; ++e ){
-				Edge curEdge( _graph->getBwEdge(e) );
-				const Node_id v_id = curEdge.getOrigin();
-				// If node v has a lower level, ignore it (upward search)
-//				TRACE("Node N" << u_id << " has level L" << _graph->getLevel(u_id) << " --> Node N" << v_id << " has level L" << _graph->getLevel(v_id) << (_graph->getLevel(v_id) < _graph->getLevel(u_id)?" --> CANCEL EVALUATION":"") );
-				if( _graph->getLevel(v_id) < _graph->getLevel(u_id) ){
-					continue;
-				}
-//				TRACE("Current edge: " << curEdge);
+				const Node_id v_id = _graph->getBwOrigin(e);
 				// Set the current loop information: edge u->v distribution and node v
-				Distribution dist_uv( curEdge.getWeight() );
+				WeightView dist_uv( _graph->getBwWeight(e) );
 				double candidateValue( u.getDistMin()+dist_uv.min() );
 				RoutingPolicy predPolicy = u.getPolicy();
 				// If there is not any policy for node v
@@ -219,3 +209,14 @@ RoutingPolicy SCHQuery::buildSolution(std::set<Node_id> meetingNodes){
 std::ostream& operator<<(std::ostream& os, SCHQuery& schq){
 	return os;
 }
+
+/*
+ * memoryFootprint() method: return the memory held by the query: labels, queues and arenas of both search directions (summed), and meeting node candidates
+ */
+MemoryFootprint SCHQuery::memoryFootprint() const {
+	MemoryFootprint footprint("SCHQuery");
+	footprint.add( _priorityQueues[0].memoryFootprint() );
+	footprint.add( _priorityQueues[1].memoryFootprint() );
+	footprint.add("candidates", MemoryFootprint::bytes(_candidates));
+	return footprint;
+}
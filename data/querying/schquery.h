@@ -15,16 +15,20 @@
 #include <set>
 
 #include "../../misc.h"
-#include "../graph/graph.h"
+#include "../graph/upwardgraph.h"
 #include "querycontext.h"
 #include "routingpolicy.h"
 
+/*
+ * Class SCHQuery: bidirectional profile search into a contracted graph, given as an UpwardGraph (only upward edges, CSR storage)
+ * Edge ids stored into the routing policies are the upward graph ones.
+ */
 class SCHQuery{
 public:
 	/*
 	 * Constructors
 	 */
-	SCHQuery(Graph* graph);
+	SCHQuery(const UpwardGraph* graph);
 
 	/*
 	 * Getters
@@ -38,7 +42,7 @@ public:
 
 	/*
 	 * oneToOne() method: compute the shortest path between given origin and destination nodes
-	 * Work into the ordered graph
+	 * Work into the ordered graph, origin and destination being given with their original ids (as the returned routing policy)
 	 */
 	RoutingPolicy oneToOne(const Node_id& start, const Node_id& destination);
 
@@ -71,11 +75,16 @@ public:
 	 */
 	friend std::ostream& operator<<(std::ostream& os, SCHQuery& schq);
 
+	/*
+	 * memoryFootprint() method: return the memory held by the query: labels, queues and arenas of both search directions, and meeting node candidates
+	 */
+	MemoryFootprint memoryFootprint() const;
+
 private:
 	/*
 	 * Attributes
 	 */
-	Graph* _graph;
+	const UpwardGraph* _graph;
     Node_id _start;
     Node_id _destination;
     bool _forwardDirection;
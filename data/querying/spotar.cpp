@@ -60,13 +60,13 @@ std::map<Node_id,SpotarPolicy> Spotar::run(){
 		Distribution curpathdist = curPath.getDistribution();
 		for ( Edge_id e = _graph->getNodeBeginBW(j) ; e != _graph->getNodeEndBW(j) ; ++e ){
 //			TRACE("BW Edge E" << e << " relaxation: " << _graph->getBwEdge(e) );
-			Node_id i( _graph->getBwEdge(e).getOrigin() );
+			Node_id i( _graph->getBwOrigin(e) );
 			// If node i is still on current path, do not evaluate the node, just continue the process
 			if( cyclecheck(curPath,i) ){
 				continue;
 			}
 			// Here we know that node i is a new node, build subsequent candidate path
-			Distribution edgeDist = _graph->getBwEdge(e).getWeight();
+			WeightView edgeDist = _graph->getBwWeight(e);
 			SpotarPath candidatePath = curPath.appendBW( i , e , edgeDist );
 			// If i has not been reached yet, initialize the corresponding policy
 			if( _policies.find( i ) == _policies.end() ){
@@ -6,6 +6,7 @@
  */
 
 #include "searchcontext.h"
+#include "../graph/memoryfootprint.h"
 #include <vector>
 
 /*
@@ -199,3 +200,15 @@ std::ostream& operator<<(std::ostream& os, const SearchContext& sc){
 }
 
 
+
+/*
+ * getMemorySize() method: return the memory allocated for the queue, the hash table and the search nodes, in bytes
+ * (pairing heap nodes are counted as their element plus four links)
+ */
+size_t SearchContext::getMemorySize() const {
+	size_t bytes( _heap.size() * ( sizeof(HeapElement) + 4 * sizeof(void*) ) + MemoryFootprint::bytes(_hash_table) + MemoryFootprint::bytes(_searchNodes) );
+	for(const auto& node: _searchNodes){
+		bytes += node.getMemorySize();
+	}
+	return bytes;
+}
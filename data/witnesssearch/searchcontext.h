@@ -121,6 +121,12 @@ public:
      */
     friend std::ostream& operator<<(std::ostream& os, const SearchContext& sc);
 
+	/*
+	 * getMemorySize() method: return the memory allocated for the queue, the hash table and the search nodes, in bytes
+	 * (pairing heap nodes are counted as their element plus four links)
+	 */
+	size_t getMemorySize() const;
+
 private:
 	/*
 	 * Attributes
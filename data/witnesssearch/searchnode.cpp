@@ -6,6 +6,7 @@
  */
 
 #include "searchnode.h"
+#include "../graph/memoryfootprint.h"
 
 /*
  * Constructors
@@ -102,3 +103,10 @@ std::ostream& operator<<(std::ostream& os, SearchNode& sn){
 	return os;
 }
 
+
+/*
+ * getMemorySize() method: return the memory allocated for the node distribution and its predecessors, in bytes
+ */
+size_t SearchNode::getMemorySize() const {
+	return _dist.getMemorySize() + MemoryFootprint::bytes(_predecessors);
+}
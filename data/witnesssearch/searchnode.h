@@ -95,6 +95,11 @@ public:
 	 */
     friend std::ostream& operator<<(std::ostream& os, SearchNode& sn);
 
+	/*
+	 * getMemorySize() method: return the memory allocated for the node distribution and its predecessors, in bytes
+	 */
+	size_t getMemorySize() const;
+
 private:
 	/*
 	 * Attributes
@@ -25,7 +25,7 @@ WitnessSearch::WitnessSearch(Graph* graph): _graph(graph), _pq( graph->getSpecif
  * phase 3: profile search on the resulting graph to determine if a shortcut is necessary
  * OUTPUT: integer index describing the shortcut needs (undecided: 0, necessary: 1, not necessary: 2)
  */
-uint8_t WitnessSearch::run(const Node_id& u_it, const Node_id& x_it, const Node_id& v_it, Distribution& dist_uxv){
+uint8_t WitnessSearch::run(const Node_id& u_it, const Node_id& x_it, const Node_id& v_it, const Distribution& dist_uxv){
 //	TRACE("Witness search between nodes " << u_it << " and " << v_it << " (deleted path " << u_it << "->" << x_it << "->" << v_it << " distribution: " << dist_uxv << ")");
 	_pq.clearAll();
 	/*
@@ -135,17 +135,15 @@ void WitnessSearch::backwardIntervalSearch(const Node_id destination, const Node
 		const Node_id u_id = _pq.getNodeId(u);
 		// For each edge of the backward graph (ie for each incoming edge to this node), relax
 		for ( Edge_id e = _graph->getNodeBeginBW(u_it) ; e != _graph->getNodeEndBW(u_it) ; ++e ){
-			// Recover the edge structure
-			Edge curEdge( _graph->getBwEdges()[e] );
-			// Recover the origin node and the distribution corresponding to the current edge
-			const Node_id v_it = curEdge.getOrigin();
+			// Recover the origin node and the distribution corresponding to the current edge (topology arrays only)
+			const Node_id v_it = _graph->getBwOrigin(e);
 			if(v_it == deletedNode ){
 				continue;
 			}
 			if( v_it == u.getPredId() ){
 				continue;
 			}
-			Distribution dist_vu(curEdge.getWeight());
+			WeightView dist_vu(_graph->getBwWeight(e));
 			const double min_e = dist_vu.min();
 			const double max_e = dist_vu.max();
 			// Compute the candidate interval
@@ -231,10 +229,9 @@ void WitnessSearch::expectedTimeSearch(const Node_id& start, const Node_id& dest
 			if ( e == INVALID_EDGE_ID ){
 				continue;
 			}
-			Edge curEdge( _graph->getBwEdges()[e] );
 			// Set the node v as the next candidate node (edge u->v will be relaxed during the search)
 			SearchNode& v = _pq.getSearchNodeFromId(pred._search_node_id);
-			Distribution dist_uv = curEdge.getWeight();
+			WeightView dist_uv = _graph->getBwWeight(e);
 			// Compute the candidate label let_v_new
 			const double let_u = u.getExpectedTime();
 			const double let_v_new = dist_uv.esp() + let_u;
@@ -302,13 +299,12 @@ void WitnessSearch::profileSearch(const Node_id& start, const Node_id& destinati
 			if ( e == INVALID_EDGE_ID ){
 				continue;
 			}
-			Edge curEdge( _graph->getBwEdges()[e] );
 			// Set the node v as the next candidate node (edge u->v will be relaxed during the search)
 			SearchNode& v = _pq.getSearchNodeFromId( pred._search_node_id );
 //			if(start == 10 && destination == 22){
 //				CONTINUE_STATUS("->N" << v.getNodeId() << "\t");
 //			}
-			Distribution dist_uv = curEdge.getWeight();
+			WeightView dist_uv = _graph->getBwWeight(e);
 			// If the distribution is valid (values are distributed on the interval [0,Tmax], and not only equal to Tmax) -- ie if node v distribution as still be updated
 			if ( ! v.infiniteDistrib() ){
 				// If minimum possible value after edge u->v relaxation is larger than maximum value of node v distribution, the current candidate edge is skipped
@@ -321,7 +317,16 @@ void WitnessSearch::profileSearch(const Node_id& start, const Node_id& destinati
 				}
 			}
 			// If distributions are overlapping, convolution process can not be avoided
-			Distribution dist_v_new = u.getDistribution().convolute( dist_uv );
+			// Beyond the maximum possible value at v, or at destination (no witness path can go through v later), the cdf to keep is 1 anyway: the convolution is bounded there
+			uint32_t horizon( std::numeric_limits<uint32_t>::max() );
+			if ( ! v.infiniteDistrib() ){
+				horizon = uint32_t( v.getDistMax() / _pq.getDelta() );
+			}
+			if ( ! d.infiniteDistrib() ){
+				horizon = std::min( horizon , uint32_t( d.getDistMax() / _pq.getDelta() ) );
+			}
+			bool truncated(false);
+			Distribution dist_v_new = u.getDistribution().convolute( dist_uv, horizon, truncated );
 			// If v has never been visited, the convoluted distribution becomes its own distribution
 			if ( v.infiniteDistrib() ){
 				_pq.insertAgain(v, dist_v_new.min() + v.getInterval().getLB());
@@ -355,3 +360,10 @@ void WitnessSearch::profileSearch(const Node_id& start, const Node_id& destinati
 //		}
 	} // End of procedure
 }
+
+/*
+ * getMemorySize() method: return the memory allocated for the search context, in bytes
+ */
+size_t WitnessSearch::getMemorySize() const {
+	return _pq.getMemorySize();
+}
@@ -36,7 +36,12 @@ public:
 	 * phase 3: profile search on the resulting graph to determine if a shortcut is necessary
 	 * OUTPUT: integer index describing the shortcut needs (undecided: 0, necessary: 1, not necessary: 2)
 	 */
-	uint8_t run(const Node_id& u_it, const Node_id& x_it, const Node_id& v_it, Distribution& dist_uxv);
+	uint8_t run(const Node_id& u_it, const Node_id& x_it, const Node_id& v_it, const Distribution& dist_uxv);
+
+	/*
+	 * getMemorySize() method: return the memory allocated for the search context, in bytes
+	 */
+	size_t getMemorySize() const;
 
 protected:
 	/*
@@ -0,0 +1,246 @@
+/*
+ * binarygraph_io.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_IO_BINARYGRAPH_IO_H_
+#define DATA_IO_BINARYGRAPH_IO_H_
+
+#include <algorithm> // Command max
+#include <cstdint>
+#include <cstring> // Command memcpy
+#include <fstream>
+#include <numeric> // Command partial_sum
+#include <string>
+#include <vector>
+#include <fcntl.h> // Command open
+#include <sys/mman.h> // Commands mmap, madvise, munmap
+#include <sys/stat.h> // Commands stat, fstat
+#include <unistd.h> // Command close
+
+#include "../misc.h"
+#include "../data/graph/edge.h"
+#include "specifreader.h"
+
+/*
+ * class BinaryGraphIO: binary edge files, loaded without any parsing (alternative to the text edge files read by GraphReader)
+ * Layout (native endianness, sections aligned on 8 bytes):
+ *   - header: magic number, format version, number of nodes, number of edges, number of points, delta, hierarchized flag
+ *   - topology (CSR): first edge of each origin node (nbNodes+1 values), then the destination and the middle node of each edge
+ *   - probabilities: the nbPts+1 probabilities of each edge, in the order of the topology
+ * The edges of an origin node keep the order of the text file. The file is mapped in memory (mmap) and the edges are built in one pass
+ * over the mapped sections, that checks the probabilities with the same tests as GraphReader.
+ * The binary version of an edge file <name>.txt is <name>.bin (see binaryFileName()), GraphReader reads it instead of the text file
+ * when it is up to date.
+ */
+class BinaryGraphIO{
+public:
+	/*
+	 * Struct Header: first bytes of a binary edge file
+	 */
+	struct Header{
+		uint64_t magic; // MAGIC
+		uint32_t version; // VERSION
+		uint32_t nbNodes; // Number of origin nodes of the topology
+		uint32_t nbEdges; // Number of edges
+		uint32_t nbPts; // Number of points of the distributions (nbPts+1 probabilities per edge)
+		uint32_t delta; // Difference between two consecutive support points
+		uint32_t hierarchized; // 1 if the edges have middle nodes (contracted graph files), 0 otherwise
+	};
+
+	/*
+	 * binaryFileName(const std::string&) method: return the name of the binary version of the given text edge file (.txt extension replaced by .bin)
+	 */
+	static std::string binaryFileName(const std::string& filename){
+		const std::string extension(".txt");
+		if( filename.size() >= extension.size() && filename.compare( filename.size() - extension.size() , extension.size() , extension ) == 0 ){
+			return filename.substr( 0 , filename.size() - extension.size() ) + ".bin";
+		}
+		return filename + ".bin";
+	}
+
+	/*
+	 * isBinary(const std::string&) method: return true if the given file is a binary edge file of the current format version
+	 */
+	static bool isBinary(const std::string& filename){
+		std::ifstream input(filename, std::ios::binary);
+		Header header;
+		input.read( reinterpret_cast<char*>(&header) , sizeof(Header) );
+		return input.gcount() == sizeof(Header) && header.magic == MAGIC && header.version == VERSION;
+	}
+
+	/*
+	 * isUpToDate(const std::string&, const std::string&) method: return true if the given binary edge file exists and is not older than the given text file
+	 */
+	static bool isUpToDate(const std::string& binaryname, const std::string& filename){
+		struct stat binaryStatus, textStatus;
+		if( stat( binaryname.c_str() , &binaryStatus ) != 0 || !isBinary(binaryname) ){
+			return false;
+		}
+		return stat( filename.c_str() , &textStatus ) != 0 || binaryStatus.st_mtime >= textStatus.st_mtime;
+	}
+
+	/*
+	 * write(const std::string&, const Specif&, const std::vector<Edge>&, const bool&) method: write the given edges (as read by GraphReader)
+	 * into a binary edge file
+	 * edges are sorted by origin (stable sort); with quantized weights (SCH_QUANTIZED_WEIGHTS), the stored probabilities are the quantized ones
+	 */
+	static void write(const std::string& filename, const Specif& specif, const std::vector<Edge>& edges, const bool& hierarchized){
+		Header header;
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.nbNodes = specif.getNbNodes();
+		header.nbEdges = edges.size();
+		header.nbPts = specif.getNbPts();
+		header.delta = specif.getDelta();
+		header.hierarchized = hierarchized;
+		for(const Edge& edge: edges){
+			header.nbNodes = std::max( header.nbNodes , edge.getOrigin() + 1 );
+		}
+		std::vector<uint32_t> first( header.nbNodes + 1 , 0 );
+		for(const Edge& edge: edges){
+			++first[ edge.getOrigin() + 1 ];
+		}
+		std::partial_sum( first.begin() , first.end() , first.begin() );
+		std::vector<uint32_t> order( edges.size() ); // Edge indices in the order of the topology
+		std::vector<uint32_t> next( first.begin() , first.end() - 1 );
+		for(uint32_t i(0) ; i < edges.size() ; ++i){
+			order[ next[ edges[i].getOrigin() ]++ ] = i;
+		}
+		std::vector<uint32_t> destinations( edges.size() ), middleNodes( edges.size() );
+		for(uint32_t e(0) ; e < edges.size() ; ++e){
+			destinations[e] = edges[ order[e] ].getDestination();
+			middleNodes[e] = edges[ order[e] ].getMiddleNode();
+		}
+		std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+		if( !output.is_open() ){
+			ERROR("Unable to open file '" << filename << "'\n");
+			return;
+		}
+		output.write( reinterpret_cast<const char*>(&header) , sizeof(Header) );
+		output.write( reinterpret_cast<const char*>(first.data()) , first.size() * sizeof(uint32_t) );
+		output.write( reinterpret_cast<const char*>(destinations.data()) , destinations.size() * sizeof(uint32_t) );
+		output.write( reinterpret_cast<const char*>(middleNodes.data()) , middleNodes.size() * sizeof(uint32_t) );
+		const std::vector<char> padding( probabilityOffset(header) - sizeof(Header) - ( first.size() + 2 * edges.size() ) * sizeof(uint32_t) , 0 );
+		output.write( padding.data() , padding.size() );
+		std::vector<double> pmf( header.nbPts + 1 );
+		for(const uint32_t& i: order){
+			WeightView dist( edges[i].getWeight() );
+			for(uint32_t t(0) ; t <= header.nbPts ; ++t){
+				pmf[t] = dist.getPdfT(t);
+			}
+			output.write( reinterpret_cast<const char*>(pmf.data()) , pmf.size() * sizeof(double) );
+		}
+		output.close();
+		if( !output ){
+			ERROR("Unable to write file '" << filename << "'\n");
+		}
+	}
+
+	/*
+	 * read(const std::string&, const Specif&, const bool&) method: return the edges stored in the given binary edge file, built directly
+	 * from the mapped file (the result is empty if the file does not match the specification or is corrupted)
+	 */
+	static std::vector<Edge> read(const std::string& filename, const Specif& specif, const bool& hierarchized){
+		std::vector<Edge> edges;
+		const int file( open( filename.c_str() , O_RDONLY ) );
+		struct stat status;
+		if( file < 0 || fstat( file , &status ) != 0 ){
+			ERROR("Unable to open file '" << filename << "'\n");
+			if( file >= 0 ){
+				close(file);
+			}
+			return edges;
+		}
+		const size_t size( status.st_size );
+		void* data( size >= sizeof(Header) ? mmap( NULL , size , PROT_READ , MAP_PRIVATE , file , 0 ) : MAP_FAILED );
+		close(file);
+		if( data == MAP_FAILED ){
+			ERROR("Unable to map binary edge file '" << filename << "'\n");
+			return edges;
+		}
+		madvise( data , size , MADV_SEQUENTIAL );
+		const char* bytes( static_cast<const char*>(data) );
+		Header header;
+		memcpy( &header , bytes , sizeof(Header) );
+		if( header.magic != MAGIC || header.version != VERSION ){
+			ERROR("Binary edge file corrupted: unknown format.\n");
+		}
+		else if( header.nbPts != specif.getNbPts() || header.delta != specif.getDelta() || bool(header.hierarchized) != hierarchized ){
+			ERROR("Binary edge file does not match the instance specification (" << header.nbPts << " points, delta " << header.delta << ").\n");
+		}
+		else if( size != fileSize(header) ){
+			ERROR("Binary edge file corrupted: " << size << " bytes instead of " << fileSize(header) << ".\n");
+		}
+		else{
+			const uint32_t* first( reinterpret_cast<const uint32_t*>( bytes + sizeof(Header) ) );
+			const uint32_t* destinations( first + header.nbNodes + 1 );
+			const uint32_t* middleNodes( destinations + header.nbEdges );
+			const double* probabilities( reinterpret_cast<const double*>( bytes + probabilityOffset(header) ) );
+			const uint32_t nbProbas( header.nbPts + 1 );
+			std::vector<uint32_t> t( nbProbas );
+			for(uint32_t i(0) ; i < nbProbas ; ++i){
+				t[i] = i * header.delta;
+			}
+			std::vector<double> pmf( nbProbas ), cdf( nbProbas );
+			edges.reserve( header.nbEdges );
+			bool valid( first[0] == 0 && first[header.nbNodes] == header.nbEdges );
+			for(Node_id src(0) ; valid && src < header.nbNodes ; ++src){
+				if( first[src] > first[src+1] ){
+					valid = false;
+					break;
+				}
+				for(Edge_id e(first[src]) ; e < first[src+1] ; ++e){
+					const double* proba( probabilities + size_t(e) * nbProbas );
+					for(uint32_t i(0) ; i < nbProbas ; ++i){
+						if( lt(proba[i],0.0) || gt(proba[i],1.0) ){
+							ERROR("Edge file corrupted: y-value not in [0;1].\n");
+							valid = false;
+							break;
+						}
+					}
+					pmf.assign( proba , proba + nbProbas );
+					std::partial_sum( pmf.begin() , pmf.end() , cdf.begin() );
+					if( valid && neq( cdf.back() , 1.0 ) ){
+						ERROR("Edge file corrupted: the total of probabilities is not equal to 1. (Fmax=" << cdf.back() << ")\n");
+						valid = false;
+					}
+					if( !valid ){
+						break;
+					}
+					Distribution dist( t , pmf , cdf );
+					edges.push_back( Edge( true , src , Node_id(destinations[e]) , dist , hierarchized ? Node_id(middleNodes[e]) : INVALID_NODE_ID ) );
+				}
+			}
+			if( !valid ){
+				ERROR("Binary edge file corrupted: invalid topology or probabilities.\n");
+				edges.clear();
+			}
+		}
+		munmap( data , size );
+		return edges;
+	}
+
+	static constexpr uint64_t MAGIC = 0x4850415247484353; // "SCHGRAPH" (little-endian)
+	static constexpr uint32_t VERSION = 1; // Format version, to be increased when the layout changes
+
+private:
+	/*
+	 * probabilityOffset(const Header&) method: return the position of the probability block in a file with the given header
+	 */
+	static size_t probabilityOffset(const Header& header){
+		const size_t offset( sizeof(Header) + ( size_t(header.nbNodes) + 1 + 2 * size_t(header.nbEdges) ) * sizeof(uint32_t) );
+		return ( offset + sizeof(double) - 1 ) / sizeof(double) * sizeof(double);
+	}
+
+	/*
+	 * fileSize(const Header&) method: return the size of a file with the given header, in bytes
+	 */
+	static size_t fileSize(const Header& header){
+		return probabilityOffset(header) + size_t(header.nbEdges) * ( header.nbPts + 1 ) * sizeof(double);
+	}
+};
+
+#endif /* DATA_IO_BINARYGRAPH_IO_H_ */
@@ -0,0 +1,284 @@
+/*
+ * checkpoint_io.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_IO_CHECKPOINT_IO_H_
+#define DATA_IO_CHECKPOINT_IO_H_
+
+#include <algorithm> // Command copy
+#include <cstdint>
+#include <cstdio> // Command rename
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../misc.h"
+#include "../data/graph/edge.h"
+
+/*
+ * class CheckpointIO: binary snapshot of the ordering process, taken at the end of a contraction round (see Ordering::setCheckpoint()) and
+ * read back to resume it (see Ordering::resume())
+ * A snapshot is filled in memory with the put...() methods by the snapshotted structures, then written; it is read with the get...() methods,
+ * in the same order. Layout (native endianness): a header, the weight table (size, delta, first stored support point and length of the
+ * stored window of each weight, then the pdf and cdf of the window), then the body (the put values, vectors being prefixed by their length).
+ * Weight ids are written as indexes in the weight table, and translated into ids of the weight dictionary of the reading process.
+ */
+class CheckpointIO{
+public:
+	/*
+	 * Struct Header: first bytes of a checkpoint file
+	 */
+	struct Header{
+		uint64_t magic; // MAGIC
+		uint32_t version; // VERSION
+		uint32_t nbNodes; // Number of nodes of the graph
+		uint64_t nbWeights; // Number of weights of the weight table
+		uint64_t bodySize; // Size of the body, in bytes
+	};
+
+	/*
+	 * Constructors: empty snapshot of a graph with the given number of nodes (to be filled), or snapshot read from the given file
+	 * (the weights of the file are interned in the weight dictionary; the object is not valid if the file cannot be read)
+	 */
+	CheckpointIO(const uint32_t& nbNodes): _nbNodes(nbNodes), _position(0), _valid(true){}
+	CheckpointIO(const std::string& filename): _nbNodes(0), _position(0), _valid(false){
+		std::ifstream input(filename, std::ios::binary);
+		Header header;
+		input.read( reinterpret_cast<char*>(&header) , sizeof(Header) );
+		if( !input.is_open() || input.gcount() != sizeof(Header) || header.magic != MAGIC || header.version != VERSION ){
+			ERROR("Unable to read checkpoint '" << filename << "' (missing file or other format version).\n");
+			return;
+		}
+		_nbNodes = header.nbNodes;
+		_weightIds.reserve( header.nbWeights );
+		for(uint64_t w(0) ; w < header.nbWeights && input ; ++w){
+			uint32_t window[4]; // Size, delta, first stored support point and length of the window
+			input.read( reinterpret_cast<char*>(window) , sizeof(window) );
+			std::vector<double> pdf( window[3] ), cdf( window[3] );
+			input.read( reinterpret_cast<char*>(pdf.data()) , pdf.size() * sizeof(double) );
+			input.read( reinterpret_cast<char*>(cdf.data()) , cdf.size() * sizeof(double) );
+			if( input && !pdf.empty() && window[2] + window[3] <= window[0] ){ // The window is restored as it was stored (not trimmed again)
+				_weightIds.push_back( getWeightDictionary().intern( Distribution( window[0] , window[1] , window[2] , pdf , cdf , false ) ) );
+			}
+		}
+		_body.resize( header.bodySize );
+		input.read( _body.data() , _body.size() );
+		_valid = input && _weightIds.size() == header.nbWeights;
+		if( !_valid ){
+			ERROR("Checkpoint '" << filename << "' corrupted.\n");
+		}
+	}
+
+	/*
+	 * Getters
+	 */
+	bool isValid() const { return _valid; }
+	uint32_t getNbNodes() const { return _nbNodes; }
+
+	/*
+	 * atEnd() method: return true if the whole body has been read
+	 */
+	bool atEnd() const { return _position == _body.size(); }
+
+	/*
+	 * put(...) methods: add a plain value (number or id), or a vector of them, to the snapshot
+	 */
+	template<typename T>
+	void put(const T& value){
+		const char* bytes( reinterpret_cast<const char*>(&value) );
+		_body.insert( _body.end() , bytes , bytes + sizeof(T) );
+	}
+	template<typename T>
+	void put(const std::vector<T>& values){
+		put( uint64_t(values.size()) );
+		const char* bytes( reinterpret_cast<const char*>(values.data()) );
+		_body.insert( _body.end() , bytes , bytes + values.size() * sizeof(T) );
+	}
+
+	/*
+	 * putWeights(const std::vector<Weight_id>&) method: add weight ids to the snapshot, their weights being added to the weight table
+	 */
+	void putWeights(const std::vector<Weight_id>& weights){
+		std::vector<uint32_t> indexes( weights.size() );
+		for(size_t i(0) ; i < weights.size() ; ++i){
+			indexes[i] = weightIndex( weights[i] );
+		}
+		put( indexes );
+	}
+
+	/*
+	 * putEdges(const std::vector<Edge>&) method: add edges to the snapshot (all their attributes, their weights being added to the weight table)
+	 */
+	void putEdges(const std::vector<Edge>& edges){
+		std::vector<uint32_t> values;
+		values.reserve( edges.size() * EDGE_VALUES );
+		for(const Edge& edge: edges){
+			values.push_back( uint32_t(edge.getFW()) | uint32_t(edge.getBW()) << 1 );
+			values.push_back( edge.getOrigin() );
+			values.push_back( edge.getDestination() );
+			values.push_back( edge.getSymEdge() );
+			values.push_back( weightIndex( edge.getWeightId() ) );
+			values.push_back( edge.getComplexity() );
+			values.push_back( edge.getNbOriginalEdge() );
+			values.push_back( edge.getMiddleNode() );
+		}
+		put( values );
+	}
+
+	/*
+	 * get(...) methods: read the next value, or vector of values, of the snapshot (return false if the snapshot is too short)
+	 */
+	template<typename T>
+	bool get(T& value){
+		if( !_valid || _body.size() - _position < sizeof(T) ){
+			_valid = false;
+			return false;
+		}
+		std::copy( _body.data() + _position , _body.data() + _position + sizeof(T) , reinterpret_cast<char*>(&value) );
+		_position += sizeof(T);
+		return true;
+	}
+	template<typename T>
+	bool get(std::vector<T>& values){
+		uint64_t size;
+		if( !get(size) || ( _body.size() - _position ) / sizeof(T) < size ){
+			_valid = false;
+			return false;
+		}
+		values.resize( size );
+		std::copy( _body.data() + _position , _body.data() + _position + size * sizeof(T) , reinterpret_cast<char*>(values.data()) );
+		_position += size * sizeof(T);
+		return true;
+	}
+
+	/*
+	 * getWeights(std::vector<Weight_id>&) method: read weight ids (ids of the weight dictionary of the current process)
+	 */
+	bool getWeights(std::vector<Weight_id>& weights){
+		std::vector<uint32_t> indexes;
+		if( !get(indexes) ){
+			return false;
+		}
+		weights.resize( indexes.size() );
+		for(size_t i(0) ; i < indexes.size() ; ++i){
+			weights[i] = weightId( indexes[i] );
+		}
+		return _valid;
+	}
+
+	/*
+	 * getEdges(std::vector<Edge>&) method: read edges
+	 */
+	bool getEdges(std::vector<Edge>& edges){
+		std::vector<uint32_t> values;
+		if( !get(values) || values.size() % EDGE_VALUES != 0 ){
+			_valid = false;
+			return false;
+		}
+		edges.assign( values.size() / EDGE_VALUES , Edge() );
+		for(size_t e(0) ; e < edges.size() ; ++e){
+			const uint32_t* value( values.data() + e * EDGE_VALUES );
+			edges[e].setFW( value[0] & 1 );
+			edges[e].setBW( value[0] & 2 );
+			edges[e].setOrigin( Node_id(value[1]) );
+			edges[e].setDestination( Node_id(value[2]) );
+			edges[e].setSymEdge( Edge_id(value[3]) );
+			edges[e].setWeightId( weightId( value[4] ) );
+			edges[e].setComplexity( value[5] );
+			edges[e].setNbOriginalEdge( value[6] );
+			edges[e].setMiddleNode( Node_id(value[7]) );
+		}
+		return _valid;
+	}
+
+	/*
+	 * write(const std::string&) method: write the snapshot into the given file, through a temporary file renamed at the end (a crash while
+	 * writing leaves the previous checkpoint intact)
+	 * the weight table is made here, so that this method can run in a background thread (reading the weight dictionary needs no lock)
+	 */
+	bool write(const std::string& filename) const {
+		const std::string tmpfilename( filename + ".tmp" );
+		std::ofstream output(tmpfilename, std::ios::binary | std::ios::trunc);
+		if( !output.is_open() ){
+			ERROR("Unable to open file '" << tmpfilename << "'\n");
+			return false;
+		}
+		Header header;
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.nbNodes = _nbNodes;
+		header.nbWeights = _weightIds.size();
+		header.bodySize = _body.size();
+		output.write( reinterpret_cast<const char*>(&header) , sizeof(Header) );
+		std::vector<double> values;
+		for(const Weight_id& id: _weightIds){
+			WeightView dist( getWeightDictionary().getDistribution(id) );
+			const uint32_t window[4] = { dist.getSize() , dist.getDelta() , dist.getWindowBegin() , dist.getWindowEnd() - dist.getWindowBegin() };
+			values.clear();
+			for(uint32_t t(window[2]) ; t < dist.getWindowEnd() ; ++t){
+				values.push_back( dist.getPdfT(t) );
+			}
+			for(uint32_t t(window[2]) ; t < dist.getWindowEnd() ; ++t){
+				values.push_back( dist.getCdfT(t) );
+			}
+			output.write( reinterpret_cast<const char*>(window) , sizeof(window) );
+			output.write( reinterpret_cast<const char*>(values.data()) , values.size() * sizeof(double) );
+		}
+		output.write( _body.data() , _body.size() );
+		output.close();
+		if( !output || std::rename( tmpfilename.c_str() , filename.c_str() ) != 0 ){
+			ERROR("Unable to write checkpoint '" << filename << "'\n");
+			return false;
+		}
+		return true;
+	}
+
+	static constexpr uint64_t MAGIC = 0x0054504b43484353; // "SCHCKPT" (little-endian)
+	static constexpr uint32_t VERSION = 3; // Format version, to be increased when the layout changes
+	static constexpr uint32_t EDGE_VALUES = 8; // Number of values written per edge
+
+private:
+	/*
+	 * weightIndex(const Weight_id&) method: return the index of the given weight in the weight table, after adding it if needed
+	 */
+	uint32_t weightIndex(const Weight_id& id){
+		if( id == INVALID_WEIGHT_ID ){
+			return INVALID_WEIGHT_ID;
+		}
+		auto inserted = _weightIndexes.insert( std::make_pair( uint32_t(id) , uint32_t(_weightIds.size()) ) );
+		if( inserted.second ){
+			_weightIds.push_back(id);
+		}
+		return inserted.first->second;
+	}
+
+	/*
+	 * weightId(const uint32_t&) method: return the weight id of the given index of the weight table (the snapshot is not valid if there is none)
+	 */
+	Weight_id weightId(const uint32_t& index){
+		if( index == INVALID_WEIGHT_ID ){
+			return INVALID_WEIGHT_ID;
+		}
+		if( index >= _weightIds.size() ){
+			_valid = false;
+			return INVALID_WEIGHT_ID;
+		}
+		return _weightIds[index];
+	}
+
+	/*
+	 * Attributes
+	 */
+	uint32_t _nbNodes; // Number of nodes of the snapshotted graph
+	std::vector<char> _body; // Put values
+	size_t _position; // Reading position in the body
+	bool _valid; // False if the snapshot could not be read
+	std::unordered_map<uint32_t,uint32_t> _weightIndexes; // Index of each weight of the table, by weight id (writing)
+	std::vector<Weight_id> _weightIds; // Weight id of each weight of the table
+};
+
+#endif /* DATA_IO_CHECKPOINT_IO_H_ */
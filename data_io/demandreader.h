@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "../misc.h"
+#include "textparser.h"
 
 class Demands{
 
@@ -77,29 +78,36 @@ public:
 			ERROR("Empty input file name given.\n");
 		}
 //		STATUS("Reading demands file '" << input_file_name << "'...");
-		std::ifstream input_demands_file(input_file_name);
-		if ( ! input_demands_file.is_open() ){
+		TextParser parser(input_file_name);
+		if ( ! parser.isOpen() ){
 //			CONTINUE_STATUS(" ABORT\n");
 			ERROR("Unable to open file.\n");
+			return;
 		}
-		std::string firstline;
-		getline(input_demands_file,firstline);
-		if ( firstline != "demands" ){
+		if ( parser.getLine(0) != "demands" ){
 //			CONTINUE_STATUS(" ABORT\n");
 			ERROR("Not a valid DEMANDS file (header format issue).\n");
 		}
+		const std::string secondline( parser.getLine(1) );
 		uint32_t n_demands;
-		input_demands_file >> n_demands;
-		uint32_t start,destination,timebudget;
-		double alpha;
-		for ( size_t i = 0 ; i != n_demands ; ++i ){
-			input_demands_file >> start;
-			input_demands_file >> destination;
-			input_demands_file >> alpha;
-			input_demands_file >> timebudget;
-			_demands.push_back( Demand(start,destination,alpha,timebudget) );
+		if ( ! TextParser::LineCursor( secondline.data() , secondline.data() + secondline.size() ).read(n_demands) ){
+			ERROR("Not a valid DEMANDS file (number of demands missing).\n");
+			return;
+		}
+		// One demand per line, lines being parsed in parallel (see TextParser)
+		parser.parse( _demands , [](TextParser::LineCursor& line, std::vector<Demand>& demands, std::string& error){
+			uint32_t start,destination,timebudget;
+			double alpha;
+			if ( !line.read(start) || !line.read(destination) || !line.read(alpha) || !line.read(timebudget) ){
+				error = "Not a valid demand (start destination alpha timebudget).";
+				return false;
+			}
+			demands.push_back( Demand(start,destination,alpha,timebudget) );
+			return true;
+		} , 2 , n_demands );
+		if ( _demands.size() != n_demands ){
+			ERROR("Not a valid DEMANDS file (" << _demands.size() << " demands read instead of " << n_demands << ").\n");
 		}
-		input_demands_file.close();
 //		CONTINUE_STATUS(" OK\n");
 	}
 	Demands(const int& nbdemands, const uint32_t& nbn, const uint32_t& tmax): _nbNodes(nbn), _tmax(tmax){
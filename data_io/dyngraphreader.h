@@ -11,6 +11,7 @@
 #include <fstream>
 #include <iostream>     // std::cout, std::fixed
 #include <iomanip>      // std::setprecision
+#include <numeric> // Command partial_sum
 #include <sstream>
 #include <cstdlib> // Commands atoi, atof, srand
 #include <string>
@@ -20,6 +21,7 @@
 #include "../misc.h"
 #include "../data/graph/dynedge.h"
 #include "specifreader.h"
+#include "textparser.h"
 
 class DynGraphReader{
 public:
@@ -32,68 +34,65 @@ public:
 		if (filename == ""){
 			ERROR("Empty input file name given.\n");
 		}
-		std::ifstream input_edges(filename);
-		if ( ! input_edges.is_open() ){
+		TextParser parser(filename);
+		if ( ! parser.isOpen() ){
 			ERROR("Unable to open file '" << filename << "'\n");
+			return;
+		}
+		std::vector<uint32_t> t( nbPts + 1 );
+		for ( uint32_t i = 0; i <= nbPts ; ++i ){
+			t[i] = i * spec->getDelta();
+		}
+		// Lines are parsed in parallel (see TextParser), then grouped by edge in the file order
+		std::vector<DatedWeight> dated;
+		if ( ! parser.parse( dated , [&t, nbPts](TextParser::LineCursor& line, std::vector<DatedWeight>& weights, std::string& error){
+			DatedWeight read;
+			if ( !line.read(read.src) || !line.read(read.tgt) || !line.read(read.date) ){
+				error = "Edge file corrupted: missing node id or date.";
+				return false;
+			}
+			std::vector<double> pmf( nbPts + 1 ), cdf( nbPts + 1 );
+			for ( uint32_t i = 0; i <= nbPts ; ++i ){
+				if ( !line.read(pmf[i]) ){
+					error = "Edge file corrupted: missing probability.";
+					return false;
+				}
+				if ( lt(pmf[i],0.0) || gt(pmf[i],1.0) ){
+					error = "Edge file corrupted: y-value not in [0;1].";
+					return false;
+				}
+			}
+			std::partial_sum(pmf.begin(),pmf.end(),cdf.begin());
+			if ( neq( cdf.back() , 1.0 )  ){
+				std::stringstream message;
+				message << "Edge file corrupted: the total of probabilities is not equal to 1. (Fmax=" << cdf.back() << ")";
+				error = message.str();
+				return false;
+			}
+			read.dist = Distribution(t,pmf,cdf);
+			weights.push_back( std::move(read) );
+			return true;
+		} ) ){
+			return;
 		}
-		input_edges >> std::fixed >> std::setprecision(9);
-		uint32_t edge_counter(0);
-		std::string line;
 		std::vector<Distribution> weight;
 		Node_id weightsrc(INVALID_NODE_ID), weighttgt(INVALID_NODE_ID);
 		uint32_t datecheck(-1);
-		while ( getline(input_edges,line) ){
-			std::stringstream lineReader(line);
-			++edge_counter;
-			Node_id src, tgt;
-			uint32_t date;
-			lineReader >> src;
-			lineReader >> tgt;
-			lineReader >> date;
-			assert( date == datecheck+1);
+		for ( DatedWeight& read: dated ){
+			assert( read.date == datecheck+1);
 			++datecheck;
 			Node_id midnod_id(INVALID_NODE_ID);
-			if( src != weightsrc || tgt != weighttgt ){
+			if( read.src != weightsrc || read.tgt != weighttgt ){
 				assert( weight.size() == spec->getNbPts() );
 				if(weighttgt != INVALID_NODE_ID && weightsrc != INVALID_NODE_ID){
 					_edges.push_back( std::move( DynEdge( true , weightsrc , weighttgt , weight , midnod_id ) ) );
 				}
-				weightsrc = src;
-				weighttgt = tgt;
+				weightsrc = read.src;
+				weighttgt = read.tgt;
 				weight.clear();
 			}
-			std::vector<uint32_t> t;
-			std::vector<double> pmf,cdf;
-			for ( uint32_t i = 0; i <= nbPts ; ++i ){
-				uint32_t x(i * spec->getDelta() );
-				t.push_back( x );
-				double proba;
-				lineReader >> proba;
-				pmf.push_back( proba );
-				cdf.push_back( proba );
-				if ( x < 0 || x > nbPts * spec->getDelta() ){
-					CONTINUE_STATUS(" ABORT\n");
-					ERROR("Edge file corrupted: x-value not in [0;Tmax*deltat].\n");
-					_edges.clear();
-				}
-				if ( lt(proba,0.0) || gt(proba,1.0) ){
-					CONTINUE_STATUS(" ABORT\n");
-					ERROR("Edge file corrupted: y-value not in [0;1].\n");
-					_edges.clear();
-				}
-			}
-			std::partial_sum(pmf.begin(),pmf.end(),cdf.begin());
-			Distribution dist = Distribution(t,pmf,cdf);
-			weight.push_back(dist);
-			if ( neq( cdf.back() , 1.0 )  ){
-				TRACE("\nLast read: " << src << "-(" << midnod_id << ")->" << tgt << ": " << cdf.back() << " " /*<< cdfverif.back() << " " */<< fabs(cdf.back() - 1.0) << " ");// << fabs(cdfverif.back() - 1.0) );
-				CONTINUE_STATUS(" ABORT\n");
-				ERROR("Edge file corrupted: the total of probabilities is not equal to 1. (Fmax=" << cdf.back() << ")\n");
-				_edges.clear();
-				break;
-			}
+			weight.push_back( std::move(read.dist) );
 		}
-		input_edges.close();
 	}
 
 	/*
@@ -112,6 +111,15 @@ public:
 	}
 
 private:
+	/*
+	 * Struct DatedWeight: weight of an edge at a given date, as read on a line of the file
+	 */
+	struct DatedWeight{
+		Node_id src, tgt;
+		uint32_t date;
+		Distribution dist;
+	};
+
 	/*
 	 * Parameters
 	 */
@@ -9,6 +9,7 @@
 #define DATA_IO_EDGE_IO_H_
 
 #include "../misc.h"
+#include "textparser.h"
 
 class EdgeIO{
 public:
@@ -30,58 +31,46 @@ public:
 			ERROR("Empty shortcut file name given.\n");
 		}
 //		STATUS("Reading shortcut file '" << _edgeFile << "'...");
-		std::ifstream shortcutStream(_edgeFile);
-		if ( ! shortcutStream.is_open() ){
+		TextParser parser(_edgeFile);
+		if ( ! parser.isOpen() ){
 //			CONTINUE_STATUS(" ABORT\n");
 			ERROR("Unable to open hierarchy file.\n");
+			return;
 		}
-		uint32_t shortcutCounter(0);
-		while ( ! shortcutStream.eof() && shortcutCounter < specif.getNbEdges() ){
-			++shortcutCounter;
-			Node_id src, tgt;
-			shortcutStream >> src;
-			shortcutStream >> tgt;
-			Node_id midnod;
-			shortcutStream >> midnod;
-//			TRACE("N" << src << "->N" << tgt << "(-N" << midnod << ")-");
-//			std::vector<Node_id> midnods;
-//			for ( uint32_t i = 0; i <= specif.getNbPts() ; i++ ){
-//				Node_id midnod_id;
-//				shortcutStream >> midnod_id;
-//				midnods.push_back( midnod_id );
-//			}
-			std::vector<uint32_t> t;
-			std::vector<double> pmf,cdf;
-			for ( uint32_t i = 0; i <= specif.getNbPts() ; i++ ){
-				uint32_t x(i * specif.getDelta() );
-				t.push_back( x );
-				double proba;
-				shortcutStream >> proba;
-				pmf.push_back( proba );
-				cdf.push_back( proba );
-				if ( x < 0 || x > specif.getNbPts() * specif.getDelta() ){
-					CONTINUE_STATUS(" ABORT\n");
-					ERROR("Edge file corrupted: x-value not in [0;Tmax*deltat].\n");
-					_edges.clear();
+		const uint32_t nbPts( specif.getNbPts() );
+		std::vector<uint32_t> t( nbPts + 1 );
+		for ( uint32_t i = 0; i <= nbPts ; i++ ){
+			t[i] = i * specif.getDelta();
+		}
+		// At most one shortcut per edge of the specification, one per line, lines being parsed in parallel (see TextParser)
+		parser.parse( _edges , [&t, nbPts](TextParser::LineCursor& line, std::vector<Edge>& edges, std::string& error){
+			Node_id src, tgt, midnod;
+			if ( !line.read(src) || !line.read(tgt) || !line.read(midnod) ){
+				error = "Edge file corrupted: missing node id.";
+				return false;
+			}
+			std::vector<double> pmf( nbPts + 1 ), cdf( nbPts + 1 );
+			for ( uint32_t i = 0; i <= nbPts ; i++ ){
+				if ( !line.read(pmf[i]) ){
+					error = "Edge file corrupted: missing probability.";
+					return false;
 				}
-				if ( proba < 0 || proba > 1){
-					CONTINUE_STATUS(" ABORT\n");
-					ERROR("Edge file corrupted: y-value not in [0;1].\n");
-					_edges.clear();
+				if ( pmf[i] < 0 || pmf[i] > 1){
+					error = "Edge file corrupted: y-value not in [0;1].";
+					return false;
 				}
 			}
 			std::partial_sum(pmf.begin(),pmf.end(),cdf.begin());
 			if ( neq(cdf.back(),1)  ){ // abs(std::accumulate(pmf.begin(),pmf.end(),0)-1) < EPSILON
-//				CONTINUE_STATUS(" ABORT\n");
-				ERROR("Edge file corrupted: the total of probabilities is not equal to 1. (Fmax=" << cdf.back() << ")\n");
-				_edges.clear();
-				break;
+				std::stringstream message;
+				message << "Edge file corrupted: the total of probabilities is not equal to 1. (Fmax=" << cdf.back() << ")";
+				error = message.str();
+				return false;
 			}
 			Distribution dist = Distribution(t,pmf,cdf);
-			_edges.push_back( std::move( Edge( true , src , tgt , dist, midnod ) ) );
-//			TRACE("Last read edge: " << _edges.back());
-		}
-		shortcutStream.close();
+			edges.push_back( Edge( true , src , tgt , dist, midnod ) );
+			return true;
+		} , 0 , specif.getNbEdges() );
 //		CONTINUE_STATUS(" OK\n");
 	}
 
@@ -99,7 +88,7 @@ public:
 			shortcutOut << its->getOrigin() << " " << its->getDestination() << " ";
 			Node_id midnod = its->getMiddleNode();
 			shortcutOut << midnod << " ";
-			Distribution shortcutDist( its->getWeight() );
+			WeightView shortcutDist( its->getWeight() ); // Read in place in the weight dictionary
 			for( uint32_t sup = 0 ; sup < shortcutDist.getSize() ; ++sup ){
 				shortcutOut << shortcutDist.getPdfI(sup) << " ";
 			}
@@ -11,6 +11,7 @@
 #include <fstream>
 #include <iostream>     // std::cout, std::fixed
 #include <iomanip>      // std::setprecision
+#include <numeric> // Command partial_sum
 #include <sstream>
 #include <cstdlib> // Commands atoi, atof, srand
 #include <string>
@@ -19,7 +20,9 @@
 
 #include "../misc.h"
 #include "../data/graph/edge.h"
+#include "binarygraph_io.h"
 #include "specifreader.h"
+#include "textparser.h"
 
 class GraphReader{
 public:
@@ -32,73 +35,64 @@ public:
 		if (filename == ""){
 			ERROR("Empty input file name given.\n");
 		}
+		const std::string binaryname( BinaryGraphIO::binaryFileName(filename) );
+		if( BinaryGraphIO::isBinary(filename) || BinaryGraphIO::isUpToDate(binaryname, filename) ){ // Binary edge files are read without parsing
+			_edges = BinaryGraphIO::read( BinaryGraphIO::isBinary(filename) ? filename : binaryname , *spec , hier );
+			return;
+		}
 //		STATUS("Reading edge file '" << filename << "'...");
-		std::ifstream input_edges(filename);
-		if ( ! input_edges.is_open() ){
+		TextParser parser(filename);
+		if ( ! parser.isOpen() ){
 //			CONTINUE_STATUS(" ABORT\n");
 			ERROR("Unable to open file '" << filename << "'\n");
+			return;
+		}
+		std::vector<uint32_t> t( nbPts + 1 );
+		for ( uint32_t i = 0; i <= nbPts ; ++i ){
+			t[i] = i * spec->getDelta();
 		}
-		input_edges >> std::fixed >> std::setprecision(9);
-		uint32_t edge_counter(0);
-		std::string line;
-		while ( getline(input_edges,line) ){
-			std::stringstream lineReader(line);
-			++edge_counter;
+		// Lines are parsed in parallel (see TextParser), each one into an edge
+		parser.parse( _edges , [&t, nbPts, hier](TextParser::LineCursor& line, std::vector<Edge>& edges, std::string& error){
 			Node_id src, tgt;
-			lineReader >> src;
-			lineReader >> tgt;
-			//			std::vector<Node_id> midnod(INVALID_NODE_ID);
 			Node_id midnod_id(INVALID_NODE_ID);
-			if(hier){
-				//				for ( uint32_t i(0); i <= nbPts ; ++i ){
-				lineReader >> midnod_id;
-				//					midnod = midnod_id;
-				//				}
+			if ( !line.read(src) || !line.read(tgt) || ( hier && !line.read(midnod_id) ) ){
+				error = "Edge file corrupted: missing node id.";
+				return false;
 			}
-//			TRACE("Edge E" << edge_counter << ": N" << src << "-(n" << midnod_id << ")->N" << tgt );
-			std::vector<uint32_t> t;
-			std::vector<double> pmf,cdf;
+			std::vector<double> pmf( nbPts + 1 ), cdf( nbPts + 1 );
 			for ( uint32_t i = 0; i <= nbPts ; ++i ){
-				uint32_t x(i * spec->getDelta() );
-				t.push_back( x );
-				double proba;
-				lineReader >> proba;
-				pmf.push_back( proba );
-				cdf.push_back( proba );
-				if ( x < 0 || x > nbPts * spec->getDelta() ){
-					CONTINUE_STATUS(" ABORT\n");
-					ERROR("Edge file corrupted: x-value not in [0;Tmax*deltat].\n");
-					_edges.clear();
+				if ( !line.read(pmf[i]) ){
+					error = "Edge file corrupted: missing probability.";
+					return false;
 				}
-				if ( lt(proba,0.0) || gt(proba,1.0) ){
-					CONTINUE_STATUS(" ABORT\n");
-					ERROR("Edge file corrupted: y-value not in [0;1].\n");
-					_edges.clear();
+				if ( lt(pmf[i],0.0) || gt(pmf[i],1.0) ){
+					error = "Edge file corrupted: y-value not in [0;1].";
+					return false;
 				}
 			}
 			std::partial_sum(pmf.begin(),pmf.end(),cdf.begin());
-			Distribution dist = Distribution(t,pmf,cdf);
-//			assert( eq(cdf.back() , cdfverif.back()) );
-//			assert( eq(cdfverif.back() , 1.0) );
-//			assert( eq(cdf.back() , 1.0) );
 			if ( neq( cdf.back() , 1.0 )  ){
-				TRACE("\nLast read: " << src << "-(" << midnod_id << ")->" << tgt << ": " << cdf.back() << " " /*<< cdfverif.back() << " " */<< fabs(cdf.back() - 1.0) << " ");// << fabs(cdfverif.back() - 1.0) );
-				CONTINUE_STATUS(" ABORT\n");
-				ERROR("Edge file corrupted: the total of probabilities is not equal to 1. (Fmax=" << cdf.back() << ")\n");
-				_edges.clear();
-				break;
+				std::stringstream message;
+				message << "Edge file corrupted: the total of probabilities is not equal to 1. (Fmax=" << cdf.back() << ")";
+				error = message.str();
+				return false;
 			}
-			_edges.push_back( std::move( Edge( true , src , tgt , dist , midnod_id ) ) );
-//			TRACE("Last read edge: " << _edges.back());
-		}
-		input_edges.close();
+			Distribution dist = Distribution(t,pmf,cdf);
+			edges.push_back( Edge( true , src , tgt , dist , midnod_id ) );
+			return true;
+		} );
 //		CONTINUE_STATUS(" OK\n");
 	}
 
 	/*
 	 * Getter
 	 */
-	std::vector<Edge> getEdges(){ return _edges; }
+	const std::vector<Edge>& getEdges() const { return _edges; }
+
+	/*
+	 * releaseEdges() method: return the read edges by moving them out of the reader (that is left empty), for the graph construction
+	 */
+	std::vector<Edge> releaseEdges(){ return std::move(_edges); }
 
 	/*
 	 * print() method: print all the saved edges on the console
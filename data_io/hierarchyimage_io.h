@@ -0,0 +1,174 @@
+/*
+ * hierarchyimage_io.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_IO_HIERARCHYIMAGE_IO_H_
+#define DATA_IO_HIERARCHYIMAGE_IO_H_
+
+#include <cstdint>
+#include <cstring> // Command memcpy
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h> // Command open
+#include <sys/mman.h> // Commands mmap, munmap
+#include <sys/stat.h> // Command fstat
+#include <unistd.h> // Command close
+
+#include "../misc.h"
+
+/*
+ * class HierarchyImageIO: binary hierarchy image, a single file holding everything the queries need (see UpwardGraph::write()),
+ * instead of the hierarchy (.lvl) and contracted graph (.ctg) text files
+ * Layout (native endianness, sections aligned on 8 bytes): a header with the format version, the instance specification and the position
+ * and size of each section, then the sections (see Section). Weights are stored once per distinct distribution (pdf of the stored window
+ * only), edges refer to them by their index in the weight sections.
+ * A HierarchyImageIO object maps the whole file in memory, read-only, for the time of the loading: UpwardGraph copies the sections into its own
+ * arrays (and interns the weights), so that the image can be unmapped once the upward graph is built.
+ */
+class HierarchyImageIO{
+public:
+	/*
+	 * Enum Section: sections of a hierarchy image (node ids are the internal ones, ie levels, unless stated otherwise)
+	 */
+	enum Section{
+		ORIGINAL_IDS, // Original id of each node (uint32_t)
+		LEVELS, // Level of each node (uint32_t)
+		SORTED_NODES, // Node of each level (uint32_t)
+		FW_FIRST, // First upward forward edge of each level, plus the number of forward edges (uint32_t)
+		FW_DESTINATIONS, // Destination of each upward forward edge (uint32_t)
+		FW_MIDDLE_NODES, // Middle node of each upward forward edge (uint32_t)
+		FW_WEIGHTS, // Weight index of each upward forward edge (uint32_t)
+		BW_FIRST, // First upward backward edge of each level, plus the number of backward edges (uint32_t)
+		BW_ORIGINS, // Origin of each upward backward edge (uint32_t)
+		BW_MIDDLE_NODES, // Middle node of each upward backward edge (uint32_t)
+		BW_WEIGHTS, // Weight index of each upward backward edge (uint32_t)
+		WEIGHT_SIZES, // Support size of each weight (uint32_t)
+		WEIGHT_DELTAS, // Delta of each weight (uint32_t)
+		WEIGHT_STARTS, // First stored support point of each weight (uint32_t)
+		WEIGHT_OFFSETS, // Position of the values of each weight in WEIGHT_VALUES, plus the number of values (uint64_t)
+		WEIGHT_VALUES, // Pdf of the stored window of each weight (double), the cdf being their partial sums
+		NB_SECTIONS
+	};
+
+	/*
+	 * Struct Header: first bytes of a hierarchy image
+	 */
+	struct Header{
+		uint64_t magic; // MAGIC
+		uint32_t version; // VERSION
+		uint32_t nbNodes; // Number of nodes
+		uint32_t nbEdges; // Number of edges of the instance (specification)
+		uint32_t nbPts; // Number of points of the instance (specification)
+		uint32_t delta; // Delta of the instance (specification)
+		uint32_t nbWeights; // Number of distinct weights
+		uint64_t offsets[NB_SECTIONS]; // Position of each section in the file, in bytes
+		uint64_t sizes[NB_SECTIONS]; // Size of each section, in bytes
+	};
+
+	/*
+	 * Constructors: map the given hierarchy image (the object is not valid if the file cannot be mapped or is not a hierarchy image)
+	 */
+	HierarchyImageIO(const std::string& filename): _data(NULL), _size(0){
+		const int file( open( filename.c_str() , O_RDONLY ) );
+		struct stat status;
+		if( file < 0 || fstat( file , &status ) != 0 ){
+			ERROR("Unable to open hierarchy image '" << filename << "'\n");
+			if( file >= 0 ){
+				close(file);
+			}
+			return;
+		}
+		_size = status.st_size;
+		void* data( _size >= sizeof(Header) ? mmap( NULL , _size , PROT_READ , MAP_SHARED , file , 0 ) : MAP_FAILED );
+		close(file);
+		if( data == MAP_FAILED ){
+			ERROR("Unable to map hierarchy image '" << filename << "'\n");
+			return;
+		}
+		_data = static_cast<const char*>(data);
+		memcpy( &_header , _data , sizeof(Header) );
+		bool valid( _header.magic == MAGIC && _header.version == VERSION );
+		for(uint32_t s(0) ; valid && s < NB_SECTIONS ; ++s){
+			valid = _header.offsets[s] % sizeof(uint64_t) == 0 && _header.offsets[s] <= _size && _header.sizes[s] <= _size - _header.offsets[s];
+		}
+		if( !valid ){
+			ERROR("Hierarchy image '" << filename << "' corrupted or of another format version.\n");
+			munmap( const_cast<char*>(_data) , _size );
+			_data = NULL;
+		}
+	}
+	HierarchyImageIO(const HierarchyImageIO&) = delete;
+	HierarchyImageIO& operator=(const HierarchyImageIO&) = delete;
+	~HierarchyImageIO(){
+		if( _data != NULL ){
+			munmap( const_cast<char*>(_data) , _size );
+		}
+	}
+
+	/*
+	 * Getters
+	 */
+	bool isValid() const { return _data != NULL; }
+	const Header& getHeader() const { return _header; }
+
+	/*
+	 * getCount<T>(const Section&) method: return the number of values of the given section
+	 */
+	template<typename T>
+	size_t getCount(const Section& section) const { return _header.sizes[section] / sizeof(T); }
+
+	/*
+	 * getSection<T>(const Section&) method: return the values of the given section (mapped memory, valid as long as the object)
+	 */
+	template<typename T>
+	const T* getSection(const Section& section) const { return reinterpret_cast<const T*>( _data + _header.offsets[section] ); }
+
+	/*
+	 * write(const std::string&, Header, const std::vector<std::pair<const void*,size_t>>&) method: write a hierarchy image with the given header
+	 * (version and section table are set here) and the given sections (data and size in bytes, in the order of Section)
+	 */
+	static void write(const std::string& filename, Header header, const std::vector< std::pair<const void*,size_t> >& sections){
+		header.magic = MAGIC;
+		header.version = VERSION;
+		uint64_t offset( ( sizeof(Header) + sizeof(uint64_t) - 1 ) / sizeof(uint64_t) * sizeof(uint64_t) );
+		for(uint32_t s(0) ; s < NB_SECTIONS ; ++s){
+			header.offsets[s] = offset;
+			header.sizes[s] = sections[s].second;
+			offset += ( sections[s].second + sizeof(uint64_t) - 1 ) / sizeof(uint64_t) * sizeof(uint64_t);
+		}
+		std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+		if( !output.is_open() ){
+			ERROR("Unable to open file '" << filename << "'\n");
+			return;
+		}
+		const char padding[sizeof(uint64_t)] = {};
+		output.write( reinterpret_cast<const char*>(&header) , sizeof(Header) );
+		output.write( padding , header.offsets[0] - sizeof(Header) );
+		for(uint32_t s(0) ; s < NB_SECTIONS ; ++s){
+			output.write( static_cast<const char*>(sections[s].first) , sections[s].second );
+			output.write( padding , ( sizeof(uint64_t) - sections[s].second % sizeof(uint64_t) ) % sizeof(uint64_t) );
+		}
+		output.close();
+		if( !output ){
+			ERROR("Unable to write file '" << filename << "'\n");
+		}
+	}
+
+	static constexpr uint64_t MAGIC = 0x0052454948484353; // "SCHHIER" (little-endian)
+	static constexpr uint32_t VERSION = 1; // Format version, to be increased when the layout changes
+
+private:
+	/*
+	 * Attributes
+	 */
+	const char* _data; // Mapped file (NULL if the object is not valid)
+	size_t _size; // Size of the mapped file, in bytes
+	Header _header; // Copy of the file header
+};
+
+#endif /* DATA_IO_HIERARCHYIMAGE_IO_H_ */
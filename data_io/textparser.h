@@ -0,0 +1,225 @@
+/*
+ * textparser.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef DATA_IO_TEXTPARSER_H_
+#define DATA_IO_TEXTPARSER_H_
+
+#include <algorithm> // Command min
+#include <cerrno> // Variable errno
+#include <cmath> // Command isinf
+#include <cstdint>
+#include <cstdlib> // Commands strtoul, strtod
+#include <cstring> // Command memchr
+#include <fstream>
+#include <iterator> // Command back_inserter
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include <omp.h> // Parallel computing commands
+
+#include "../misc.h"
+
+/*
+ * class TextParser: chunked, parallel parsing of the line-based text files (edge, shortcut and demand files)
+ * The file is read at once and split into one chunk per thread at line boundaries; each thread parses the lines of its chunk into its own
+ * record buffer, and the buffers are then merged in the file order. Numbers are read without streams (see LineCursor), with the same
+ * values as operator>>. Invalid lines are reported with their line number (the first one in the file order).
+ */
+class TextParser{
+public:
+	/*
+	 * class LineCursor: sequential reading of the numbers of a line (blanks are spaces, tabs and carriage returns)
+	 * integers are read with strtoul and reals with strtod, the functions used by operator>> in the "C" locale
+	 */
+	class LineCursor{
+	public:
+		LineCursor(const char* begin, const char* end): _pos(begin), _end(end){}
+
+		/*
+		 * read(...) methods: read the next number of the line into the given value, return false if there is none (the value is then unchanged)
+		 */
+		bool read(uint32_t& value){
+			if( !skipBlanks() ){
+				return false;
+			}
+			char* next;
+			errno = 0;
+			const unsigned long result( strtoul( _pos , &next , 10 ) );
+			if( next == _pos || next > _end || errno == ERANGE || result > std::numeric_limits<uint32_t>::max() ){
+				return false;
+			}
+			_pos = next;
+			value = result;
+			return true;
+		}
+		bool read(Node_id& value){
+			uint32_t id;
+			if( !read(id) ){
+				return false;
+			}
+			value = Node_id(id);
+			return true;
+		}
+		bool read(double& value){
+			if( !skipBlanks() ){
+				return false;
+			}
+			char* next;
+			const double result( strtod( _pos , &next ) );
+			if( next == _pos || next > _end || std::isinf(result) ){
+				return false;
+			}
+			_pos = next;
+			value = result;
+			return true;
+		}
+
+		/*
+		 * atEnd() method: return true if there is nothing but blanks left on the line
+		 */
+		bool atEnd(){ return !skipBlanks(); }
+
+	private:
+		bool skipBlanks(){
+			while( _pos < _end && ( *_pos == ' ' || *_pos == '\t' || *_pos == '\r' ) ){
+				++_pos;
+			}
+			return _pos < _end;
+		}
+
+		const char* _pos; // Current position in the line
+		const char* _end; // End of the line (its newline character, or the end of the file)
+	};
+
+	/*
+	 * Constructors: read the whole given file (see isOpen())
+	 */
+	TextParser(const std::string& filename): _filename(filename), _open(false){
+		std::ifstream input(filename, std::ios::binary);
+		if( !input.is_open() ){
+			return;
+		}
+		input.seekg( 0 , std::ios::end );
+		_content.resize( input.tellg() );
+		input.seekg( 0 , std::ios::beg );
+		input.read( &_content[0] , _content.size() );
+		_open = bool(input);
+	}
+
+	/*
+	 * Getters
+	 */
+	bool isOpen() const { return _open; }
+	const std::string& getFileName() const { return _filename; }
+
+	/*
+	 * getLine(const size_t&) method: return the content of the given line (0-based, without its newline character), empty if the file is shorter
+	 */
+	std::string getLine(const size_t& index) const {
+		const size_t begin( skipLines( 0 , index ) );
+		const char* end( static_cast<const char*>( memchr( _content.data() + begin , '\n' , _content.size() - begin ) ) );
+		return _content.substr( begin , ( end == NULL ? _content.size() : end - _content.data() ) - begin );
+	}
+
+	/*
+	 * parse(std::vector<Record>&, const ParseLine&, const size_t&, const size_t&) method: parse the lines of the file, from line <firstLine> (0-based)
+	 * and at most <maxLines> of them, and add their records to the given vector, in the file order
+	 * parseLine(LineCursor& line, std::vector<Record>& records, std::string& error) adds the record(s) of a line to the buffer of its thread, and
+	 * returns false with an error message if the line is invalid; blank lines are skipped.
+	 * Return false if a line is invalid: the first invalid line is reported with its line number, and the vector is left empty.
+	 */
+	template<typename Record, typename ParseLine>
+	bool parse(std::vector<Record>& records, const ParseLine& parseLine, const size_t& firstLine = 0, const size_t& maxLines = std::numeric_limits<size_t>::max()) const {
+		const size_t begin( skipLines( 0 , firstLine ) );
+		const size_t end( maxLines == std::numeric_limits<size_t>::max() ? _content.size() : skipLines( begin , maxLines ) );
+		// Chunks: about the same number of bytes each, their bounds moved to the following line beginning
+		const uint32_t nbChunks( std::min( size_t( omp_get_max_threads() ) , 1 + ( end - begin ) / MIN_CHUNK_SIZE ) );
+		std::vector<size_t> bounds( nbChunks + 1 , end );
+		bounds[0] = begin;
+		for(uint32_t c(1) ; c < nbChunks ; ++c){
+			bounds[c] = std::max( bounds[c-1] , std::min( skipLines( begin + ( end - begin ) * c / nbChunks - 1 , 1 ) , end ) );
+		}
+		std::vector<size_t> firstLines( nbChunks + 1 , firstLine ); // Number of the first line of each chunk
+#pragma omp parallel for schedule(static,1)
+		for(uint32_t c = 0 ; c < nbChunks ; ++c){
+			firstLines[c+1] = countLines( bounds[c] , bounds[c+1] );
+		}
+		for(uint32_t c(0) ; c < nbChunks ; ++c){
+			firstLines[c+1] += firstLines[c];
+		}
+		std::vector< std::vector<Record> > buffers( nbChunks );
+		std::vector<size_t> errorLines( nbChunks , std::numeric_limits<size_t>::max() );
+		std::vector<std::string> errors( nbChunks );
+#pragma omp parallel for schedule(static,1)
+		for(uint32_t c = 0 ; c < nbChunks ; ++c){
+			size_t lineNumber( firstLines[c] );
+			for(const char* line( _content.data() + bounds[c] ) ; line < _content.data() + bounds[c+1] ; ++lineNumber){
+				const char* lineEnd( static_cast<const char*>( memchr( line , '\n' , _content.data() + bounds[c+1] - line ) ) );
+				if( lineEnd == NULL ){
+					lineEnd = _content.data() + bounds[c+1];
+				}
+				LineCursor cursor( line , lineEnd );
+				if( !cursor.atEnd() && !parseLine( cursor , buffers[c] , errors[c] ) ){
+					errorLines[c] = lineNumber;
+					break;
+				}
+				line = lineEnd + 1;
+			}
+		}
+		for(uint32_t c(0) ; c < nbChunks ; ++c){
+			if( errorLines[c] != std::numeric_limits<size_t>::max() ){
+				ERROR(_filename << ":" << errorLines[c] + 1 << ": " << errors[c] << "\n");
+				records.clear();
+				return false;
+			}
+		}
+		size_t nbRecords( records.size() );
+		for(const auto& buffer: buffers){
+			nbRecords += buffer.size();
+		}
+		records.reserve( nbRecords );
+		for(auto& buffer: buffers){
+			std::move( buffer.begin() , buffer.end() , std::back_inserter(records) );
+		}
+		return true;
+	}
+
+	static constexpr size_t MIN_CHUNK_SIZE = 1 << 16; // Minimal size of a chunk, in bytes (smaller files are parsed by fewer threads)
+
+private:
+	/*
+	 * skipLines(const size_t&, const size_t&) method: return the position following the <nbLines> lines that begin at the given position (the end of the file if it is shorter)
+	 */
+	size_t skipLines(size_t position, const size_t& nbLines) const {
+		for(size_t l(0) ; l < nbLines && position < _content.size() ; ++l){
+			const char* next( static_cast<const char*>( memchr( _content.data() + position , '\n' , _content.size() - position ) ) );
+			position = ( next == NULL ? _content.size() : next - _content.data() + 1 );
+		}
+		return position;
+	}
+
+	/*
+	 * countLines(const size_t&, const size_t&) method: return the number of lines that begin between the given positions
+	 */
+	size_t countLines(const size_t& begin, const size_t& end) const {
+		size_t nbLines(0);
+		for(size_t position(begin) ; position < end ; ++nbLines){
+			position = skipLines( position , 1 );
+		}
+		return nbLines;
+	}
+
+	/*
+	 * Attributes
+	 */
+	std::string _filename; // Name of the parsed file
+	std::string _content; // Content of the file
+	bool _open; // True if the file has been read
+};
+
+#endif /* DATA_IO_TEXTPARSER_H_ */
@@ -8,18 +8,28 @@
 #include <unistd.h>
 
 #include "misc.h"
+#include "run/binaryconverter.h"
 #include "run/schprocedure.h"
 #include "run/codetester.h"
+#include "run/convolutionbenchmark.h"
 #include "run/fullanalysis.h"
 #include "run/querygen.h"
 
 int main(int argc, char** argv){
 	int result(0);
-	int opt = getopt(argc, argv, "dfpt");
+	int opt = getopt(argc, argv, "bcdfpt");
 
 	Run* run = NULL;
 
 	switch(opt){
+	case 'b':
+		MARK("### Convolution benchmark ###");
+		run = new ConvolutionBenchmark();
+		break;
+	case 'c':
+		MARK("### Binary edge file conversion ###");
+		run = new BinaryConverter();
+		break;
 	case 'd':
 		MARK("### Demand generation ###");
 		run = new QueryGenerator();
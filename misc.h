@@ -61,12 +61,14 @@ void remove_duplicates(std::vector<T>& vec, const LtFn& lt = std::less<T>(), con
 }
 
 /*
- * Definition of two specific types: Node_id and Edge_id, defined as double
+ * Definition of three specific types: Node_id, Edge_id and Weight_id (index of an edge weight in the weight dictionary), defined as double
  */
 BOOST_STRONG_TYPEDEF(uint32_t, Node_id);
 const Node_id INVALID_NODE_ID(std::numeric_limits<uint32_t>::max());
 BOOST_STRONG_TYPEDEF(uint32_t, Edge_id);
 const Edge_id INVALID_EDGE_ID( std::numeric_limits<uint32_t>::max() );
+BOOST_STRONG_TYPEDEF(uint32_t, Weight_id);
+const Weight_id INVALID_WEIGHT_ID( std::numeric_limits<uint32_t>::max() );
 
 /*
  * Class Filler: functor useful to fill a container with incremental indices
@@ -0,0 +1,69 @@
+/*
+ * binaryconverter.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef RUN_BINARYCONVERTER_H_
+#define RUN_BINARYCONVERTER_H_
+
+#include "run.h"
+#include "../data_io/binarygraph_io.h"
+
+#include <cstdlib> // Command atoi
+
+/*
+ * Class BinaryConverter: convert a text edge file (instance file of instgraph/, or contracted graph file of insthier/ if hierarchized)
+ * into its binary version (see BinaryGraphIO), that GraphReader then reads instead of the text file
+ */
+class BinaryConverter: public Run{
+public:
+	int main(int argc, char *argv[]){
+
+		/*
+		 * Initialization: if parameters are badly entered, terminate execution
+		 */
+		const char* binary_name = argv[0];
+		if ( argc != 4 && argc != 5 ){
+			std::cerr << std::endl << "USAGE: " << binary_name
+					<< " -c <specif file> <edge file> [<hierarchized (0/1)>]"
+					<< std::endl << std::endl ;
+			return EXIT_FAILURE;
+		}
+		const std::string speciffilename(argv[2]);
+		const std::string edgefilename(argv[3]);
+		const bool hierarchized( argc == 5 && atoi(argv[4]) != 0 );
+		const std::string binaryfilename( BinaryGraphIO::binaryFileName(edgefilename) );
+		if( BinaryGraphIO::isUpToDate( binaryfilename , edgefilename ) ){
+			STATUS("Binary edge file '" << binaryfilename << "' is up to date.\n");
+			return(EXIT_SUCCESS);
+		}
+
+		/*
+		 * Conversion: the text file is read (and checked) by GraphReader, then written in binary format
+		 */
+		Specif specif( speciffilename );
+		auto t_readbeg = time_stamp();
+		GraphReader graphreader( edgefilename , &specif , hierarchized );
+		auto t_readend = time_stamp();
+		if ( graphreader.getEdges().empty() ){
+			ERROR("No edge read in '" << edgefilename << "'.\n");
+			return EXIT_FAILURE;
+		}
+		BinaryGraphIO::write( binaryfilename , specif , graphreader.getEdges() , hierarchized );
+		auto t_writeend = time_stamp();
+		GraphReader binaryreader( binaryfilename , &specif , hierarchized );
+		auto t_binaryend = time_stamp();
+		if( binaryreader.getEdges().size() != graphreader.getEdges().size() ){
+			ERROR("Binary edge file '" << binaryfilename << "' could not be read back.\n");
+			return EXIT_FAILURE;
+		}
+		STATUS("Write " << binaryfilename << " (" << graphreader.getEdges().size() << " edges): text reading took " << get_duration_in_seconds(t_readbeg, t_readend)
+				<< " sec, binary writing " << get_duration_in_seconds(t_readend, t_writeend) << " sec, binary reading " << get_duration_in_seconds(t_writeend, t_binaryend) << " sec\n");
+
+		return(EXIT_SUCCESS);
+	}
+};
+
+#endif /* RUN_BINARYCONVERTER_H_ */
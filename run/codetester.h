@@ -37,21 +37,21 @@ public:
 		const std::string speciffilename("instgraph/" + instance_name + "_specif.txt");
 		const std::string edgefilename("instgraph/" + instance_name + "_6.txt");
 		const std::string completeinstancename( instance_name + "_6.txt" );
-		const std::string hierarchy_name("insthier/" + completeinstancename + "_lvl.lvl");
-		const std::string contgraph_name("insthier/" + completeinstancename + "_e.ctg");
+		const std::string image_name("insthier/" + completeinstancename + "_sch.img");
 		Specif* specif = new Specif( speciffilename );
 
 		GraphReader graphreader( edgefilename , specif );
-		Graph graph(std::move( graphreader ), *specif);
+		NodePermutation bfsOrder( NodePermutation::breadthFirst( graphreader.getEdges() ) ); // Nodes are renumbered in breadth-first order for preprocessing
+		Graph graph(std::move( graphreader ), *specif, bfsOrder);
 		Node_id s( 0 );
 		Node_id d( 5 );
 
 		STATUS("Creation of spotar structure...");
 		Spotar spotar = Spotar( &graph );
 		CONTINUE_STATUS("OK\n");
-		spotar.setDestination( d );
+		spotar.setDestination( graph.getPermutation().toInternal(d) );
 		spotar.run();
-		SpotarPolicy spotarresult = spotar.getPolicy( s );
+		SpotarPolicy spotarresult = spotar.getPolicy( graph.getPermutation().toInternal(s) );
 
 		TRACE(spotarresult);
 
@@ -61,19 +61,17 @@ public:
 		Ordering myOrdering( &graph );
 		myOrdering.setConfig( 800 , 5 , 100 , 95 );
 		auto t_orderbeg = time_stamp();
-		std::vector<Edge> contGraphEdges = myOrdering.run(1);
+		myOrdering.run(1);
 		auto t_orderend = time_stamp();
 		auto preprocessingchrono = get_duration_in_seconds(t_orderbeg, t_orderend);
 		STATUS( "Preprocessing (hierarchy building+graph contraction) took " << preprocessingchrono << " sec\n");
-		myOrdering.writeOrdering( hierarchy_name , contgraph_name );
+		myOrdering.writeHierarchyImage( image_name );
 
 		/*
 		 * Query resolution
 		 */
-		GraphReader graphreader2( contgraph_name , specif , true );
-		Graph contgraph(std::move( graphreader2 ), *specif);
-		contgraph.setHierarchy( hierarchy_name );
-		SCHQuery schquery = SCHQuery( &contgraph );
+		UpwardGraph upgraph( image_name );
+		SCHQuery schquery = SCHQuery( &upgraph );
 		auto t_querybeg = time_stamp();
 		RoutingPolicy schresult = schquery.oneToOne( s , d );
 		TRACE(schresult);
@@ -0,0 +1,159 @@
+/*
+ * convolutionbenchmark.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: delhome
+ */
+
+#ifndef RUN_CONVOLUTIONBENCHMARK_H_
+#define RUN_CONVOLUTIONBENCHMARK_H_
+
+#include "run.h"
+#include "../data/graph/kernels.h"
+#include "../data/graph/fixeddistribution.h"
+#include "../data_io/specifreader.h"
+
+#include <algorithm> // Command nth_element
+#include <cstdlib> // Commands atoi, rand
+
+/*
+ * randomDistribution(const uint32_t&, const uint32_t&) method: build a distribution with <window> non-null probabilities starting at the first support point
+ */
+inline Distribution randomDistribution(const uint32_t& window, const uint32_t& size){
+	std::vector<uint32_t> t(size,0);
+	std::vector<double> pmf(size,0), cdf(size,0);
+	std::iota(t.begin(), t.end(), 0);
+	for(uint32_t i(0) ; i < window ; ++i){
+		pmf[i] = 1 + rand() % 100;
+	}
+	double total( std::accumulate(pmf.begin(), pmf.end(), 0.0) );
+	std::transform(pmf.begin(), pmf.end(), pmf.begin(), [total](const double& p) { return p / total; });
+	std::partial_sum(pmf.begin(), pmf.end(), cdf.begin());
+	return Distribution(t,pmf,cdf);
+}
+
+/*
+ * medianDuration(const Operation&, const uint32_t&, const uint32_t&) method: run <nbSamples> samples of <nbRepetitions> operations,
+ * return the median duration of one operation, in ms (a single sample is too noisy for small windows)
+ */
+template<typename Operation>
+double medianDuration(const Operation& operation, const uint32_t& nbRepetitions, const uint32_t& nbSamples){
+	std::vector<double> durations( nbSamples );
+	for(uint32_t s(0) ; s < nbSamples ; ++s){
+		auto t_beg = time_stamp();
+		for(uint32_t r(0) ; r < nbRepetitions ; ++r){
+			operation();
+		}
+		durations[s] = 1000 * get_duration_in_seconds(t_beg, time_stamp()) / nbRepetitions;
+	}
+	std::nth_element( durations.begin() , durations.begin() + nbSamples/2 , durations.end() );
+	return durations[nbSamples/2];
+}
+
+/*
+ * Struct FixedSupportBenchmark: compare Distribution and FixedDistribution<NbPts> convolutions and dominance checks on the support of an instance
+ * (operands have a window of half the support, so that results are truncated as in the ordering process)
+ */
+template<uint32_t NbPts>
+struct FixedSupportBenchmark{
+	static void run(const uint32_t& nbRepetitions){
+		const uint32_t size( FixedDistribution<NbPts>::SIZE );
+		Distribution d1( randomDistribution( size/2 , size ) ), d2( randomDistribution( size/2 , size ) );
+		FixedDistribution<NbPts> f1(d1), f2(d2);
+		Distribution dynamicResult;
+		FixedDistribution<NbPts> fixedResult;
+		uint32_t nbDynamicDominances(0), nbFixedDominances(0);
+		auto t_dynamicbeg = time_stamp();
+		for(uint32_t r(0) ; r < nbRepetitions ; ++r){
+			dynamicResult = d1.convolute( d2 );
+			nbDynamicDominances += dynamicResult.dominates( d1 );
+		}
+		auto t_dynamicend = time_stamp();
+		for(uint32_t r(0) ; r < nbRepetitions ; ++r){
+			fixedResult = f1.convolute( f2 );
+			nbFixedDominances += fixedResult.dominates( f1 );
+		}
+		auto t_fixedend = time_stamp();
+		double dynamicchrono( 1000 * get_duration_in_seconds(t_dynamicbeg, t_dynamicend) / nbRepetitions );
+		double fixedchrono( 1000 * get_duration_in_seconds(t_dynamicend, t_fixedend) / nbRepetitions );
+		double maxError(0);
+		for(uint32_t t(0) ; t < size ; ++t){
+			maxError = std::max( maxError , fabs( dynamicResult.getCdfT(t) - fixedResult.getCdfT(t) ) );
+		}
+		STATUS("Support of " << size << " points, convolution and dominance: Distribution " << dynamicchrono << " ms, FixedDistribution " << fixedchrono
+				<< " ms (speedup " << dynamicchrono / fixedchrono << ", max|dF| " << maxError << ( nbDynamicDominances == nbFixedDominances ? "" : ", DOMINANCE MISMATCH" ) << ")\n");
+	}
+};
+
+/*
+ * Class ConvolutionBenchmark: compare the direct and FFT convolution kernels for increasing window sizes,
+ * in order to locate the crossover point used as Distribution::FFT_THRESHOLD
+ * timings are medians over NB_SAMPLES samples, and the crossover is the window from which FFT is faster for all the larger windows
+ * if a specif file is given, Distribution is also compared with the FixedDistribution specialization of the instance support size
+ */
+class ConvolutionBenchmark: public Run{
+public:
+	int main(int argc, char *argv[]){
+
+		/*
+		 * Initialization: if parameters are badly entered, terminate execution
+		 */
+		const char* binary_name = argv[0];
+		if ( argc != 4 && argc != 5 ){
+			std::cerr << std::endl << "USAGE: " << binary_name
+					<< " -b <maximal window size> <repetition number> [<specif file>]"
+					<< std::endl << std::endl ;
+			return EXIT_FAILURE;
+		}
+		const uint32_t maxWindow( atoi(argv[2]) );
+		const uint32_t nbRepetitions( std::max( atoi(argv[3]) , 1 ) );
+		srand(0);
+		STATUS("Distribution kernels: " << getKernels().name << "\n");
+
+		/*
+		 * Benchmark: for each window size, both operands have a full window on a support large enough to keep the whole result
+		 */
+		STATUS("window\tdirect(ms)\tfft(ms)\tspeedup\tmax|dF|\n");
+		uint32_t crossover(0); // First window of the current run of windows where FFT is faster (0 if FFT is slower on the last window)
+		for(uint32_t window(8) ; window <= maxWindow ; window += std::max( window/2 , uint32_t(8) ) ){
+			Distribution d1( randomDistribution( window , 2*window+1 ) );
+			Distribution d2( randomDistribution( window , 2*window+1 ) );
+			Distribution directResult, fftResult;
+			double directchrono( medianDuration( [&](){ directResult = d1.convoluteDirect( d2 ); } , nbRepetitions , uint32_t(NB_SAMPLES) ) );
+			double fftchrono( medianDuration( [&](){ fftResult = d1.convoluteFFT( d2 ); } , nbRepetitions , uint32_t(NB_SAMPLES) ) );
+			double maxError(0);
+			for(uint32_t t(0) ; t < directResult.getSize() ; ++t){
+				maxError = std::max( maxError , fabs( directResult.getCdfT(t) - fftResult.getCdfT(t) ) );
+			}
+			if( fftchrono >= directchrono ){
+				crossover = 0;
+			}
+			else if( crossover == 0 ){
+				crossover = window;
+			}
+			CONTINUE_STATUS(window << "\t" << directchrono << "\t" << fftchrono << "\t" << directchrono / fftchrono << "\t" << maxError << "\n");
+		}
+		if( crossover == 0 ){
+			STATUS("No crossover point found up to a window of " << maxWindow << " points\n");
+		}
+		else{
+			STATUS("FFT convolution is faster from a window of " << crossover << " points up to " << maxWindow << " points (current threshold: " << uint32_t(Distribution::FFT_THRESHOLD) << ")\n");
+		}
+
+		/*
+		 * Fixed support sizes: the FixedDistribution specialization is chosen with respect to the instance specif
+		 */
+		if( argc == 5 ){
+			Specif specif( argv[4] );
+			if( !dispatchFixedDistribution<FixedSupportBenchmark>( specif.getNbPts() , nbRepetitions ) ){
+				STATUS("No FixedDistribution specialization for " << specif.getNbPts() << " points\n");
+			}
+		}
+
+		return(EXIT_SUCCESS);
+	}
+
+	static constexpr uint32_t NB_SAMPLES = 7; // Number of timed samples of each kernel, their median being kept
+};
+
+#endif /* RUN_CONVOLUTIONBENCHMARK_H_ */
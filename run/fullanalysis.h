@@ -72,8 +72,7 @@ public:
 			 * Recover full instance names thanks to instance IDs
 			 */
 			const std::string edgefilename("instgraph/" + completeinstancename + ".txt");
-			const std::string hierarchy_name("insthier/" + completeinstancename + "_lvl.lvl");
-			const std::string contgraph_name("insthier/" + completeinstancename + "_e.ctg");
+			const std::string image_name("insthier/" + completeinstancename + "_sch.img");
 			/*
 			 * Instance characterization
 			 */
@@ -91,7 +90,9 @@ public:
 			else{
 				//						algo_output_spotar << "=========================== " << completeinstancename << " ===========================\n";
 				//						algo_output_sch << "=========================== " << completeinstancename << " ===========================\n";
-				Graph graph(std::move( graphreader ), *specif);
+				NodePermutation bfsOrder( NodePermutation::breadthFirst( graphreader.getEdges() ) ); // Nodes are renumbered in breadth-first order for preprocessing
+				Graph graph(std::move( graphreader ), *specif, bfsOrder);
+				STATUS("Memory footprint: " << graph.memoryFootprint() << "\n");
 				std::vector<uint32_t> nbLRpaths_sch, nbLRpaths_spotar;
 				std::vector<SpotarPolicy> result_spotar;
 				std::vector<RoutingPolicy> result_sch;
@@ -108,9 +109,9 @@ public:
 					Node_id s( std::get<0>(od) );
 					Node_id d( std::get<1>(od) );
 					//							STATUS("Path query between Node N" << s << " and Node N" << d << "");
-					spotar.setDestination( d );
+					spotar.setDestination( graph.getPermutation().toInternal(d) );
 					spotar.run();
-					SpotarPolicy result = spotar.getPolicy( s );
+					SpotarPolicy result = spotar.getPolicy( graph.getPermutation().toInternal(s) );
 					//							TRACE(result);
 					//							algo_output_spotar << "Path query between Node N" << s << " and Node N" << d << "\n" << result;
 					result_spotar.push_back(result);
@@ -129,17 +130,18 @@ public:
 				Ordering myOrdering( &graph );
 				myOrdering.setConfig( configs->getFirst().getParamEq() , configs->getFirst().getParamSsd() , configs->getFirst().getParamOeq() , configs->getFirst().getParamCq() );
 				auto t_orderbeg = time_stamp();
-				std::vector<Edge> contGraphEdges = myOrdering.run( 3 ); // Run ordering with 3 threads
+				const uint64_t nbContGraphEdges( myOrdering.run( 3 ) ); // Run ordering with 3 threads
 				auto t_orderend = time_stamp();
 				auto preprocessingchrono = get_duration_in_seconds(t_orderbeg, t_orderend);
-				myOrdering.writeOrdering( hierarchy_name , contgraph_name );
+				STATUS("Memory footprint: " << myOrdering.memoryFootprint() << "\n");
+				STATUS("Memory footprint: " << graph.memoryFootprint() << "\n");
+				STATUS("Memory footprint: " << getWeightDictionary().memoryFootprint() << "\n");
+				myOrdering.writeHierarchyImage( image_name );
 				/*
 				 * Query resolution
 				 */
-				GraphReader graphreader2( contgraph_name , specif , true );
-				Graph contgraph(std::move( graphreader2 ), *specif);
-				contgraph.setHierarchy( hierarchy_name );
-				SCHQuery schquery = SCHQuery( &contgraph );
+				UpwardGraph upgraph( image_name );
+				SCHQuery schquery = SCHQuery( &upgraph );
 				auto t_querybeg = time_stamp();
 				for(auto queryID(0) ; queryID < demands->getNbQueries() ; ++queryID ){
 					std::pair<Node_id,Node_id> od = demands->getOD( queryID );
@@ -157,26 +159,28 @@ public:
 				auto t_queryend = time_stamp();
 				auto querychrono = get_duration_in_seconds(t_querybeg, t_queryend);
 				STATUS( "Computing " << demands->getNbDmds() << " queries with SCH took " << querychrono << " sec\n");
+				STATUS("Memory footprint: " << upgraph.memoryFootprint() << "\n");
+				STATUS("Memory footprint: " << schquery.memoryFootprint() << "\n");
 				double meanLRpaths_sch = round( std::accumulate(nbLRpaths_sch.begin(), nbLRpaths_sch.end(), 0.0)/nbLRpaths_sch.size() * 1000) / 1000 ;
 				/*
 				 * Write results (chrono, e.g.)
 				 */
 				STATUS("Write a new result:\t" << graph_name << " " << tdscen << " " << delta << " " << tmax << " " << problaw << " " << varscen << " " << id << " " << nbqueries << " " );
 				CONTINUE_STATUS(configs->getFirst().getParamEq() << " " << configs->getFirst().getParamSsd() << " " << configs->getFirst().getParamOeq() << " " << configs->getFirst().getParamCq() << " ");
-				CONTINUE_STATUS( preprocessingchrono << " " << round( 100 * contGraphEdges.size() / (double) specif->getNbEdges() )/100 << " " << querychrono << " " << meanLRpaths_sch << " " << maxLRpaths_sch << " ") ;
+				CONTINUE_STATUS( preprocessingchrono << " " << round( 100 * nbContGraphEdges / (double) specif->getNbEdges() )/100 << " " << querychrono << " " << meanLRpaths_sch << " " << maxLRpaths_sch << " ") ;
 				CONTINUE_STATUS( spotarchrono << " " << meanLRpaths_spotar << " " << maxLRpaths_spotar << "\n\n");
 				std::ofstream chronooutput;
 				chronooutput.open(chronofilename,std::ofstream::out | std::ofstream::app);
 				chronooutput << graph_name << " " << tdscen << " " << delta << " " << tmax << " " << problaw << " " << varscen << " "<< id << " " << nbqueries << " ";
 				chronooutput << configs->getFirst().getParamEq() << " " << configs->getFirst().getParamSsd() << " " << configs->getFirst().getParamOeq() << " " << configs->getFirst().getParamCq() << " ";
-				chronooutput << preprocessingchrono << " " << round( 100 * contGraphEdges.size() / (double) specif->getNbEdges() )/100 << " " << querychrono << " " << meanLRpaths_sch << " " << maxLRpaths_sch << " ";
+				chronooutput << preprocessingchrono << " " << round( 100 * nbContGraphEdges / (double) specif->getNbEdges() )/100 << " " << querychrono << " " << meanLRpaths_sch << " " << maxLRpaths_sch << " ";
 				chronooutput << spotarchrono << " " << meanLRpaths_spotar << " " << maxLRpaths_spotar << "\n";
 
 				std::ofstream chronooutputcopy;
 				chronooutputcopy.open(chronocopyfilename,std::ofstream::out | std::ofstream::app);
 				chronooutputcopy << graph_name << " " << tdscen << " " << delta << " " << tmax << " " << problaw << " " << varscen << " "<< id << " " << nbqueries << " ";
 				chronooutputcopy << configs->getFirst().getParamEq() << " " << configs->getFirst().getParamSsd() << " " << configs->getFirst().getParamOeq() << " " << configs->getFirst().getParamCq() << " ";
-				chronooutputcopy << preprocessingchrono << " " << round( 100 * contGraphEdges.size() / (double) specif->getNbEdges() )/100 << " " << querychrono << " " << meanLRpaths_sch << " " << maxLRpaths_sch << " ";
+				chronooutputcopy << preprocessingchrono << " " << round( 100 * nbContGraphEdges / (double) specif->getNbEdges() )/100 << " " << querychrono << " " << meanLRpaths_sch << " " << maxLRpaths_sch << " ";
 				chronooutputcopy << spotarchrono << " " << meanLRpaths_spotar << " " << maxLRpaths_spotar << "\n";
 
 //				for(uint32_t index(0) ; index < nbLRpaths_spotar.size() ; ++index){
@@ -195,6 +199,7 @@ public:
 					//							}
 //				}
 			}
+			getWeightDictionary().clear(); // No graph of the instance is left: its weights are released before the next instance
 		}
 		instfile.close();
 		//		algo_output_sch.close();
@@ -11,7 +11,9 @@
 #include "run.h"
 
 #include <algorithm>
+#include <cstdio> // Command remove
 #include <math.h>
+#include <memory>
 #include <stdlib.h>
 
 class SCHProcedure: public Run{
@@ -22,9 +24,10 @@ public:
 		 * Initialization: if parameters are badly entered, terminate execution
 		 */
 		const char* binary_name = argv[0];
-		if ( argc != 10 ){
+		if ( ( argc != 10 && argc != 11 ) || ( argc == 11 && std::string(argv[10]) != "-e" ) ){
 			std::cerr << std::endl << "USAGE: " << binary_name
-					<< " -p <instance name> <time-dependent scenario> <probability law> <delta> <Tmax> <instance_id> <config name> <nb_queries>"
+					<< " -p <instance name> <time-dependent scenario> <probability law> <delta> <Tmax> <instance_id> <config name> <nb_queries> [-e]"
+					<< std::endl << "(-e: the contracted graph edges are written into an edge file during the preprocessing, instead of being kept in memory)"
 					<< std::endl << std::endl ;
 			return EXIT_FAILURE;
 		}
@@ -40,13 +43,16 @@ public:
 		const std::string instanceID (argv[7]);
 		const std::string config_name(argv[8]);
 		const std::string nbqueries(argv[9]);
+		const bool write_edge_file( argc == 11 );
 		const std::string instance_name( graph_name + "/" +  graph_name + "_" + tdscen + "_" + problaw + "_" + delta + "_" + tmax + "_" + instanceID );
 		const std::string speciffilename("instgraph/" + instance_name + "_specif.txt");
 		const std::string edgefilename("instgraph/" + instance_name + ".txt");
 		const std::string conf_name("instconf/" + config_name + ".cnfg");
 		const std::string dmd_name("instdem/" + graph_name + "_" + nbqueries + ".dmd");
-		const std::string hierarchy_name("insthier/" + instance_name + "_lvl.lvl");
-		const std::string contgraph_name("insthier/" + instance_name + "_e.ctg");
+		const std::string image_name("insthier/" + instance_name + "_sch.img");
+		const std::string checkpoint_name("insthier/" + instance_name + "_sch.ckp");
+		const std::string contgraph_name("insthier/" + instance_name + "_sch.edg");
+		const double checkpoint_period(600); // Time between two checkpoints of the preprocessing, in seconds
 		const std::string chronofilename("instchrono/chrono.txt");
 
 		Specif* specif = new Specif( speciffilename );
@@ -65,27 +71,42 @@ public:
 		/*
 		 * Graph building
 		 */
-		Graph graph(std::move( graphreader ), *specif);
+		NodePermutation bfsOrder( NodePermutation::breadthFirst( graphreader.getEdges() ) ); // Nodes are renumbered in breadth-first order for preprocessing
+		Graph graph(std::move( graphreader ), *specif, bfsOrder);
+		STATUS("Memory footprint: " << graph.memoryFootprint() << "\n");
 
 		/*
 		 * Hierarchy constitution & graph contraction
 		 */
+		std::unique_ptr<EdgeFileWriter> edgeFileWriter( write_edge_file ? new EdgeFileWriter( contgraph_name ) : NULL );
 		Ordering myOrdering( &graph );
 		myOrdering.setConfig( configs->getFirst().getParamEq() , configs->getFirst().getParamSsd() , configs->getFirst().getParamOeq() , configs->getFirst().getParamCq() );
+		myOrdering.setEdgeSink( edgeFileWriter.get() ); // No edge file: the edges are kept by the ordering process
+		// An interrupted preprocessing is resumed from its last checkpoint (the preprocessing chrono then covers the resumed part only)
+		if ( std::ifstream( checkpoint_name ).good() && !myOrdering.resume( checkpoint_name ) ){
+			ERROR("Preprocessing not resumed: remove '" << checkpoint_name << "' to start it again.\n");
+			return EXIT_FAILURE;
+		}
+		myOrdering.setCheckpoint( checkpoint_name , 0 , checkpoint_period );
 		auto t_orderbeg = time_stamp();
-		std::vector<Edge> contGraphEdges = myOrdering.run(1);
+		const uint64_t nbContGraphEdges( myOrdering.run(1) );
 		auto t_orderend = time_stamp();
 		auto preprocessingchrono = get_duration_in_seconds(t_orderbeg, t_orderend);
+		STATUS("Memory footprint: " << myOrdering.memoryFootprint() << "\n");
+		STATUS("Memory footprint: " << graph.memoryFootprint() << "\n");
+		STATUS("Memory footprint: " << getWeightDictionary().memoryFootprint() << "\n");
 		STATUS( "Preprocessing (hierarchy building+graph contraction) took " << preprocessingchrono << " sec\n");
-		myOrdering.writeOrdering( hierarchy_name , contgraph_name );
+		myOrdering.writeHierarchyImage( image_name );
+		std::remove( checkpoint_name.c_str() );
+		if ( write_edge_file ){
+			std::remove( contgraph_name.c_str() );
+		}
 
 		/*
 		 * Query resolution
 		 */
-		GraphReader graphreader2( contgraph_name , specif , true );
-		Graph contgraph(std::move( graphreader2 ), *specif);
-		contgraph.setHierarchy( hierarchy_name );
-		SCHQuery schquery = SCHQuery( &contgraph );
+		UpwardGraph upgraph( image_name );
+		SCHQuery schquery = SCHQuery( &upgraph );
 		std::vector<uint32_t> nbLRpaths;
 		uint32_t maxLRpaths(0);
 		auto t_querybeg = time_stamp();
@@ -99,6 +120,8 @@ public:
 		auto t_queryend = time_stamp();
 		auto querychrono = get_duration_in_seconds(t_querybeg, t_queryend);
 		STATUS( "Computing " << demands->getNbDmds() << " queries took " << querychrono << " sec\n");
+		STATUS("Memory footprint: " << upgraph.memoryFootprint() << "\n");
+		STATUS("Memory footprint: " << schquery.memoryFootprint() << "\n");
 		double meanLRpaths = round( std::accumulate(nbLRpaths.begin(), nbLRpaths.end(), 0.0)/nbLRpaths.size() * 100) / 100 ;
 
 		/*
@@ -106,12 +129,12 @@ public:
 		 */
 		STATUS("Write a new result:\n" << graph_name << " " << tdscen << " " << problaw << " " << delta << " " << tmax << " " << instanceID << " " << nbqueries << " " );
 		CONTINUE_STATUS(configs->getFirst().getParamEq() << " " << configs->getFirst().getParamSsd() << " " << configs->getFirst().getParamOeq() << " " << configs->getFirst().getParamCq() << " ");
-		CONTINUE_STATUS( preprocessingchrono << " " << querychrono << " " << round( 100 * contGraphEdges.size() / (double) specif->getNbEdges() )/100 << " " << meanLRpaths << " " << maxLRpaths << "\n");
+		CONTINUE_STATUS( preprocessingchrono << " " << querychrono << " " << round( 100 * nbContGraphEdges / (double) specif->getNbEdges() )/100 << " " << meanLRpaths << " " << maxLRpaths << "\n");
 		std::ofstream chronooutput;
 		chronooutput.open(chronofilename,std::ofstream::out | std::ofstream::app);
 		chronooutput << graph_name << " " << tdscen << " " << problaw << " " << delta << " " << tmax << " " << instanceID << " " << nbqueries << " ";
 		chronooutput << configs->getFirst().getParamEq() << " " << configs->getFirst().getParamSsd() << " " << configs->getFirst().getParamOeq() << " " << configs->getFirst().getParamCq() << " ";
-		chronooutput << preprocessingchrono << " " << querychrono << " " << round( 100 * contGraphEdges.size() / (double) specif->getNbEdges() )/100 << " " << meanLRpaths << " " << maxLRpaths << "\n";
+		chronooutput << preprocessingchrono << " " << querychrono << " " << round( 100 * nbContGraphEdges / (double) specif->getNbEdges() )/100 << " " << meanLRpaths << " " << maxLRpaths << "\n";
 
 		return(EXIT_SUCCESS);
 	}